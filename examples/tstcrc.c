@@ -185,6 +185,7 @@
 		unsigned char *dest;
 
 		uint32_t crc_32_val;
+		struct crc_ctx ctx;
 
 		bool do_ascii;
 		bool do_hex;
@@ -223,22 +224,14 @@
 
 
 
-		crc_32_val = 0xffffffffL;
+		crc_ctx_init(&ctx, CRC_TYPE_32);
 
 
 
 		if (do_ascii) {
-			ptr = (unsigned char *)input_string;
-
-			int i = 0;
-			for (i = 0; i < length; i++) {
-
-				crc_32_val = update_crc_32(crc_32_val, *ptr);
-
-				ptr++;
-			}
+			crc_ctx_update(&ctx, (unsigned char *)input_string, (size_t)length);
 		}
-		crc_32_val ^= 0xffffffffL;
+		crc_32_val = (uint32_t)crc_ctx_final(&ctx);
 		//printf(input_string);
 		//printf("\n%d", sizeof(input_string));
 		//printf("\n%d\n", length);
@@ -298,6 +291,9 @@
 		char setCount[12] = {0};
 		char prevSetCount[12] = {0};
 
+		/* tables to repair frames with a bit error or a short burst locally */
+		struct crc_fix *crcFix = crc_32_fix_create(sizeof(buf) - 12 - 12, 8);
+
 		
 		//printf(" [1] ");
 		unsigned int rdlensm2 = read(fd, bufsm2, sizeof(bufsm2));
@@ -530,7 +526,8 @@
 					totalBytes += sizeof(buf);
 					
 					//if (!first){ minus3 = 16;}
-					uint32_t crcResult = calc_crc32(buf, sizeof(buf) - 12 - 12);
+					char buf3[sizeof(buf) - 12 - 12 + 1] = {0};
+					uint32_t crcResult = crc_32_copy((unsigned char *)buf3, (unsigned char *)buf, sizeof(buf) - 12 - 12);
 					
 
 					//printf("\n%d\n", sizeof(buf) - 26);
@@ -548,6 +545,19 @@
 					crcPassedIn[6] = buf[sizeof(buf) - 2 - 12];
 					crcPassedIn[7] = buf[sizeof(buf) - 1 - 12];
 					int ok = strncmp(crcsmall, crcPassedIn, 8) == 0;
+					if (!ok && crcFix != NULL) {
+
+						/* try to repair the frame instead of asking for a retransmission */
+						char crcHex[9] = {0};
+						char *crcEnd;
+						memcpy(crcHex, crcPassedIn, 8);
+						uint32_t crcReceived = (uint32_t)strtoul(crcHex, &crcEnd, 16);
+						int fixed = (*crcEnd == '\0') ? crc_32_fix(crcFix, (unsigned char *)buf, sizeof(buf) - 12 - 12, crcReceived) : CRC_FIX_FAILED;
+						if (fixed == CRC_FIX_DATA || fixed == CRC_FIX_CRC) {
+							crcResult = crc_32_copy((unsigned char *)buf3, (unsigned char *)buf, sizeof(buf) - 12 - 12);
+							ok = 1;
+						}
+					}
 					if (ok) {
 
 						sprintf(crc, "%08lX CRC OK!!!", (unsigned long)crcResult);
@@ -567,12 +577,6 @@
 							size_t len = (size_t)sizeof(buf) - 12 - 12;
 							//char* c = (char*)malloc(6*sizeof(char));
 							//strcpy(c, "hello\0");
-							char buf3[sizeof(buf) - 12 - 12 + 1] = {0};
-							int cnt = 0;
- 							for (cnt = 0; cnt< (int)sizeof(buf) - 12 - 12; cnt++)
-							{
-								buf3[cnt] = buf[cnt];
-							}
 							char * instr = &buf3[0];
 							//printf("%s\n",instr);
 							int retval = base64decode(instr, len, out, sizeout);
@@ -34,8 +34,33 @@
 #ifndef DEF_LIBCRC_CHECKSUM_H
 #define DEF_LIBCRC_CHECKSUM_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+/*
+ * struct iovec
+ *
+ * The structure iovec describes one buffer of data which is scattered over
+ * several buffers. It is defined in sys/uio.h on POSIX platforms and has the
+ * same layout on other platforms.
+ */
+
+#if defined(_WIN32)
+							/************************************************/
+struct iovec {						/*						*/
+	void *			iov_base;		/* The start address of the buffer		*/
+	size_t			iov_len;		/* The number of bytes in the buffer		*/
+};							/*						*/
+							/************************************************/
+#else
+#include <sys/uio.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*
  * #define CRC_POLY_xxxx
  *
@@ -45,6 +70,7 @@
 
 #define		CRC_POLY_16		0xA001
 #define		CRC_POLY_32		0xEDB88320ul
+#define		CRC_POLY_32C		0x82F63B78ul
 #define		CRC_POLY_64		0x42F0E1EBA9EA3693ull
 #define		CRC_POLY_CCITT		0x1021
 #define		CRC_POLY_DNP		0xA6BC
@@ -59,6 +85,13 @@
  */
 
 #define		CRC_START_8		0x00
+#define		CRC_START_8_AUTOSAR	0xFF
+#define		CRC_START_8_BLUETOOTH	0x00
+#define		CRC_START_8_CDMA2000	0xFF
+#define		CRC_START_8_MAXIM	0x00
+#define		CRC_START_8_ROHC	0xFF
+#define		CRC_START_8_SAE_J1850	0xFF
+#define		CRC_START_8_SMBUS	0x00
 #define		CRC_START_16		0x0000
 #define		CRC_START_MODBUS	0xFFFF
 #define		CRC_START_XMODEM	0x0000
@@ -68,40 +101,354 @@
 #define		CRC_START_SICK		0x0000
 #define		CRC_START_DNP		0x0000
 #define		CRC_START_32		0xFFFFFFFFul
+#define		CRC_START_32C		0xFFFFFFFFul
 #define		CRC_START_64_ECMA	0x0000000000000000ull
 #define		CRC_START_64_WE		0xFFFFFFFFFFFFFFFFull
 
+/*
+ * #define CRC_TYPE_xxxx
+ *
+ * The constants of the form CRC_TYPE_xxxx identify the CRC algorithms which can
+ * be calculated with the streaming functions crc_ctx_init(), crc_ctx_update()
+ * and crc_ctx_final().
+ */
+
+#define		CRC_TYPE_8		1
+#define		CRC_TYPE_16		2
+#define		CRC_TYPE_MODBUS		3
+#define		CRC_TYPE_XMODEM		4
+#define		CRC_TYPE_CCITT_1D0F	5
+#define		CRC_TYPE_CCITT_FFFF	6
+#define		CRC_TYPE_KERMIT		7
+#define		CRC_TYPE_SICK		8
+#define		CRC_TYPE_DNP		9
+#define		CRC_TYPE_32		10
+#define		CRC_TYPE_32C		11
+#define		CRC_TYPE_64_ECMA	12
+#define		CRC_TYPE_64_WE		13
+
+/*
+ * #define CRC_MASK( type )
+ *
+ * The macro CRC_MASK() returns the bit which selects the CRC algorithm type in
+ * the masks of the functions crc_all() and crc_detect(). CRC_MASK_ALL selects
+ * all algorithms. CRC_NUM_TYPES is the number of elements of an array which
+ * is indexed with the CRC_TYPE_xxxx constants.
+ */
+
+#define		CRC_NUM_TYPES		14
+#define		CRC_MASK(type)		( 1u << (type) )
+#define		CRC_MASK_ALL		0x3FFEu
+
+/*
+ * #define NMEA_STATUS_xxxx
+ *
+ * The constants of the form NMEA_STATUS_xxxx are the results of the validation
+ * of an NMEA or AIS sentence by checksum_NMEA_scan().
+ */
+
+#define		NMEA_STATUS_VALID		0
+#define		NMEA_STATUS_BAD_CHECKSUM	1
+#define		NMEA_STATUS_NO_CHECKSUM		2
+#define		NMEA_STATUS_MALFORMED		3
+
+/*
+ * #define CRC_FIX_xxxx
+ *
+ * The constants of the form CRC_FIX_xxxx are the results of the error
+ * correction of a frame by crc_32_fix(). The maximum frame length and burst
+ * length for which the correction tables can be created are given by the
+ * constants CRC_32_FIX_MAX_BYTES and CRC_32_FIX_MAX_BURST.
+ */
+
+#define		CRC_FIX_NONE		0
+#define		CRC_FIX_DATA		1
+#define		CRC_FIX_CRC		2
+#define		CRC_FIX_FAILED		(-1)
+
+#define		CRC_32_FIX_MAX_BYTES	65536
+#define		CRC_32_FIX_MAX_BURST	16
+
+/*
+ * struct crc_ctx
+ *
+ * The structure crc_ctx contains the state of a streaming CRC calculation. The
+ * fields should not be accessed directly by the application.
+ */
+
+							/************************************************/
+struct crc_ctx {					/*						*/
+	int			type;			/* The CRC algorithm CRC_TYPE_xxxx		*/
+	uint64_t		crc;			/* The CRC register value			*/
+	unsigned char		prev_byte;		/* The last byte processed, used by CRC-SICK	*/
+};							/*						*/
+							/************************************************/
+
+/*
+ * struct crc_roll
+ *
+ * The structure crc_roll contains the state of a rolling CRC calculation over
+ * a window of the last bytes of a data stream. The fields should not be
+ * accessed directly by the application.
+ */
+
+#define		CRC_ROLL_MAX_WINDOW	256
+
+							/************************************************/
+struct crc_roll {					/*						*/
+	int			type;			/* The CRC algorithm CRC_TYPE_xxxx		*/
+	int			bits;			/* The width of the CRC in bits			*/
+	bool			reflected;		/* The CRC is calculated with reflected bits	*/
+	size_t			window;			/* The number of bytes in the window		*/
+	size_t			count;			/* The number of bytes added, up to the window	*/
+	uint64_t		crc;			/* The CRC register of the window		*/
+	uint64_t		tab[256];		/* Lookup table for a byte entering the window	*/
+	uint64_t		out[256];		/* Lookup table for a byte leaving the window	*/
+	unsigned char		history[CRC_ROLL_MAX_WINDOW]; /* The bytes in the window, oldest first	*/
+};							/*						*/
+							/************************************************/
+
+/*
+ * struct crc_fix
+ *
+ * The structure crc_fix contains the precalculated tables for the error
+ * correction of CRC-32 protected frames. It is created by crc_32_fix_create()
+ * and its contents are private to the library.
+ */
+
+struct crc_fix;
+
+/*
+ * struct crc_model
+ *
+ * The structure crc_model describes a CRC algorithm with the parameters of
+ * the Rocksoft model. The polynomial and the start value are given in the
+ * normal notation with the most significant bit first and without the leading
+ * term of the polynomial. The check value is the CRC of the ASCII string
+ * "123456789".
+ */
+
+							/************************************************/
+struct crc_model {					/*						*/
+	const char *		name;			/* The name of the CRC algorithm		*/
+	int			width;			/* The width of the CRC in bits, 1 to 64	*/
+	uint64_t		poly;			/* The polynomial without the leading term	*/
+	uint64_t		init;			/* The start value of the CRC register		*/
+	bool			refin;			/* The input bytes are reflected		*/
+	bool			refout;			/* The final CRC value is reflected		*/
+	uint64_t		xorout;			/* The value XOR-ed with the final CRC		*/
+	uint64_t		check;			/* The CRC of the string "123456789"		*/
+};							/*						*/
+							/************************************************/
+
+/*
+ * struct nmea_sentence
+ *
+ * The structure nmea_sentence describes the position and the checksum of one
+ * NMEA or AIS sentence in a buffer which was searched by checksum_NMEA_scan().
+ * The length includes the start character and the checksum field, but not the
+ * line terminator.
+ */
+
+							/************************************************/
+struct nmea_sentence {					/*						*/
+	size_t			offset;			/* The offset of the '$' or '!' in the buffer	*/
+	size_t			length;			/* The length without the line terminator	*/
+	unsigned char		checksum;		/* The calculated checksum of the sentence	*/
+	int			status;			/* The validation result NMEA_STATUS_xxxx	*/
+};							/*						*/
+							/************************************************/
+
+/*
+ * struct nmea_view
+ *
+ * The structure nmea_view describes one NMEA or AIS sentence which was found
+ * by checksum_NMEA_stream(). The pointer points either in the input buffer or
+ * in the stream state and is valid until the next call with the same stream.
+ */
+
+							/************************************************/
+struct nmea_view {					/*						*/
+	const unsigned char *	ptr;			/* The start character '$' or '!'		*/
+	size_t			length;			/* The length without the line terminator	*/
+	unsigned char		checksum;		/* The calculated checksum of the sentence	*/
+	int			status;			/* The validation result NMEA_STATUS_xxxx	*/
+};							/*						*/
+							/************************************************/
+
+/*
+ * struct nmea_stream
+ *
+ * The structure nmea_stream contains the state of an NMEA parser which is fed
+ * with chunks of a serial data stream. Only sentences which span two chunks
+ * are copied to one of the buffers. The fields should not be accessed
+ * directly by the application.
+ */
+
+#define		NMEA_STREAM_SIZE	256
+
+							/************************************************/
+struct nmea_stream {					/*						*/
+	int			state;			/* The state of the parser			*/
+	unsigned char		checksum;		/* The running checksum of the sentence		*/
+	unsigned char		field[2];		/* The first two characters after the '*'	*/
+	size_t			field_len;		/* The number of characters after the '*'	*/
+	size_t			length;			/* The number of bytes stored in the buffer	*/
+	bool			overflow;		/* The sentence did not fit in the buffer	*/
+	int			active;			/* The buffer which stores the sentence		*/
+	unsigned char		buffer[2][NMEA_STREAM_SIZE]; /* Sentences which span two chunks	*/
+};							/*						*/
+							/************************************************/
+
 /*
  * Prototype list of global functions
  */
 
 unsigned char *		checksum_NMEA(      const unsigned char *input_str, unsigned char *result  );
+size_t			checksum_NMEA_scan( const unsigned char *input_str, size_t num_bytes, struct nmea_sentence *sentence, size_t max_sentences, size_t *num_used );
+size_t			checksum_NMEA_stream( struct nmea_stream *stream, const unsigned char *input_str, size_t num_bytes, struct nmea_view *view, size_t max_views, size_t *num_used );
+struct nmea_stream *	checksum_NMEA_stream_init( struct nmea_stream *stream );
 uint8_t			crc_8(              const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_combine(      uint8_t  crc1, uint8_t  crc2, size_t len2              );
+uint8_t			crc_8_copy(         unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint8_t			crc_8_iov(          const struct iovec *iov, int iovcnt                    );
+uint8_t			crc_8_patch(        uint8_t  crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint8_t			crc_8_zeros(        uint8_t  crc, uint64_t num_bytes                       );
+uint8_t			crc_8_autosar(      const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_bluetooth(    const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_cdma2000(     const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_maxim(        const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_rohc(         const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_sae_j1850(    const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_smbus(        const unsigned char *input_str, size_t num_bytes       );
 uint16_t		crc_16(             const unsigned char *input_str, size_t num_bytes       );
+uint16_t		crc_16_combine(     uint16_t crc1, uint16_t crc2, size_t len2              );
+uint16_t		crc_16_copy(        unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint16_t		crc_16_iov(         const struct iovec *iov, int iovcnt                    );
+uint16_t		crc_16_patch(       uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint16_t		crc_16_zeros(       uint16_t crc, uint64_t num_bytes                       );
 uint32_t		crc_32(             const unsigned char *input_str, size_t num_bytes       );
+uint32_t		crc_32_combine(     uint32_t crc1, uint32_t crc2, size_t len2              );
+uint32_t		crc_32_copy(        unsigned char *dst, const unsigned char *src, size_t num_bytes );
+int			crc_32_fix(         const struct crc_fix *fix, unsigned char *input_str, size_t num_bytes, uint32_t crc );
+struct crc_fix *	crc_32_fix_create(  size_t max_bytes, int max_burst                        );
+void			crc_32_fix_free(    struct crc_fix *fix                                    );
+uint32_t		crc_32_iov(         const struct iovec *iov, int iovcnt                    );
+uint32_t		crc_32_parallel(    const unsigned char *input_str, size_t num_bytes, int num_threads );
+uint32_t		crc_32_patch(       uint32_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint32_t		crc_32_zeros(       uint32_t crc, uint64_t num_bytes                       );
+uint32_t		crc_32c(            const unsigned char *input_str, size_t num_bytes       );
+uint32_t		crc_32c_combine(    uint32_t crc1, uint32_t crc2, size_t len2              );
+uint32_t		crc_32c_copy(       unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint32_t		crc_32c_iov(        const struct iovec *iov, int iovcnt                    );
+uint32_t		crc_32c_parallel(   const unsigned char *input_str, size_t num_bytes, int num_threads );
+uint32_t		crc_32c_patch(      uint32_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint32_t		crc_32c_zeros(      uint32_t crc, uint64_t num_bytes                       );
 uint64_t		crc_64_ecma(        const unsigned char *input_str, size_t num_bytes       );
+uint64_t		crc_64_ecma_combine( uint64_t crc1, uint64_t crc2, size_t len2             );
+uint64_t		crc_64_ecma_copy(   unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint64_t		crc_64_ecma_iov(    const struct iovec *iov, int iovcnt                    );
+uint64_t		crc_64_ecma_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads );
+uint64_t		crc_64_ecma_patch(  uint64_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint64_t		crc_64_ecma_zeros(  uint64_t crc, uint64_t num_bytes                       );
 uint64_t		crc_64_we(          const unsigned char *input_str, size_t num_bytes       );
+uint64_t		crc_64_we_combine(  uint64_t crc1, uint64_t crc2, size_t len2              );
+uint64_t		crc_64_we_copy(     unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint64_t		crc_64_we_iov(      const struct iovec *iov, int iovcnt                    );
+uint64_t		crc_64_we_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads );
+uint64_t		crc_64_we_patch(    uint64_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint64_t		crc_64_we_zeros(    uint64_t crc, uint64_t num_bytes                       );
+void			crc_all(            const unsigned char *input_str, size_t num_bytes, unsigned int type_mask, uint64_t *crc );
+struct crc_ctx *	crc_ctx_init(       struct crc_ctx *ctx, int type                          );
+int			crc_ctx_file(       struct crc_ctx *ctx, const char *filename              );
+uint64_t		crc_ctx_final(      const struct crc_ctx *ctx                              );
+void			crc_ctx_update(     struct crc_ctx *ctx, const unsigned char *input_str, size_t num_bytes );
+void			crc_ctx_zeros(      struct crc_ctx *ctx, uint64_t num_bytes                );
 uint16_t		crc_ccitt_1d0f(     const unsigned char *input_str, size_t num_bytes       );
+uint16_t		crc_ccitt_1d0f_combine( uint16_t crc1, uint16_t crc2, size_t len2          );
+uint16_t		crc_ccitt_1d0f_copy( unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint16_t		crc_ccitt_1d0f_iov( const struct iovec *iov, int iovcnt                    );
+uint16_t		crc_ccitt_1d0f_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint16_t		crc_ccitt_1d0f_zeros( uint16_t crc, uint64_t num_bytes                     );
 uint16_t		crc_ccitt_ffff(     const unsigned char *input_str, size_t num_bytes       );
+uint16_t		crc_ccitt_ffff_combine( uint16_t crc1, uint16_t crc2, size_t len2          );
+uint16_t		crc_ccitt_ffff_copy( unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint16_t		crc_ccitt_ffff_iov( const struct iovec *iov, int iovcnt                    );
+uint16_t		crc_ccitt_ffff_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint16_t		crc_ccitt_ffff_zeros( uint16_t crc, uint64_t num_bytes                     );
+unsigned int		crc_detect(         const unsigned char *input_str, size_t num_bytes, unsigned int type_mask );
 uint16_t		crc_dnp(            const unsigned char *input_str, size_t num_bytes       );
+uint16_t		crc_dnp_combine(    uint16_t crc1, uint16_t crc2, size_t len2              );
+uint16_t		crc_dnp_copy(       unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint16_t		crc_dnp_iov(        const struct iovec *iov, int iovcnt                    );
+uint16_t		crc_dnp_patch(      uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint16_t		crc_dnp_zeros(      uint16_t crc, uint64_t num_bytes                       );
 uint16_t		crc_kermit(         const unsigned char *input_str, size_t num_bytes       );
+uint16_t		crc_kermit_combine( uint16_t crc1, uint16_t crc2, size_t len2              );
+uint16_t		crc_kermit_copy(    unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint16_t		crc_kermit_iov(     const struct iovec *iov, int iovcnt                    );
+uint16_t		crc_kermit_patch(   uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint16_t		crc_kermit_zeros(   uint16_t crc, uint64_t num_bytes                       );
 uint16_t		crc_modbus(         const unsigned char *input_str, size_t num_bytes       );
+uint16_t		crc_modbus_combine( uint16_t crc1, uint16_t crc2, size_t len2              );
+uint16_t		crc_modbus_copy(    unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint16_t		crc_modbus_iov(     const struct iovec *iov, int iovcnt                    );
+uint16_t		crc_modbus_patch(   uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint16_t		crc_modbus_zeros(   uint16_t crc, uint64_t num_bytes                       );
+void			crc_multi(          int type, const unsigned char * const *input_str, const size_t *num_bytes, uint64_t *crc, size_t num_buffers );
+uint64_t		crc_model_calc(     const struct crc_model *model, const unsigned char *input_str, size_t num_bytes );
+const struct crc_model *crc_model_catalogue( size_t *num_models                                    );
+uint64_t		crc_model_final(    const struct crc_model *model, uint64_t crc            );
+const struct crc_model *crc_model_find(     const char *name                                       );
+uint64_t		crc_model_init(     const struct crc_model *model                          );
+uint64_t		crc_model_update(   const struct crc_model *model, uint64_t crc, const unsigned char *input_str, size_t num_bytes );
+struct crc_ctx *	crc_roll_ctx(       const struct crc_roll *roll, struct crc_ctx *ctx       );
+uint64_t		crc_roll_final(     const struct crc_roll *roll                            );
+size_t			crc_roll_find(      struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes, uint64_t mask, uint64_t value );
+struct crc_roll *	crc_roll_init(      struct crc_roll *roll, int type, size_t window         );
+void			crc_roll_update(    struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes );
 uint16_t		crc_sick(           const unsigned char *input_str, size_t num_bytes       );
+uint16_t		crc_sick_combine(   uint16_t crc1, uint16_t crc2, size_t len2, unsigned char last_byte1 );
+uint16_t		crc_sick_copy(      unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint16_t		crc_sick_iov(       const struct iovec *iov, int iovcnt                    );
+uint16_t		crc_sick_patch(     uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint16_t		crc_sick_zeros(     uint16_t crc, uint64_t num_bytes, unsigned char last_byte );
 uint16_t		crc_xmodem(         const unsigned char *input_str, size_t num_bytes       );
+uint16_t		crc_xmodem_combine( uint16_t crc1, uint16_t crc2, size_t len2              );
+uint16_t		crc_xmodem_copy(    unsigned char *dst, const unsigned char *src, size_t num_bytes );
+uint16_t		crc_xmodem_iov(     const struct iovec *iov, int iovcnt                    );
+uint16_t		crc_xmodem_patch(   uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+uint16_t		crc_xmodem_zeros(   uint16_t crc, uint64_t num_bytes                       );
 uint8_t			update_crc_8(       uint8_t  crc, unsigned char c                          );
+uint8_t			update_crc_8_block( uint8_t  crc, const unsigned char *input_str, size_t num_bytes );
+uint8_t			update_crc_8_poly_block( uint8_t poly, bool reflected, uint8_t crc, const unsigned char *input_str, size_t num_bytes );
 uint16_t		update_crc_16(      uint16_t crc, unsigned char c                          );
+uint16_t		update_crc_16_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes );
 uint32_t		update_crc_32(      uint32_t crc, unsigned char c                          );
-uint64_t		update_crc_64_ecma( uint64_t crc, unsigned char c                          );
+uint32_t		update_crc_32_block( uint32_t crc, const unsigned char *input_str, size_t num_bytes );
+uint32_t		update_crc_32c(     uint32_t crc, unsigned char c                          );
+uint32_t		update_crc_32c_block( uint32_t crc, const unsigned char *input_str, size_t num_bytes );
+uint64_t		update_crc_64(      uint64_t crc, unsigned char c                          );
+uint64_t		update_crc_64_block( uint64_t crc, const unsigned char *input_str, size_t num_bytes );
 uint16_t		update_crc_ccitt(   uint16_t crc, unsigned char c                          );
+uint16_t		update_crc_ccitt_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes );
 uint16_t		update_crc_dnp(     uint16_t crc, unsigned char c                          );
+uint16_t		update_crc_dnp_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes );
 uint16_t		update_crc_kermit(  uint16_t crc, unsigned char c                          );
+uint16_t		update_crc_kermit_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes );
 uint16_t		update_crc_sick(    uint16_t crc, unsigned char c, unsigned char prev_byte );
+uint16_t		update_crc_sick_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes, unsigned char prev_byte );
 
 /*
  * Global CRC lookup tables
  */
 
 extern const uint32_t	crc_tab32[];
+extern const uint32_t	crc_tab32c[];
 extern const uint64_t	crc_tab64[];
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif  // DEF_LIBCRC_CHECKSUM_H
@@ -0,0 +1,528 @@
+/*
+ * Library: libcrc
+ * File:    include/checksum.hpp
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The header file include/checksum.hpp contains header only C++ templates to
+ * calculate CRC values. The algorithm is selected with template parameters
+ * following the Rocksoft model, and the lookup tables are generated by the
+ * compiler. All functions are constexpr, so the CRC of string literals and
+ * other constant data can be calculated at compile time. The header needs a
+ * compiler which supports C++14 and does not depend on the compiled library.
+ *
+ * The type aliases at the end of the file give the same results as the
+ * functions with the same name in include/checksum.h, including the byte swap
+ * of the Kermit and DNP functions and the previous byte scheme of the SICK
+ * CRC.
+ */
+
+#ifndef DEF_LIBCRC_CHECKSUM_HPP
+#define DEF_LIBCRC_CHECKSUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace libcrc {
+
+namespace detail {
+
+/*
+ * template <int Width> struct uint_width;
+ *
+ * The type uint_width<Width>::type is the smallest unsigned integer type with
+ * at least Width bits.
+ */
+
+template <int Width> struct uint_width {
+
+	using type = typename std::conditional< ( Width <=  8 ), std::uint8_t,
+		     typename std::conditional< ( Width <= 16 ), std::uint16_t,
+		     typename std::conditional< ( Width <= 32 ), std::uint32_t,
+								 std::uint64_t >::type >::type >::type;
+
+};  /* uint_width */
+
+/*
+ * constexpr std::uint64_t reflect( std::uint64_t val, int width );
+ *
+ * The function reflect() returns the lowest width bits of a value in reversed
+ * order.
+ */
+
+constexpr std::uint64_t reflect( std::uint64_t val, int width ) {
+
+	std::uint64_t result = 0;
+
+	for (int a=0; a<width; a++) {
+
+		result = ( result << 1 ) | ( val & 1u );
+		val  >>= 1;
+	}
+
+	return result;
+
+}  /* reflect */
+
+/*
+ * template <typename Reg, int Width, std::uint64_t Poly, bool RefIn> struct crc_table;
+ *
+ * The structure crc_table contains the slicing-by-8 lookup tables for a CRC
+ * register of type Reg. Reflected CRC values are stored in the lowest bits of
+ * the register, other values in the highest bits. The tables are calculated
+ * by the constexpr constructor.
+ */
+
+template <typename Reg, int Width, std::uint64_t Poly, bool RefIn> struct crc_table {
+
+	static constexpr int	bits = 8 * sizeof(Reg);
+
+	Reg			tab[8][256];
+
+	constexpr crc_table() : tab() {
+
+		const Reg reg_poly = RefIn ? static_cast<Reg>( reflect( Poly, Width ) )
+					   : static_cast<Reg>( Poly << ( bits - Width ) );
+
+		for (int b=0; b<256; b++) {
+
+			Reg crc = RefIn ? static_cast<Reg>( b ) : static_cast<Reg>( static_cast<std::uint64_t>( b ) << ( bits - 8 ) );
+
+			for (int c=0; c<8; c++) {
+
+				if ( RefIn ) crc = ( crc & 1u )                   ? static_cast<Reg>( ( crc >> 1 ) ^ reg_poly ) : static_cast<Reg>( crc >> 1 );
+				else         crc = ( ( crc >> ( bits - 1 ) ) & 1u ) ? static_cast<Reg>( ( crc << 1 ) ^ reg_poly ) : static_cast<Reg>( crc << 1 );
+			}
+
+			tab[0][b] = crc;
+		}
+
+		for (int a=1; a<8; a++) {
+
+			for (int b=0; b<256; b++) {
+
+				const Reg prev = tab[a-1][b];
+
+				if ( RefIn ) tab[a][b] = static_cast<Reg>( ( static_cast<std::uint64_t>( prev ) >> 8 ) ^ tab[0][ prev & 0xFFu ] );
+				else         tab[a][b] = static_cast<Reg>( ( static_cast<std::uint64_t>( prev ) << 8 ) ^ tab[0][ ( prev >> ( bits - 8 ) ) & 0xFFu ] );
+			}
+		}
+	}
+
+};  /* crc_table */
+
+/*
+ * template <typename Reg, int Width, std::uint64_t Poly, bool RefIn> constexpr crc_table<Reg, Width, Poly, RefIn> table;
+ *
+ * The variable template table contains one instance of the lookup tables for
+ * each combination of parameters. All CRC algorithms which only differ in the
+ * start value and the processing of the final value share the same tables.
+ */
+
+template <typename Reg, int Width, std::uint64_t Poly, bool RefIn>
+constexpr crc_table<Reg, Width, Poly, RefIn> table{};
+
+}  // namespace detail
+
+/*
+ * template <int Width, std::uint64_t Poly, std::uint64_t Init, bool RefIn, bool RefOut, std::uint64_t XorOut, bool SwapOut = false> class crc;
+ *
+ * The class template crc calculates the CRC with the parameters of the
+ * Rocksoft model. The polynomial and the start value are given in the normal
+ * notation with the most significant bit first and without the leading term
+ * of the polynomial. The optional parameter SwapOut swaps the two bytes of a
+ * 16 bit result, as done by some functions in the C library.
+ *
+ * The static functions calculate the CRC of a buffer in one pass, or can be
+ * used to update a register value step by step as with the update_crc_xxx()
+ * functions in the C library. An object of the class keeps the register value
+ * of a streaming calculation.
+ */
+
+template <int Width, std::uint64_t Poly, std::uint64_t Init, bool RefIn, bool RefOut, std::uint64_t XorOut, bool SwapOut = false>
+class crc {
+
+	static_assert( Width >= 1  &&  Width <= 64,   "The width of the CRC must be between 1 and 64 bits" );
+	static_assert( ! SwapOut  ||  Width == 16,    "Only 16 bit CRC values can be byte swapped" );
+
+public:
+
+	using value_type = typename detail::uint_width<Width>::type;
+
+	static constexpr int		width  = Width;
+	static constexpr std::uint64_t	poly   = Poly;
+	static constexpr std::uint64_t	start  = Init;
+	static constexpr bool		refin  = RefIn;
+	static constexpr bool		refout = RefOut;
+	static constexpr std::uint64_t	xorout = XorOut;
+
+private:
+
+	static constexpr int		bits  = 8 * sizeof(value_type);
+	static constexpr std::uint64_t	mask  = ( Width == 64 ) ? ~0ull : ( ( 1ull << ( Width % 64 ) ) - 1 );
+	static constexpr int		shift = RefIn ? 0 : bits - Width;
+
+	using table_type = detail::crc_table<value_type, Width, Poly & mask, RefIn>;
+
+	value_type			reg;
+
+	/*
+	 * template <typename Byte> static constexpr value_type block( value_type crc, const Byte *ptr, std::size_t num_bytes );
+	 *
+	 * The function block() updates a register value with a block of bytes.
+	 * Eight bytes are processed per step with the slicing-by-8 tables, the
+	 * remaining bytes one by one. The bytes are converted individually so
+	 * that the function can be evaluated at compile time for both char and
+	 * unsigned char buffers.
+	 */
+
+	template <typename Byte>
+	static constexpr value_type block( value_type crc, const Byte *ptr, std::size_t num_bytes ) {
+
+		const table_type &t = detail::table<value_type, Width, Poly & mask, RefIn>;
+
+		while ( num_bytes >= 8 ) {
+
+			std::uint64_t val = 0;
+
+			if ( RefIn ) {
+
+				val = ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[0] ) )       )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[1] ) ) <<  8 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[2] ) ) << 16 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[3] ) ) << 24 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[4] ) ) << 32 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[5] ) ) << 40 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[6] ) ) << 48 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[7] ) ) << 56 );
+
+				val ^= crc;
+
+				crc = static_cast<value_type>( t.tab[7][  val        & 0xFFu ] ^ t.tab[6][ (val >>  8) & 0xFFu ]
+							     ^ t.tab[5][ (val >> 16) & 0xFFu ] ^ t.tab[4][ (val >> 24) & 0xFFu ]
+							     ^ t.tab[3][ (val >> 32) & 0xFFu ] ^ t.tab[2][ (val >> 40) & 0xFFu ]
+							     ^ t.tab[1][ (val >> 48) & 0xFFu ] ^ t.tab[0][  val >> 56          ] );
+			}
+
+			else {
+
+				val = ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[0] ) ) << 56 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[1] ) ) << 48 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[2] ) ) << 40 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[3] ) ) << 32 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[4] ) ) << 24 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[5] ) ) << 16 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[6] ) ) <<  8 )
+				    | ( static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[7] ) )       );
+
+				val ^= static_cast<std::uint64_t>( crc ) << ( 64 - bits );
+
+				crc = static_cast<value_type>( t.tab[7][  val >> 56          ] ^ t.tab[6][ (val >> 48) & 0xFFu ]
+							     ^ t.tab[5][ (val >> 40) & 0xFFu ] ^ t.tab[4][ (val >> 32) & 0xFFu ]
+							     ^ t.tab[3][ (val >> 24) & 0xFFu ] ^ t.tab[2][ (val >> 16) & 0xFFu ]
+							     ^ t.tab[1][ (val >>  8) & 0xFFu ] ^ t.tab[0][  val        & 0xFFu ] );
+			}
+
+			ptr       += 8;
+			num_bytes -= 8;
+		}
+
+		while ( num_bytes-- > 0 ) crc = update( crc, static_cast<unsigned char>( *ptr++ ) );
+
+		return crc;
+
+	}  /* block */
+
+public:
+
+	/*
+	 * constexpr crc();
+	 *
+	 * The constructor initializes the register of a streaming calculation
+	 * with the start value.
+	 */
+
+	constexpr crc() : reg( init() ) {}
+
+	/*
+	 * static constexpr value_type init();
+	 *
+	 * The function init() returns the start value of the CRC register.
+	 */
+
+	static constexpr value_type init() {
+
+		return RefIn ? static_cast<value_type>( detail::reflect( Init & mask, Width ) )
+			     : static_cast<value_type>( ( Init & mask ) << shift );
+
+	}  /* init */
+
+	/*
+	 * static constexpr value_type update( value_type crc, unsigned char c );
+	 *
+	 * The function update() calculates a new register value based on the
+	 * previous value and the next byte of the data.
+	 */
+
+	static constexpr value_type update( value_type crc, unsigned char c ) {
+
+		const table_type &t = detail::table<value_type, Width, Poly & mask, RefIn>;
+
+		if ( RefIn ) return static_cast<value_type>( ( static_cast<std::uint64_t>( crc ) >> 8 ) ^ t.tab[0][ ( crc ^ c ) & 0xFFu ] );
+		else         return static_cast<value_type>( ( static_cast<std::uint64_t>( crc ) << 8 ) ^ t.tab[0][ ( ( crc >> ( bits - 8 ) ) ^ c ) & 0xFFu ] );
+
+	}  /* update */
+
+	/*
+	 * static constexpr value_type update( value_type crc, const unsigned char *ptr, std::size_t num_bytes );
+	 * static constexpr value_type update( value_type crc, const char *ptr, std::size_t num_bytes );
+	 *
+	 * The function update() calculates a new register value based on the
+	 * previous value and a block of data.
+	 */
+
+	static constexpr value_type update( value_type crc, const unsigned char *ptr, std::size_t num_bytes ) {
+
+		return ( ptr == nullptr ) ? crc : block( crc, ptr, num_bytes );
+
+	}  /* update */
+
+	static constexpr value_type update( value_type crc, const char *ptr, std::size_t num_bytes ) {
+
+		return ( ptr == nullptr ) ? crc : block( crc, ptr, num_bytes );
+
+	}  /* update */
+
+	/*
+	 * static constexpr value_type final( value_type crc );
+	 *
+	 * The function final() converts a register value to the CRC value. The
+	 * output reflection, the final XOR and the optional byte swap are applied.
+	 */
+
+	static constexpr value_type final( value_type crc ) {
+
+		std::uint64_t val = static_cast<std::uint64_t>( crc ) >> shift;
+
+		if ( RefIn != RefOut ) val = detail::reflect( val, Width );
+
+		val = ( val ^ XorOut ) & mask;
+
+		if ( SwapOut ) val = ( ( val >> 8 ) | ( val << 8 ) ) & 0xFFFFu;
+
+		return static_cast<value_type>( val );
+
+	}  /* final */
+
+	/*
+	 * static constexpr value_type calc( const unsigned char *ptr, std::size_t num_bytes );
+	 * static constexpr value_type calc( const char *ptr, std::size_t num_bytes );
+	 * template <std::size_t N> static constexpr value_type calc( const char (&str)[N] );
+	 *
+	 * The function calc() calculates the CRC of a buffer in one pass. The
+	 * version for string literals does not include the terminating NUL
+	 * character in the calculation.
+	 */
+
+	static constexpr value_type calc( const unsigned char *ptr, std::size_t num_bytes ) {
+
+		return final( update( init(), ptr, num_bytes ) );
+
+	}  /* calc */
+
+	static constexpr value_type calc( const char *ptr, std::size_t num_bytes ) {
+
+		return final( update( init(), ptr, num_bytes ) );
+
+	}  /* calc */
+
+	template <std::size_t N>
+	static constexpr value_type calc( const char (&str)[N] ) {
+
+		return final( update( init(), str, N - 1 ) );
+
+	}  /* calc */
+
+	/*
+	 * constexpr crc &add( const unsigned char *ptr, std::size_t num_bytes );
+	 * constexpr crc &add( const char *ptr, std::size_t num_bytes );
+	 * constexpr crc &add( unsigned char c );
+	 *
+	 * The function add() adds data to a streaming calculation.
+	 */
+
+	constexpr crc &add( const unsigned char *ptr, std::size_t num_bytes ) { reg = update( reg, ptr, num_bytes ); return *this; }
+	constexpr crc &add( const char *ptr, std::size_t num_bytes )          { reg = update( reg, ptr, num_bytes ); return *this; }
+	constexpr crc &add( unsigned char c )                                 { reg = update( reg, c );              return *this; }
+
+	/*
+	 * constexpr value_type value() const;
+	 * constexpr void reset();
+	 *
+	 * The function value() returns the CRC of the data added so far. More
+	 * data can be added afterwards. The function reset() restarts the
+	 * calculation.
+	 */
+
+	constexpr value_type value() const { return final( reg ); }
+	constexpr void reset()             { reg = init(); }
+
+};  /* crc */
+
+/*
+ * class crc_sick;
+ *
+ * The class crc_sick calculates the CRC used by SICK sensors. This CRC is not
+ * part of the Rocksoft model, because every step shifts the register only one
+ * bit and adds the current and the previous byte. The interface is the same
+ * as that of the crc template, except that update() needs the previous byte.
+ */
+
+class crc_sick {
+
+	std::uint16_t		reg;
+	unsigned char		prev;
+
+	template <typename Byte>
+	static constexpr std::uint16_t block( std::uint16_t crc, const Byte *ptr, std::size_t num_bytes, unsigned char prev_byte ) {
+
+		while ( num_bytes-- > 0 ) {
+
+			const unsigned char c = static_cast<unsigned char>( *ptr++ );
+
+			crc       = update( crc, c, prev_byte );
+			prev_byte = c;
+		}
+
+		return crc;
+
+	}  /* block */
+
+public:
+
+	using value_type = std::uint16_t;
+
+	constexpr crc_sick() : reg( init() ), prev( 0 ) {}
+
+	static constexpr value_type init() { return 0x0000u; }
+
+	static constexpr value_type update( value_type crc, unsigned char c, unsigned char prev_byte ) {
+
+		crc = ( crc & 0x8000u ) ? static_cast<value_type>( ( crc << 1 ) ^ 0x8005u ) : static_cast<value_type>( crc << 1 );
+
+		return static_cast<value_type>( crc ^ ( c | ( prev_byte << 8 ) ) );
+
+	}  /* update */
+
+	static constexpr value_type update( value_type crc, const unsigned char *ptr, std::size_t num_bytes, unsigned char prev_byte ) {
+
+		return ( ptr == nullptr ) ? crc : block( crc, ptr, num_bytes, prev_byte );
+
+	}  /* update */
+
+	static constexpr value_type update( value_type crc, const char *ptr, std::size_t num_bytes, unsigned char prev_byte ) {
+
+		return ( ptr == nullptr ) ? crc : block( crc, ptr, num_bytes, prev_byte );
+
+	}  /* update */
+
+	static constexpr value_type final( value_type crc ) {
+
+		return static_cast<value_type>( ( crc >> 8 ) | ( crc << 8 ) );
+
+	}  /* final */
+
+	static constexpr value_type calc( const unsigned char *ptr, std::size_t num_bytes ) { return final( update( init(), ptr, num_bytes, 0 ) ); }
+	static constexpr value_type calc( const char *ptr, std::size_t num_bytes )          { return final( update( init(), ptr, num_bytes, 0 ) ); }
+
+	template <std::size_t N>
+	static constexpr value_type calc( const char (&str)[N] ) { return final( update( init(), str, N - 1, 0 ) ); }
+
+	constexpr crc_sick &add( unsigned char c ) {
+
+		reg  = update( reg, c, prev );
+		prev = c;
+
+		return *this;
+
+	}  /* add */
+
+	template <typename Byte>
+	constexpr crc_sick &add( const Byte *ptr, std::size_t num_bytes ) {
+
+		if ( ptr != nullptr ) while ( num_bytes-- > 0 ) add( static_cast<unsigned char>( *ptr++ ) );
+
+		return *this;
+
+	}  /* add */
+
+	constexpr value_type value() const { return final( reg ); }
+	constexpr void reset()             { reg = init(); prev = 0; }
+
+};  /* crc_sick */
+
+/*
+ * constexpr unsigned char checksum_nmea( const char *str );
+ *
+ * The function checksum_nmea() calculates the checksum of an NMEA sentence
+ * with the same rules as checksum_NMEA() in the C library. The value is
+ * returned as a number instead of two hexadecimal characters.
+ */
+
+constexpr unsigned char checksum_nmea( const char *str ) {
+
+	unsigned char checksum = 0;
+
+	if ( str == nullptr ) return 0;
+	if ( *str == '$' ) str++;
+
+	while ( *str != '\0'  &&  *str != '\r'  &&  *str != '\n'  &&  *str != '*' ) checksum ^= static_cast<unsigned char>( *str++ );
+
+	return checksum;
+
+}  /* checksum_nmea */
+
+/*
+ * The CRC algorithms of the C library
+ */
+
+using crc_8          = crc<  8, 0x31u,                 0x00u,                  false, false, 0x00u                        >;
+using crc_16         = crc< 16, 0x8005u,               0x0000u,                true,  true,  0x0000u                      >;
+using crc_modbus     = crc< 16, 0x8005u,               0xFFFFu,                true,  true,  0x0000u                      >;
+using crc_xmodem     = crc< 16, 0x1021u,               0x0000u,                false, false, 0x0000u                      >;
+using crc_ccitt_1d0f = crc< 16, 0x1021u,               0x1D0Fu,                false, false, 0x0000u                      >;
+using crc_ccitt_ffff = crc< 16, 0x1021u,               0xFFFFu,                false, false, 0x0000u                      >;
+using crc_kermit     = crc< 16, 0x1021u,               0x0000u,                true,  true,  0x0000u,               true  >;
+using crc_dnp        = crc< 16, 0x3D65u,               0x0000u,                true,  true,  0xFFFFu,               true  >;
+using crc_32         = crc< 32, 0x04C11DB7u,           0xFFFFFFFFu,            true,  true,  0xFFFFFFFFu                  >;
+using crc_32c        = crc< 32, 0x1EDC6F41u,           0xFFFFFFFFu,            true,  true,  0xFFFFFFFFu                  >;
+using crc_64_ecma    = crc< 64, 0x42F0E1EBA9EA3693ull, 0x0000000000000000ull,  false, false, 0x0000000000000000ull        >;
+using crc_64_we      = crc< 64, 0x42F0E1EBA9EA3693ull, 0xFFFFFFFFFFFFFFFFull,  false, false, 0xFFFFFFFFFFFFFFFFull        >;
+
+}  // namespace libcrc
+
+#endif  // DEF_LIBCRC_CHECKSUM_HPP
@@ -0,0 +1,143 @@
+/*
+ * Library: libcrc
+ * File:    precalc/crc_table.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 1999-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file precalc/crc_table.c contains the routines to calculate the
+ * values in the lookup tables for any CRC algorithm with a width of 1 to 64
+ * bits, and a bit by bit reference implementation to verify them.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "precalc.h"
+
+/*
+ * void init_crc_tab( int width, uint64_t poly, bool reflected, int bits );
+ *
+ * The function init_crc_tab() calculates the byte wise lookup table in
+ * crc_tab_precalc[] for a CRC of the given width. The polynomial is passed in
+ * normal notation without the leading x^width term. The table entries have
+ * the size of a CRC register of bits bits, which is the smallest of 8, 16, 32
+ * or 64 bits that can hold the CRC. Reflected CRC values are stored in the
+ * lowest bits of the register, normal CRC values in the highest bits.
+ */
+
+void init_crc_tab( int width, uint64_t poly, bool reflected, int bits ) {
+
+	int i;
+	int j;
+	uint64_t crc;
+	uint64_t top;
+	uint64_t mask;
+
+	mask = ( bits >= 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << bits ) - 1;
+	top  = 1ull << (bits - 1);
+
+	if ( reflected ) poly = reflect_bits( poly, width );
+	else             poly = poly << (bits - width);
+
+	for (i=0; i<256; i++) {
+
+		if ( reflected ) crc = (uint64_t) i;
+		else             crc = (uint64_t) i << (bits - 8);
+
+		for (j=0; j<8; j++) {
+
+			if ( reflected ) crc = ( crc & 1   ) ? ( crc >> 1 ) ^ poly : crc >> 1;
+			else             crc = ( crc & top ) ? ( ( crc << 1 ) & mask ) ^ poly : ( crc << 1 ) & mask;
+		}
+
+		crc_tab_precalc[i] = crc;
+	}
+
+}  /* init_crc_tab */
+
+/*
+ * uint64_t update_crc_bits( uint64_t crc, const unsigned char *input_str, size_t num_bytes, int width, uint64_t poly, bool reflected );
+ *
+ * The function update_crc_bits() is the reference implementation which is
+ * used to verify the generated tables. It shifts the input into a register of
+ * exactly width bits, one bit at a time, and does not use any lookup table.
+ * The register value is returned in the same notation as the algorithm, so
+ * bit reflected for reflected algorithms.
+ */
+
+uint64_t update_crc_bits( uint64_t crc, const unsigned char *input_str, size_t num_bytes, int width, uint64_t poly, bool reflected ) {
+
+	size_t a;
+	int b;
+	uint64_t bit;
+	uint64_t top;
+	uint64_t mask;
+
+	mask = ( width >= 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << width ) - 1;
+	top  = 1ull << (width - 1);
+
+	if ( reflected ) crc = reflect_bits( crc, width );
+
+	for (a=0; a<num_bytes; a++) {
+
+		for (b=0; b<8; b++) {
+
+			if ( reflected ) bit = ( input_str[a] >> b       ) & 1;
+			else             bit = ( input_str[a] >> (7 - b) ) & 1;
+
+			if ( ( ( crc & top ) != 0 ) != ( bit != 0 ) ) crc = ( ( crc << 1 ) & mask ) ^ poly;
+			else                                          crc =   ( crc << 1 ) & mask;
+		}
+	}
+
+	if ( reflected ) crc = reflect_bits( crc, width );
+
+	return crc;
+
+}  /* update_crc_bits */
+
+/*
+ * uint64_t reflect_bits( uint64_t value, int bits );
+ *
+ * The function reflect_bits() returns the lower bits of a value in reversed
+ * order.
+ */
+
+uint64_t reflect_bits( uint64_t value, int bits ) {
+
+	int a;
+	uint64_t retval;
+
+	retval = 0;
+
+	for (a=0; a<bits; a++) {
+
+		retval = ( retval << 1 ) | ( value & 1 );
+		value >>= 1;
+	}
+
+	return retval;
+
+}  /* reflect_bits */
@@ -40,20 +40,143 @@
 #include <string.h>
 #include "precalc.h"
 
-#define TYPE_CRC32		1
-#define TYPE_CRC64		2
+#define FOLD_NONE		0
+#define FOLD_32			1
+#define FOLD_64			2
+
+#define MAX_SLICES		16
+
+#define CRC32C_LONG		8192
+#define CRC32C_SHORT		256
+
+/*
+ * struct table_tp;
+ *
+ * The structure table_tp describes the contents of one generated include file
+ * with lookup tables. The polynomial is stored in normal notation without the
+ * leading x^width term, also for reflected algorithms. The fold field selects
+ * the layout of the carry-less multiplication constants, FOLD_32 for the
+ * dedicated CRC-32 routine and FOLD_64 for the generic routines in
+ * src/crcfold.c which work with a 64 bit register.
+ */
+
+struct table_tp {
+	const char *	option;
+	const char *	tabname;
+	bool		is_static;
+	int		width;
+	uint64_t	poly;
+	bool		reflected;
+	int		num_slices;
+	bool		nibble;
+	int		fold;
+	bool		powers;
+	bool		shift32;
+};
+
+/*
+ * struct power_tp;
+ *
+ * The structure power_tp describes one table in the include file with the
+ * powers which are used by the crc_xxx_combine() routines.
+ */
+
+struct power_tp {
+	const char *	tabname;
+	int		width;
+	uint64_t	poly;
+	bool		reflected;
+	int		unit_bits;
+};
 
 /*
  * Functions in this source file with local scope
  */
 
-static int	generate_table( const char *typename, const char *filename );
+static void	generate_slices( int num_slices, int bits, bool reflected );
+static bool	prepare_table( const struct table_tp *tab );
+static int	generate_powers( const char *filename );
+static int	generate_table( const struct table_tp *tab, int num_tables, const char *filename );
+static int	parse_model( struct table_tp *tab, int argc, char *argv[] );
+static FILE *	open_output( const char *filename );
+static void	print_fold32( FILE *fp, const char *tabname, uint64_t poly );
+static void	print_fold_normal( FILE *fp, const char *tabname, uint64_t poly, int bits );
+static void	print_fold_reflected( FILE *fp, const char *tabname, uint64_t poly, int bits );
+static void	print_nibble( FILE *fp, const char *tabname, int width, uint64_t poly, bool reflected, int bits );
+static void	print_powers( FILE *fp, const char *tabname, uint64_t poly, int bits, bool reflected, int unit_bits );
+static void	print_simd( FILE *fp, const struct table_tp *tab );
+static void	print_shift32( FILE *fp, const char *tabname, const char *suffix, const char *lenname, uint64_t num_bytes );
+static void	print_table( FILE *fp, const uint64_t *table, int bits );
+static void	print_tables( FILE *fp, const struct table_tp *tab );
+static void	print_value( FILE *fp, uint64_t value, int bits );
+static uint64_t	mul_mod( uint64_t a, uint64_t b, uint64_t poly, int bits );
+static int	register_bits( int width );
+static bool	verify_tables( const struct table_tp *tab, int bits );
+static uint64_t	xpow_div( uint64_t n, uint64_t poly, int bits );
+static uint64_t	xpow_mod( uint64_t n, uint64_t poly, int bits );
 
 /*
- * Internal table to store the CRC lookup table
+ * Internal table to store the CRC lookup table and the derived tables used by
+ * the slicing-by-N routines. Slice 0 is the normal byte wise lookup table.
  */
 
 uint64_t	crc_tab_precalc[256];
+static uint64_t	crc_tab_slice[MAX_SLICES][256];
+
+/*
+ * static const struct table_tp table_list[];
+ *
+ * The table table_list[] contains the lookup tables of the CRC routines in the
+ * library, selected by a command line option. Every entry is a special case
+ * of the generic --model option. Consecutive entries with the same option are
+ * written to the same include file. This is used for the CRC-8 family where
+ * the tables of all supported polynomials live in one file.
+ */
+
+static const struct table_tp table_list[] = {
+
+	{ "--crc8",   "crc_tab8",      false,  8, 0x31ull,                false,  8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_07",   false,  8, 0x07ull,                false,  8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_07r",  false,  8, 0x07ull,                true,   8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_1d",   false,  8, 0x1Dull,                false,  8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_2f",   false,  8, 0x2Full,                false,  8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_31r",  false,  8, 0x31ull,                true,   8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_9b",   false,  8, 0x9Bull,                false,  8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_9br",  false,  8, 0x9Bull,                true,   8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_a7r",  false,  8, 0xA7ull,                true,   8, false, FOLD_64,   false, false },
+	{ "--crc8",   "crc_tab8_d5",   false,  8, 0xD5ull,                false,  8, false, FOLD_64,   false, false },
+	{ "--crc16",  "crc_tab16",     false, 16, 0x8005ull,              true,   1, false, FOLD_64,   false, false },
+	{ "--crc32",  "crc_tab32",     false, 32, 0x04C11DB7ull,          true,  16, false, FOLD_32,   false, false },
+	{ "--crc32c", "crc_tab32c",    false, 32, 0x1EDC6F41ull,          true,   8, false, FOLD_NONE, false, true  },
+	{ "--crc64",  "crc_tab64",     false, 64, 0x42F0E1EBA9EA3693ull,  false,  8, false, FOLD_64,   false, false },
+	{ "--ccitt",  "crc_tabccitt",  false, 16, 0x1021ull,              false,  1, false, FOLD_64,   false, false },
+	{ "--dnp",    "crc_tabdnp",    false, 16, 0x3D65ull,              true,   1, false, FOLD_64,   false, false },
+	{ "--kermit", "crc_tabkermit", false, 16, 0x1021ull,              true,   1, false, FOLD_64,   false, false },
+	{ "--sick",   "crc_tabsick",   true,  16, 0x8005ull,              false,  2, false, FOLD_NONE, false, false },
+	{ NULL,       NULL,            false,  0, 0x0ull,                 false,  0, false, FOLD_NONE, false, false }
+};
+
+/*
+ * static const struct power_tp power_list[];
+ *
+ * The table power_list[] contains the power tables which are generated with
+ * the --powers option. The SICK algorithm shifts the CRC only one bit for
+ * every input byte and therefore uses units of one bit.
+ */
+
+static const struct power_tp power_list[] = {
+
+	{ "crc_pow_8",       8, 0x31ull,                false, 8 },
+	{ "crc_pow_16",     16, 0x8005ull,              true,  8 },
+	{ "crc_pow_ccitt",  16, 0x1021ull,              false, 8 },
+	{ "crc_pow_kermit", 16, 0x1021ull,              true,  8 },
+	{ "crc_pow_dnp",    16, 0x3D65ull,              true,  8 },
+	{ "crc_pow_sick",   16, 0x8005ull,              false, 1 },
+	{ "crc_pow_32",     32, 0x04C11DB7ull,          true,  8 },
+	{ "crc_pow_32c",    32, 0x1EDC6F41ull,          true,  8 },
+	{ "crc_pow_64",     64, 0x42F0E1EBA9EA3693ull,  false, 8 },
+	{ NULL,              0, 0x0ull,                 false, 0 }
+};
 
 /*
  * int main( int argc, char *argv[] );
@@ -64,66 +187,154 @@ uint64_t	crc_tab_precalc[256];
  * will be able to optimize the routines more when the tables are guaranteerd
  * to be constant than when they have been generated on the fly as variable
  * tables.
+ *
+ * Apart from the tables of the library, the --model option generates the
+ * tables and constants of any CRC algorithm with a width of 1 to 64 bits.
  */
 
 int main( int argc, char *argv[] ) {
 
+	int a;
+	int b;
 	int retval;
+	struct table_tp model;
 
-	if ( argc != 3 ) {
+	retval = -1;
 
-		fprintf( stderr, "\nusage: precalc --type file\n" );
-		fprintf( stderr, "       where --type is any of --crc64\n\n" );
+	if      ( argc == 3  &&  ! strcmp( argv[1], "--powers" ) ) retval = generate_powers( argv[2] );
+	else if ( argc >= 7  &&  ! strcmp( argv[1], "--model"  ) ) {
+
+		retval = parse_model( &model, argc, argv );
+		if ( retval == 0 ) retval = generate_table( &model, 1, argv[argc-1] );
+	}
+
+	else if ( argc == 3 ) {
+
+		for (a=0; table_list[a].option != NULL; a++) {
+
+			if ( ! strcmp( argv[1], table_list[a].option ) ) {
+
+				for (b=a+1; table_list[b].option != NULL  &&  ! strcmp( argv[1], table_list[b].option ); b++);
+
+				retval = generate_table( & table_list[a], b-a, argv[2] );
+				break;
+			}
+		}
+
+		if ( retval < 0 ) {
 
-		exit( 1 );
+			fprintf( stderr, "\nprecalc: Unknown table type \"%s\" passed\n\n", argv[1] );
+			retval = 3;
+		}
 	}
 
-	retval = generate_table( argv[1], argv[2] );
+	if ( retval < 0 ) {
+
+		fprintf( stderr, "\nusage: precalc --type file\n" );
+		fprintf( stderr, "       where --type is any of --crc8, --crc16, --crc32, --crc32c, --crc64,\n" );
+		fprintf( stderr, "       --ccitt, --dnp, --kermit, --sick or --powers\n\n" );
+		fprintf( stderr, "   or: precalc --model name width poly normal|reflected [options] file\n" );
+		fprintf( stderr, "       where options are any of --slices=N, --nibble, --fold, --powers\n" );
+		fprintf( stderr, "       and --extern\n\n" );
+
+		retval = 1;
+	}
 
 	exit( retval );
 
 }  /* main (libcrc precalc) */
 
 /*
- * static int generate_table( const char *typename, const char *filename );
+ * static int parse_model( struct table_tp *tab, int argc, char *argv[] );
  *
- * The function generate_table() generates a CRC lookup table of a specified
- * type and stores the generated output in a file. If the function succeeds the
- * value 0 is returned. Another value is an indication of failure and that
- * value is used as the exit value of the program.
+ * The function parse_model() fills a table description from the command line
+ * arguments of the --model option. The arguments are the name of the table,
+ * the width of the CRC in bits, the polynomial in normal notation, the bit
+ * order and optional flags, followed by the name of the output file. The
+ * function returns 0 on success or an exit value for the program on failure.
  */
 
-static int generate_table( const char *typename, const char *filename ) {
+static int parse_model( struct table_tp *tab, int argc, char *argv[] ) {
 
 	int a;
-	int type;
-	int bits;
-	FILE *fp;
-	const char *tabname;
+	long width;
+	char *endptr;
+	uint64_t mask;
 
-	if ( typename == NULL  ||  filename == NULL ) {
+	tab->option     = argv[1];
+	tab->tabname    = argv[2];
+	tab->is_static  = true;
+	tab->width      = 0;
+	tab->poly       = 0;
+	tab->reflected  = false;
+	tab->num_slices = 1;
+	tab->nibble     = false;
+	tab->fold       = FOLD_NONE;
+	tab->powers     = false;
+	tab->shift32    = false;
 
-		fprintf( stderr, "\nprecalc: Internal pointer error\n\n" );
-		return 2;
+	width = strtol( argv[3], &endptr, 0 );
+	if ( *endptr != '\0'  ||  width < 1  ||  width > 64 ) {
+
+		fprintf( stderr, "\nprecalc: Invalid width \"%s\", must be between 1 and 64\n\n", argv[3] );
+		return 3;
 	}
+	tab->width = (int) width;
+
+	mask      = ( width >= 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << width ) - 1;
+	tab->poly = strtoull( argv[4], &endptr, 0 );
+	if ( *endptr != '\0'  ||  ( tab->poly & ~mask ) != 0  ||  ( tab->poly & 1 ) == 0 ) {
 
-	if      ( ! strcmp( typename, "--crc64" ) ) type = TYPE_CRC64;
-	else if ( ! strcmp( typename, "--crc32" ) ) type = TYPE_CRC32;
+		fprintf( stderr, "\nprecalc: Invalid polynomial \"%s\" for a width of %ld bits\n\n", argv[4], width );
+		return 3;
+	}
+
+	if      ( ! strcmp( argv[5], "normal"    ) ) tab->reflected = false;
+	else if ( ! strcmp( argv[5], "reflected" ) ) tab->reflected = true;
 	else {
 
-		fprintf( stderr, "\nprecalc: Unknown table type \"%s\" passed\n\n", typename );
+		fprintf( stderr, "\nprecalc: Invalid bit order \"%s\", must be normal or reflected\n\n", argv[5] );
 		return 3;
 	}
 
-	tabname = NULL;
-	bits    = 1;
+	for (a=6; a<argc-1; a++) {
+
+		if      ( ! strcmp(  argv[a], "--nibble"     ) ) tab->nibble    = true;
+		else if ( ! strcmp(  argv[a], "--fold"       ) ) tab->fold      = FOLD_64;
+		else if ( ! strcmp(  argv[a], "--powers"     ) ) tab->powers    = true;
+		else if ( ! strcmp(  argv[a], "--extern"     ) ) tab->is_static = false;
+		else if ( ! strncmp( argv[a], "--slices=", 9 ) ) {
+
+			tab->num_slices = (int) strtol( argv[a]+9, &endptr, 10 );
+			if ( *endptr != '\0'  ||  tab->num_slices < 1  ||  tab->num_slices > MAX_SLICES ) {
+
+				fprintf( stderr, "\nprecalc: Invalid number of slices \"%s\", must be between 1 and %d\n\n", argv[a]+9, MAX_SLICES );
+				return 3;
+			}
+		}
 
-	switch ( type ) {
+		else {
 
-		case TYPE_CRC32 : init_crc32_tab(); tabname = "crc_tab32"; bits = 32; break;
-		case TYPE_CRC64 : init_crc64_tab(); tabname = "crc_tab64"; bits = 64; break;
+			fprintf( stderr, "\nprecalc: Unknown option \"%s\" passed\n\n", argv[a] );
+			return 3;
+		}
 	}
 
+	return 0;
+
+}  /* parse_model */
+
+/*
+ * static FILE *open_output( const char *filename );
+ *
+ * The function open_output() creates an include file and writes the standard
+ * header to it. The function returns NULL if the file cannot be created.
+ */
+
+static FILE *open_output( const char *filename ) {
+
+	FILE *fp;
+
 #if defined(_MSC_VER)
 	fp = NULL;
 	fopen_s( &fp, filename, "w" );
@@ -133,7 +344,7 @@ static int generate_table( const char *typename, const char *filename ) {
 	if ( fp == NULL ) {
 
 		fprintf( stderr, "\nprecalc: cannot open \"%s\" for writing\n\n", filename );
-		return 0;
+		return NULL;
 	}
 
 	fprintf( fp, "/*\n" );
@@ -147,25 +358,682 @@ static int generate_table( const char *typename, const char *filename ) {
 	fprintf( fp, " * library is recompiled. All manually added changes will be lost in that case.\n" );
 	fprintf( fp, " */\n\n" );
 
-	fprintf( fp, "const uint%d_t %s[256] = {\n", bits, tabname );
+	return fp;
 
-	for (a=0; a<256; a++) {
+}  /* open_output */
+
+/*
+ * static int generate_powers( const char *filename );
+ *
+ * The function generate_powers() generates the include file with the power
+ * tables of all CRC algorithms in the library which are used by the combine
+ * routines. If the function succeeds the value 0 is returned.
+ */
 
-		switch ( bits ) {
+static int generate_powers( const char *filename ) {
 
-			case  8 : fprintf( fp, "\t0x%02"  PRIX8  "\x75",   (uint8_t)  (crc_tab_precalc[a] & 0x00000000000000FFull) ); break;
-			case 16 : fprintf( fp, "\t0x%04"  PRIX16 "\x75",   (uint16_t) (crc_tab_precalc[a] & 0x000000000000FFFFull) ); break;
-			case 32 : fprintf( fp, "\t0x%08"  PRIX32 "\x75l",  (uint32_t) (crc_tab_precalc[a] & 0x00000000FFFFFFFFull) ); break;
-			case 64 : fprintf( fp, "\t0x%016" PRIX64 "\x75ll",             crc_tab_precalc[a]                          ); break;
+	int a;
+	FILE *fp;
+
+	fp = open_output( filename );
+	if ( fp == NULL ) return 0;
+
+	for (a=0; power_list[a].tabname != NULL; a++) {
+
+		print_powers( fp, power_list[a].tabname, power_list[a].poly, power_list[a].width, power_list[a].reflected, power_list[a].unit_bits );
+	}
+
+	fclose( fp );
+
+	return 0;
+
+}  /* generate_powers */
+
+/*
+ * static int generate_table( const struct table_tp *tab, int num_tables, const char *filename );
+ *
+ * The function generate_table() generates the lookup tables and constants of
+ * one or more CRC algorithms and stores the generated output in a file. All
+ * tables are verified against a bit by bit calculation before the file is
+ * created. If the function succeeds the value 0 is returned. Another value is
+ * an indication of failure and that value is used as the exit value of the
+ * program.
+ */
+
+static int generate_table( const struct table_tp *tab, int num_tables, const char *filename ) {
+
+	int a;
+	FILE *fp;
+
+	if ( tab == NULL  ||  filename == NULL ) {
+
+		fprintf( stderr, "\nprecalc: Internal pointer error\n\n" );
+		return 2;
+	}
+
+	for (a=0; a<num_tables; a++) {
+
+		if ( tab[a].tabname == NULL ) {
+
+			fprintf( stderr, "\nprecalc: Internal pointer error\n\n" );
+			return 2;
+		}
+
+		if ( ! prepare_table( & tab[a] ) ) {
+
+			fprintf( stderr, "\nprecalc: Verification of the tables of \"%s\" failed\n\n", tab[a].tabname );
+			return 4;
 		}
-		if ( a < 255 ) fprintf( fp, ",\n" );
-		else           fprintf( fp, "\n" );
 	}
 
-	fprintf( fp, "};\n\n" );
+	fp = open_output( filename );
+	if ( fp == NULL ) return 0;
+
+	for (a=0; a<num_tables; a++) {
+
+		prepare_table( & tab[a] );
+		print_tables( fp, & tab[a] );
+	}
+
+	/*
+	 * Constants which are only used by the SIMD routines are enclosed in a
+	 * conditional block to prevent unused variable warnings on other
+	 * platforms.
+	 */
+
+	fprintf( fp, "#if defined(LIBCRC_X86_SIMD)\n\n" );
+
+	for (a=0; a<num_tables; a++) print_simd( fp, & tab[a] );
+
+	fprintf( fp, "#endif\n\n" );
 
 	fclose( fp );
 
 	return 0;
 
 }  /* generate_table */
+
+/*
+ * static bool prepare_table( const struct table_tp *tab );
+ *
+ * The function prepare_table() calculates the lookup table and the slicing
+ * tables of one CRC algorithm in the internal tables and verifies them. The
+ * function returns false if the verification fails.
+ */
+
+static bool prepare_table( const struct table_tp *tab ) {
+
+	int bits;
+
+	bits = register_bits( tab->width );
+
+	init_crc_tab( tab->width, tab->poly, tab->reflected, bits );
+	generate_slices( tab->num_slices, bits, tab->reflected );
+
+	return verify_tables( tab, bits );
+
+}  /* prepare_table */
+
+/*
+ * static void print_tables( FILE *fp, const struct table_tp *tab );
+ *
+ * The function print_tables() writes the lookup tables, the nibble tables and
+ * the power table of one CRC algorithm to an include file. The lookup tables
+ * must have been calculated with prepare_table() first.
+ */
+
+static void print_tables( FILE *fp, const struct table_tp *tab ) {
+
+	int a;
+	int bits;
+	char name[256];
+
+	bits = register_bits( tab->width );
+
+	fprintf( fp, "%sconst uint%d_t %s[256] = {\n", ( tab->is_static ) ? "static " : "", bits, tab->tabname );
+	print_table( fp, crc_tab_slice[0], bits );
+	fprintf( fp, "};\n\n" );
+
+	if ( tab->num_slices > 1 ) {
+
+		fprintf( fp, "%sconst uint%d_t %s_slice[%d][256] = {\n", ( tab->is_static ) ? "static " : "", bits, tab->tabname, tab->num_slices );
+
+		for (a=0; a<tab->num_slices; a++) {
+
+			fprintf( fp, "{\n" );
+			print_table( fp, crc_tab_slice[a], bits );
+			if ( a < tab->num_slices-1 ) fprintf( fp, "},\n" );
+			else                         fprintf( fp, "}\n" );
+		}
+
+		fprintf( fp, "};\n\n" );
+	}
+
+	if ( tab->nibble ) print_nibble( fp, tab->tabname, tab->width, tab->poly, tab->reflected, bits );
+
+	if ( tab->powers ) {
+
+		snprintf( name, sizeof(name), "%s_pow", tab->tabname );
+		print_powers( fp, name, tab->poly, tab->width, tab->reflected, 8 );
+	}
+
+}  /* print_tables */
+
+/*
+ * static void print_simd( FILE *fp, const struct table_tp *tab );
+ *
+ * The function print_simd() writes the constants of one CRC algorithm which
+ * are only used by the SIMD routines to an include file. The caller encloses
+ * the output in a conditional block.
+ */
+
+static void print_simd( FILE *fp, const struct table_tp *tab ) {
+
+	if ( tab->fold == FOLD_32 ) print_fold32( fp, tab->tabname, tab->poly );
+
+	if ( tab->fold == FOLD_64 ) {
+
+		if ( tab->reflected ) print_fold_reflected( fp, tab->tabname, tab->poly, tab->width );
+		else                  print_fold_normal(    fp, tab->tabname, tab->poly, tab->width );
+	}
+
+	if ( tab->shift32 ) {
+
+		print_shift32( fp, tab->tabname, "long",  "CRC32C_LONG",  CRC32C_LONG  );
+		print_shift32( fp, tab->tabname, "short", "CRC32C_SHORT", CRC32C_SHORT );
+	}
+
+}  /* print_simd */
+
+/*
+ * static int register_bits( int width );
+ *
+ * The function register_bits() returns the number of bits of the smallest
+ * unsigned integer type which can hold a CRC of the given width.
+ */
+
+static int register_bits( int width ) {
+
+	if ( width <=  8 ) return  8;
+	if ( width <= 16 ) return 16;
+	if ( width <= 32 ) return 32;
+
+	return 64;
+
+}  /* register_bits */
+
+/*
+ * static bool verify_tables( const struct table_tp *tab, int bits );
+ *
+ * The function verify_tables() compares every entry of the generated slicing
+ * tables with the CRC of the byte value followed by the same number of zero
+ * bytes as the slice number, calculated bit by bit with update_crc_bits().
+ * The power table is checked against the powers x^(8*2^k) mod P calculated
+ * directly for the first entries. The function returns false if a difference
+ * is found.
+ */
+
+static bool verify_tables( const struct table_tp *tab, int bits ) {
+
+	int a;
+	int b;
+	uint64_t expect;
+	uint64_t power;
+	unsigned char buffer[MAX_SLICES];
+
+	memset( buffer, 0, sizeof(buffer) );
+
+	for (a=0; a<tab->num_slices; a++) {
+
+		for (b=0; b<256; b++) {
+
+			buffer[0] = (unsigned char) b;
+
+			expect = update_crc_bits( 0, buffer, (size_t) (a+1), tab->width, tab->poly, tab->reflected );
+			if ( ! tab->reflected ) expect <<= bits - tab->width;
+
+			if ( crc_tab_slice[a][b] != expect ) return false;
+		}
+	}
+
+	if ( tab->powers ) {
+
+		power = xpow_mod( 8, tab->poly, tab->width );
+
+		for (a=0; a<16; a++) {
+
+			if ( power != xpow_mod( 8ull << a, tab->poly, tab->width ) ) return false;
+
+			power = mul_mod( power, power, tab->poly, tab->width );
+		}
+	}
+
+	return true;
+
+}  /* verify_tables */
+
+/*
+ * static void generate_slices( int num_slices, int bits, bool reflected );
+ *
+ * The function generate_slices() derives the lookup tables for the slicing-by-N
+ * CRC routines from the byte wise lookup table in crc_tab_precalc[]. Entry i
+ * of slice k contains the CRC contribution of byte value i followed by k zero
+ * bytes. This allows the CRC routines to process N bytes with N independent
+ * table lookups per iteration.
+ */
+
+static void generate_slices( int num_slices, int bits, bool reflected ) {
+
+	int a;
+	int b;
+	uint64_t mask;
+	uint64_t prev;
+
+	mask = ( bits >= 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << bits ) - 1;
+
+	for (b=0; b<256; b++) crc_tab_slice[0][b] = crc_tab_precalc[b] & mask;
+
+	for (a=1; a<num_slices  &&  a<MAX_SLICES; a++) {
+
+		for (b=0; b<256; b++) {
+
+			prev = crc_tab_slice[a-1][b];
+
+			if ( reflected ) crc_tab_slice[a][b] = (   prev >> 8           ) ^ crc_tab_slice[0][  prev                 & 0xFF ];
+			else             crc_tab_slice[a][b] = ( ( prev << 8 ) & mask  ) ^ crc_tab_slice[0][ (prev >> (bits - 8)) & 0xFF ];
+		}
+	}
+
+}  /* generate_slices */
+
+/*
+ * static void print_table( FILE *fp, const uint64_t *table, int bits );
+ *
+ * The function print_table() writes the 256 entries of a lookup table to an
+ * include file with the C syntax of constants with the specified bit width.
+ */
+
+static void print_table( FILE *fp, const uint64_t *table, int bits ) {
+
+	int a;
+
+	for (a=0; a<256; a++) {
+
+		print_value( fp, table[a], bits );
+		if ( a < 255 ) fprintf( fp, ",\n" );
+		else           fprintf( fp, "\n" );
+	}
+
+}  /* print_table */
+
+/*
+ * static void print_value( FILE *fp, uint64_t value, int bits );
+ *
+ * The function print_value() writes one table entry to an include file with
+ * the C syntax of a constant with the specified bit width.
+ */
+
+static void print_value( FILE *fp, uint64_t value, int bits ) {
+
+	switch ( bits ) {
+
+		case  8 : fprintf( fp, "\t0x%02"  PRIX8  "\x75",   (uint8_t)  (value & 0x00000000000000FFull) ); break;
+		case 16 : fprintf( fp, "\t0x%04"  PRIX16 "\x75",   (uint16_t) (value & 0x000000000000FFFFull) ); break;
+		case 32 : fprintf( fp, "\t0x%08"  PRIX32 "\x75l",  (uint32_t) (value & 0x00000000FFFFFFFFull) ); break;
+		case 64 : fprintf( fp, "\t0x%016" PRIX64 "\x75ll",             value                          ); break;
+	}
+
+}  /* print_value */
+
+/*
+ * static void print_fold32( FILE *fp, const char *tabname, uint64_t poly );
+ *
+ * The function print_fold32() writes the constants for the carry-less
+ * multiplication folding routine of a reflected 32 bit CRC to the include
+ * file. The polynomial is passed in normal notation without the leading x^32
+ * term. The fold constants are the bit reflected values of x^n mod P shifted
+ * left by one bit to compensate for the reflected multiplication. The last
+ * pair contains the polynomial and the Barrett constant floor(x^64 / P), both
+ * as reflected 33 bit values.
+ */
+
+static void print_fold32( FILE *fp, const char *tabname, uint64_t poly ) {
+
+	int a;
+	uint64_t fold[8];
+
+	fold[0] = reflect_bits( xpow_mod( 4*128+32, poly, 32 ), 32 ) << 1;
+	fold[1] = reflect_bits( xpow_mod( 4*128-32, poly, 32 ), 32 ) << 1;
+	fold[2] = reflect_bits( xpow_mod(   128+32, poly, 32 ), 32 ) << 1;
+	fold[3] = reflect_bits( xpow_mod(   128-32, poly, 32 ), 32 ) << 1;
+	fold[4] = reflect_bits( xpow_mod(       64, poly, 32 ), 32 ) << 1;
+	fold[5] = 0;
+	fold[6] = reflect_bits( poly | 0x100000000ull, 33 );
+	fold[7] = reflect_bits( xpow_div( 64, poly, 32 ) | 0x100000000ull, 33 );
+
+	fprintf( fp, "static const uint64_t %s_fold[8] = {\n", tabname );
+
+	for (a=0; a<8; a++) {
+
+		fprintf( fp, "\t0x%016" PRIX64 "ull", fold[a] );
+		if ( a < 7 ) fprintf( fp, ",\n" );
+		else         fprintf( fp, "\n" );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* print_fold32 */
+
+/*
+ * static void print_fold_normal( FILE *fp, const char *tabname, uint64_t poly, int bits );
+ *
+ * The function print_fold_normal() writes the constants for the carry-less
+ * multiplication folding routine libcrc_fold_normal() of a CRC which is
+ * calculated with the most significant bit first. The routine always works
+ * with a 64 bit CRC register. A CRC with less bits is calculated with the
+ * polynomial multiplied by x^(64-bits), which leaves the CRC in the upper bits
+ * of the register. The constants are the fold multipliers x^512, x^576, x^128
+ * and x^192 modulo that polynomial, followed by the Barrett constant
+ * floor(x^128 / P) and the polynomial itself, both without the x^64 term.
+ */
+
+static void print_fold_normal( FILE *fp, const char *tabname, uint64_t poly, int bits ) {
+
+	int a;
+	uint64_t fold[6];
+
+	poly <<= 64 - bits;
+
+	fold[0] = xpow_mod( 512, poly, 64 );
+	fold[1] = xpow_mod( 576, poly, 64 );
+	fold[2] = xpow_mod( 128, poly, 64 );
+	fold[3] = xpow_mod( 192, poly, 64 );
+	fold[4] = xpow_div( 128, poly, 64 );
+	fold[5] = poly;
+
+	fprintf( fp, "static const uint64_t %s_fold[6] = {\n", tabname );
+
+	for (a=0; a<6; a++) {
+
+		fprintf( fp, "\t0x%016" PRIX64 "ull", fold[a] );
+		if ( a < 5 ) fprintf( fp, ",\n" );
+		else         fprintf( fp, "\n" );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* print_fold_normal */
+
+/*
+ * static void print_fold_reflected( FILE *fp, const char *tabname, uint64_t poly, int bits );
+ *
+ * The function print_fold_reflected() writes the constants for the carry-less
+ * multiplication folding routine libcrc_fold_reflected() of a CRC which is
+ * calculated with the least significant bit first. The polynomial is passed
+ * in normal notation and scaled to 64 bits in the same way as for the routine
+ * with the most significant bit first. A reflected carry-less multiplication
+ * returns the product multiplied by x, which is compensated by using the fold
+ * multipliers x^575, x^511, x^191 and x^127 instead of x^576, x^512, x^192 and
+ * x^128. All constants are stored bit reflected.
+ */
+
+static void print_fold_reflected( FILE *fp, const char *tabname, uint64_t poly, int bits ) {
+
+	int a;
+	uint64_t fold[6];
+
+	poly <<= 64 - bits;
+
+	fold[0] = reflect_bits( xpow_mod( 575, poly, 64 ), 64 );
+	fold[1] = reflect_bits( xpow_mod( 511, poly, 64 ), 64 );
+	fold[2] = reflect_bits( xpow_mod( 191, poly, 64 ), 64 );
+	fold[3] = reflect_bits( xpow_mod( 127, poly, 64 ), 64 );
+	fold[4] = reflect_bits( xpow_div( 128, poly, 64 ), 64 );
+	fold[5] = reflect_bits( poly,                      64 );
+
+	fprintf( fp, "static const uint64_t %s_fold[6] = {\n", tabname );
+
+	for (a=0; a<6; a++) {
+
+		fprintf( fp, "\t0x%016" PRIX64 "ull", fold[a] );
+		if ( a < 5 ) fprintf( fp, ",\n" );
+		else         fprintf( fp, "\n" );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* print_fold_reflected */
+
+/*
+ * static void print_nibble( FILE *fp, const char *tabname, int width, uint64_t poly, bool reflected, int bits );
+ *
+ * The function print_nibble() writes a lookup table with 16 entries to the
+ * include file which processes four bits per lookup. The table is used where
+ * the size of the table matters more than the speed, or with SIMD shuffle
+ * instructions which can do 16 lookups in parallel. The entries are a subset
+ * of the byte wise lookup table and use the same register layout.
+ */
+
+static void print_nibble( FILE *fp, const char *tabname, int width, uint64_t poly, bool reflected, int bits ) {
+
+	int a;
+	int b;
+	uint64_t crc;
+	uint64_t top;
+	uint64_t mask;
+	uint64_t table[16];
+
+	mask = ( bits >= 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << bits ) - 1;
+	top  = 1ull << (bits - 1);
+
+	if ( reflected ) poly = reflect_bits( poly, width );
+	else             poly = poly << (bits - width);
+
+	for (a=0; a<16; a++) {
+
+		if ( reflected ) crc = (uint64_t) a;
+		else             crc = (uint64_t) a << (bits - 4);
+
+		for (b=0; b<4; b++) {
+
+			if ( reflected ) crc = ( crc & 1   ) ? ( crc >> 1 ) ^ poly : crc >> 1;
+			else             crc = ( crc & top ) ? ( ( crc << 1 ) & mask ) ^ poly : ( crc << 1 ) & mask;
+		}
+
+		table[a] = crc;
+	}
+
+	fprintf( fp, "static const uint%d_t %s_nibble[16] = {\n", bits, tabname );
+
+	for (a=0; a<16; a++) {
+
+		print_value( fp, table[a], bits );
+		if ( a < 15 ) fprintf( fp, ",\n" );
+		else          fprintf( fp, "\n" );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* print_nibble */
+
+/*
+ * static void print_powers( FILE *fp, const char *tabname, uint64_t poly, int bits, bool reflected, int unit_bits );
+ *
+ * The function print_powers() writes a table with the values x^(unit_bits *
+ * 2^k) mod P for k = 0..63 to the include file. With these values a CRC can be
+ * advanced over any number of input units in logarithmic time. For normal CRC
+ * algorithms a unit is one byte of eight bits. The polynomial is passed in
+ * normal notation without the leading x^bits term. For reflected CRCs the
+ * values are written in reflected notation.
+ */
+
+static void print_powers( FILE *fp, const char *tabname, uint64_t poly, int bits, bool reflected, int unit_bits ) {
+
+	int a;
+	uint64_t power;
+
+	power = xpow_mod( (uint64_t) unit_bits, poly, bits );
+
+	fprintf( fp, "static const uint64_t %s[64] = {\n", tabname );
+
+	for (a=0; a<64; a++) {
+
+		if ( reflected ) fprintf( fp, "\t0x%016" PRIX64 "ull", reflect_bits( power, bits ) );
+		else             fprintf( fp, "\t0x%016" PRIX64 "ull",          power          );
+
+		if ( a < 63 ) fprintf( fp, ",\n" );
+		else          fprintf( fp, "\n" );
+
+		power = mul_mod( power, power, poly, bits );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* print_powers */
+
+/*
+ * static void print_shift32( FILE *fp, const char *tabname, const char *suffix, const char *lenname, uint64_t num_bytes );
+ *
+ * The function print_shift32() writes four lookup tables to the include file
+ * which advance a reflected 32 bit CRC value over a fixed number of zero
+ * bytes. Each table handles one byte of the CRC value. The CRC routines use
+ * these tables to combine CRC values which were calculated in parallel over
+ * adjacent blocks of the same size. The size of the blocks is written to the
+ * include file as the constant lenname together with the tables.
+ */
+
+static void print_shift32( FILE *fp, const char *tabname, const char *suffix, const char *lenname, uint64_t num_bytes ) {
+
+	int a;
+	int b;
+	uint64_t c;
+	uint64_t crc;
+	uint64_t table[256];
+
+	fprintf( fp, "#define %s\t%" PRIu64 "\n\n", lenname, num_bytes );
+	fprintf( fp, "static const uint32_t %s_%s[4][256] = {\n", tabname, suffix );
+
+	for (a=0; a<4; a++) {
+
+		for (b=0; b<256; b++) {
+
+			crc = ( (uint64_t) b ) << ( 8 * a );
+
+			for (c=0; c<num_bytes; c++) crc = ( crc >> 8 ) ^ crc_tab_slice[0][ crc & 0xFF ];
+
+			table[b] = crc;
+		}
+
+		fprintf( fp, "{\n" );
+		print_table( fp, table, 32 );
+		if ( a < 3 ) fprintf( fp, "},\n" );
+		else         fprintf( fp, "}\n" );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* print_shift32 */
+
+/*
+ * static uint64_t xpow_mod( uint64_t n, uint64_t poly, int bits );
+ *
+ * The function xpow_mod() calculates the remainder of the polynomial x^n
+ * divided by the CRC polynomial P. The polynomial is passed in normal notation
+ * without the leading x^bits term which is implied.
+ */
+
+static uint64_t xpow_mod( uint64_t n, uint64_t poly, int bits ) {
+
+	uint64_t a;
+	uint64_t top;
+	uint64_t mask;
+	uint64_t rem;
+
+	mask = ( bits >= 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << bits ) - 1;
+	top  = 1ull << (bits - 1);
+	rem  = 1;
+
+	for (a=0; a<n; a++) {
+
+		if ( rem & top ) rem = ( ( rem << 1 ) & mask ) ^ poly;
+		else             rem =   ( rem << 1 ) & mask;
+	}
+
+	return rem;
+
+}  /* xpow_mod */
+
+/*
+ * static uint64_t xpow_div( uint64_t n, uint64_t poly, int bits );
+ *
+ * The function xpow_div() calculates the quotient of the polynomial x^n
+ * divided by the CRC polynomial P with the same notation as xpow_mod(). Only
+ * the lower 64 bits of the quotient are returned. For the Barrett constants
+ * with n equal to twice the width of the CRC this means that the leading
+ * term x^bits of the quotient is implied for 64 bit CRCs.
+ */
+
+static uint64_t xpow_div( uint64_t n, uint64_t poly, int bits ) {
+
+	uint64_t a;
+	uint64_t top;
+	uint64_t mask;
+	uint64_t rem;
+	uint64_t quot;
+
+	mask = ( bits >= 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << bits ) - 1;
+	top  = 1ull << (bits - 1);
+	rem  = 0;
+	quot = 0;
+
+	for (a=0; a<=n; a++) {
+
+		quot <<= 1;
+
+		if ( rem & top ) {
+
+			rem   = ( ( rem << 1 ) & mask ) ^ poly;
+			quot |= 1;
+		}
+
+		else rem = ( rem << 1 ) & mask;
+
+		if ( a == 0 ) rem ^= 1;
+	}
+
+	return quot;
+
+}  /* xpow_div */
+
+/*
+ * static uint64_t mul_mod( uint64_t a, uint64_t b, uint64_t poly, int bits );
+ *
+ * The function mul_mod() multiplies two polynomials modulo the CRC polynomial
+ * P. All values are in normal notation and the leading x^bits term of the
+ * polynomial is implied.
+ */
+
+static uint64_t mul_mod( uint64_t a, uint64_t b, uint64_t poly, int bits ) {
+
+	int i;
+	uint64_t top;
+	uint64_t mask;
+	uint64_t prod;
+
+	mask = ( bits >= 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << bits ) - 1;
+	top  = 1ull << (bits - 1);
+	prod = 0;
+
+	for (i=0; i<bits; i++) {
+
+		if ( a & 1 ) prod ^= b;
+
+		if ( b & top ) b = ( ( b << 1 ) & mask ) ^ poly;
+		else           b =   ( b << 1 ) & mask;
+
+		a >>= 1;
+	}
+
+	return prod;
+
+}  /* mul_mod */
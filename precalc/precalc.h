@@ -33,15 +33,17 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /*
  * Global functions used in the precalc program
  */
 
-void			init_crc32_tab( void );
-void			init_crc64_tab( void );
+void			init_crc_tab( int width, uint64_t poly, bool reflected, int bits );
 int			main( int argc, char *argv[] );
+uint64_t		reflect_bits( uint64_t value, int bits );
+uint64_t		update_crc_bits( uint64_t crc, const unsigned char *input_str, size_t num_bytes, int width, uint64_t poly, bool reflected );
 
 /*
  * Global variables used in the precalc program
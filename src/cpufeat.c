@@ -1,6 +1,6 @@
 /*
  * Library: libcrc
- * File:    precalc/crc64_table.c
+ * File:    src/cpufeat.c
  * Author:  Lammert Bies
  *
  * This file is licensed under the MIT License as stated below
@@ -27,45 +27,51 @@
  *
  * Description
  * -----------
- * The source file precalc/crc64_table.c contains the routines which are needed
- * to generate the lookup table for 64 bit CRC calculations.
+ * The source file src/cpufeat.c contains the routine which detects the
+ * instruction set extensions of the CPU the library is running on. The result
+ * is used at startup to select the fastest implementation of the CRC
+ * routines.
  */
 
-#include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
-#include "precalc.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_SIMD)
+#include <cpuid.h>
+#endif
 
 /*
- * void init_crc64_tab( void );
+ * unsigned int libcrc_cpu_features( void );
  *
- * For optimal speed, the CRC64 calculation uses a table with pre-calculated
- * bit patterns which are used in the XOR operations in the program. This table
- * is generated during compilation of the library and added to the library as a
- * table with constant values.
+ * The function libcrc_cpu_features() returns a set of LIBCRC_CPU_xxxx flags
+ * for the instruction set extensions which are supported by the current CPU.
+ * On platforms without SIMD support in the library the value 0 is returned
+ * and all CRC routines use the portable table driven implementations.
  */
 
-void init_crc64_tab( void ) {
-
-	uint64_t i;
-	uint64_t j;
-	uint64_t c;
-	uint64_t crc;
-
-	for (i=0; i<256; i++) {
+unsigned int libcrc_cpu_features( void ) {
 
-		crc = 0;
-		c   = i << 56;
+	unsigned int retval;
+#if defined(LIBCRC_X86_SIMD)
+	unsigned int eax;
+	unsigned int ebx;
+	unsigned int ecx;
+	unsigned int edx;
+#endif
 
-		for (j=0; j<8; j++) {
+	retval = 0;
 
-			if ( ( crc ^ c ) & 0x8000000000000000ull ) crc = ( crc << 1 ) ^ CRC_POLY_64;
-			else                                       crc =   crc << 1;
+#if defined(LIBCRC_X86_SIMD)
+	if ( __get_cpuid( 1, &eax, &ebx, &ecx, &edx ) ) {
 
-			c = c << 1;
-		}
-
-		crc_tab_precalc[i] = crc;
+		if ( ecx & bit_SSSE3  ) retval |= LIBCRC_CPU_SSSE3;
+		if ( ecx & bit_SSE4_1 ) retval |= LIBCRC_CPU_SSE41;
+		if ( ecx & bit_SSE4_2 ) retval |= LIBCRC_CPU_SSE42;
+		if ( ecx & bit_PCLMUL ) retval |= LIBCRC_CPU_PCLMUL;
 	}
+#endif
+
+	return retval;
 
-}  /* init_crc64_tab */
+}  /* libcrc_cpu_features */
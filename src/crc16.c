@@ -31,14 +31,32 @@
  * CRC16 cyclic redundancy check values for an incomming byte string.
  */
 
-#include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
 
-static void             init_crc16_tab( void );
+static uint16_t		crc16_table(  uint16_t crc, const unsigned char *ptr, size_t num_bytes );
 
-static bool             crc_tab16_init          = false;
-static uint16_t         crc_tab16[256];
+#if defined(LIBCRC_X86_SIMD)
+static uint16_t		crc16_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crc16_select( void );
+#endif
+
+/*
+ * Include the lookup table for the CRC-16 and Modbus CRC calculation
+ */
+
+#include "../tab/gentab16.inc"
+
+/*
+ * static uint16_t (*crc16_block)( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function pointer crc16_block points to the fastest routine available on
+ * the current CPU to update a CRC-16 value with a block of bytes. It is changed
+ * only once at program startup by crc16_select().
+ */
+
+static uint16_t		(*crc16_block)( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) = crc16_table;
 
 /*
  * uint16_t crc_16( const unsigned char *input_str, size_t num_bytes );
@@ -51,21 +69,7 @@ static uint16_t         crc_tab16[256];
 
 uint16_t crc_16( const unsigned char *input_str, size_t num_bytes ) {
 
-	uint16_t crc;
-	const unsigned char *ptr;
-	size_t a;
-
-	if ( ! crc_tab16_init ) init_crc16_tab();
-
-	crc = CRC_START_16;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
-
-	return crc;
+	return update_crc_16_block( CRC_START_16, input_str, num_bytes );
 
 }  /* crc_16 */
 
@@ -79,21 +83,7 @@ uint16_t crc_16( const unsigned char *input_str, size_t num_bytes ) {
 
 uint16_t crc_modbus( const unsigned char *input_str, size_t num_bytes ) {
 
-	uint16_t crc;
-	const unsigned char *ptr;
-	size_t a;
-
-	if ( ! crc_tab16_init ) init_crc16_tab();
-
-	crc = CRC_START_MODBUS;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
-
-	return crc;
+	return update_crc_16_block( CRC_START_MODBUS, input_str, num_bytes );
 
 }  /* crc_modbus */
 
@@ -106,44 +96,87 @@ uint16_t crc_modbus( const unsigned char *input_str, size_t num_bytes ) {
 
 uint16_t update_crc_16( uint16_t crc, unsigned char c ) {
 
-	if ( ! crc_tab16_init ) init_crc16_tab();
-
 	return (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) c) & 0x00FF ];
 
 }  /* update_crc_16 */
 
 /*
- * static void init_crc16_tab( void );
+ * uint16_t update_crc_16_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes );
  *
- * For optimal performance uses the CRC16 routine a lookup table with values
- * that can be used directly in the XOR arithmetic in the algorithm. This
- * lookup table is calculated by the init_crc16_tab() routine, the first time
- * the CRC function is called.
+ * The function update_crc_16_block() calculates a new CRC-16 value based on
+ * the previous value of the CRC and a block of data to be checked. The
+ * function is used both for the CRC-16 and the Modbus CRC.
  */
 
-static void init_crc16_tab( void ) {
+uint16_t update_crc_16_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes ) {
 
-	uint16_t i;
-	uint16_t j;
-	uint16_t crc;
-	uint16_t c;
+	if ( input_str == NULL ) return crc;
 
-	for (i=0; i<256; i++) {
+	return crc16_block( crc, input_str, num_bytes );
 
-		crc = 0;
-		c   = i;
+}  /* update_crc_16_block */
 
-		for (j=0; j<8; j++) {
+/*
+ * static uint16_t crc16_table( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc16_table() is the portable routine to update a CRC-16 value
+ * with a block of bytes, one byte per iteration.
+ */
 
-			if ( (crc ^ c) & 0x0001 ) crc = ( crc >> 1 ) ^ CRC_POLY_16;
-			else                      crc =   crc >> 1;
+static uint16_t crc16_table( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-			c = c >> 1;
-		}
+	while ( num_bytes > 0 ) {
 
-		crc_tab16[i] = crc;
+		crc = (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
+		num_bytes--;
 	}
 
-	crc_tab16_init = true;
+	return crc;
+
+}  /* crc16_table */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static void crc16_select( void );
+ *
+ * The function crc16_select() is called once at program startup. It selects the
+ * carry-less multiplication routine if the CPU supports the PCLMULQDQ and
+ * SSE4.1 instructions.
+ */
+
+static LIBCRC_STARTUP void crc16_select( void ) {
+
+	unsigned int features;
+
+	features = libcrc_cpu_features();
+
+	if ( ( features & LIBCRC_CPU_PCLMUL )  &&  ( features & LIBCRC_CPU_SSE41 ) ) crc16_block = crc16_pclmul;
+
+}  /* crc16_select */
+
+/*
+ * static uint16_t crc16_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc16_pclmul() updates a CRC-16 value with the generic folding
+ * routine libcrc_fold_reflected() for CRCs which are calculated with the least
+ * significant bit first. The CRC is passed in the lower 16 bits of the 64 bit
+ * register of the folding routine. Blocks shorter than 64 bytes and the tail of
+ * the block which is not a multiple of 16 bytes are handled by the table driven
+ * routine.
+ */
+
+static uint16_t crc16_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t num_fold;
+
+	if ( num_bytes < 64 ) return crc16_table( crc, ptr, num_bytes );
+
+	num_fold = num_bytes & ~((size_t) 0x0F);
+	crc      = (uint16_t) libcrc_fold_reflected( crc_tab16_fold, crc, ptr, num_fold );
+
+	return crc16_table( crc, ptr + num_fold, num_bytes - num_fold );
+
+}  /* crc16_pclmul */
 
-}  /* init_crc16_tab */
+#endif
@@ -32,15 +32,56 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+static uint32_t		crc32_slice8(  uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint32_t		crc32_slice16( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint32_t		crc32_table(   uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+
+#if defined(LIBCRC_X86_SIMD)
+static uint32_t		crc32_pclmul(  uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crc32_select(  void );
+#endif
+
+/*
+ * static uint32_t (*crc32_block)( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function pointer crc32_block points to the fastest routine available on
+ * the current CPU to update a CRC-32 value with a block of bytes. It is
+ * statically initialized with the portable table driven routine and changed
+ * only once at program startup by crc32_select(). No locking is therefore
+ * necessary when the CRC routines are called from multiple threads.
+ */
+
+static uint32_t		(*crc32_block)( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) = crc32_table;
 
 /*
- * Include the lookup table for the CRC 32 calculation
+ * Include the lookup tables for the CRC 32 calculation. The file contains both
+ * the byte wise table crc_tab32[] and the derived crc_tab32_slice[][] tables
+ * for the slicing-by-8 and slicing-by-16 routines.
  */
 
 #include "../tab/gentab32.inc"
 
+/*
+ * #define LOAD_LE32( ptr )
+ *
+ * The macro LOAD_LE32() reads four bytes as a little endian 32 bit word. The
+ * bytes are read individually so that the code is independent of the
+ * endianness and alignment requirements of the platform. Modern compilers
+ * translate the expression into a single load instruction where possible.
+ */
+
+#define LOAD_LE32(ptr)	(   ( (uint32_t) (ptr)[0]       ) | ( (uint32_t) (ptr)[1] <<  8 )	\
+			  | ( (uint32_t) (ptr)[2] << 16 ) | ( (uint32_t) (ptr)[3] << 24 ) )
+
 /*
  * uint32_t crc_32( const unsigned char *input_str, size_t num_bytes );
  *
@@ -51,19 +92,9 @@
 
 uint32_t crc_32( const unsigned char *input_str, size_t num_bytes ) {
 
-	uint32_t crc;
-	const unsigned char *ptr;
-	size_t a;
-
-	crc = CRC_START_32;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc >> 8) ^ crc_tab32[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
-	}
+	if ( input_str == NULL ) return 0;
 
-	return (crc ^ 0xFFFFFFFFul);
+	return crc32_block( CRC_START_32, input_str, num_bytes ) ^ 0xFFFFFFFFul;
 
 }  /* crc_32 */
 
@@ -79,3 +110,305 @@ uint32_t update_crc_32( uint32_t crc, unsigned char c ) {
 	return (crc >> 8) ^ crc_tab32[ (crc ^ (uint32_t) c) & 0x000000FFul ];
 
 }  /* update_crc_32 */
+
+/*
+ * uint32_t update_crc_32_block( uint32_t crc, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function update_crc_32_block() calculates a new CRC-32 value based on
+ * the previous value of the CRC and a block of data to be checked. It uses the
+ * same fast routines as crc_32().
+ */
+
+uint32_t update_crc_32_block( uint32_t crc, const unsigned char *input_str, size_t num_bytes ) {
+
+	if ( input_str == NULL ) return crc;
+
+	return crc32_block( crc, input_str, num_bytes );
+
+}  /* update_crc_32_block */
+
+/*
+ * static uint32_t crc32_table( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc32_table() updates a CRC-32 value with a block of bytes
+ * using the lookup tables. Bytes are processed one at a time until the input
+ * pointer is aligned to a 64 bit boundary. The aligned body of the block is
+ * handled by the slicing-by-16 and slicing-by-8 routines and the remaining
+ * tail is again processed byte by byte.
+ */
+
+static uint32_t crc32_table( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t num_blocks;
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (crc >> 8) ^ crc_tab32[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	num_blocks = num_bytes & ~((size_t) 0x0F);
+
+	if ( num_blocks > 0 ) {
+
+		crc        = crc32_slice16( crc, ptr, num_blocks );
+		ptr       += num_blocks;
+		num_bytes -= num_blocks;
+	}
+
+	if ( num_bytes >= 8 ) {
+
+		crc        = crc32_slice8( crc, ptr, 8 );
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc >> 8) ^ crc_tab32[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc32_table */
+
+/*
+ * static uint32_t crc32_slice8( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc32_slice8() updates a CRC-32 value with a block of bytes
+ * using the slicing-by-8 algorithm. Eight bytes are processed per iteration
+ * with eight independent table lookups. The number of bytes must be a
+ * multiple of eight.
+ */
+
+static uint32_t crc32_slice8( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	uint32_t one;
+	uint32_t two;
+
+	while ( num_bytes >= 8 ) {
+
+		one  = LOAD_LE32( ptr     ) ^ crc;
+		two  = LOAD_LE32( ptr + 4 );
+
+		crc  = crc_tab32_slice[7][  one        & 0xFF ]
+		     ^ crc_tab32_slice[6][ (one >>  8) & 0xFF ]
+		     ^ crc_tab32_slice[5][ (one >> 16) & 0xFF ]
+		     ^ crc_tab32_slice[4][  one >> 24         ]
+		     ^ crc_tab32_slice[3][  two        & 0xFF ]
+		     ^ crc_tab32_slice[2][ (two >>  8) & 0xFF ]
+		     ^ crc_tab32_slice[1][ (two >> 16) & 0xFF ]
+		     ^ crc_tab32_slice[0][  two >> 24         ];
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	return crc;
+
+}  /* crc32_slice8 */
+
+/*
+ * static uint32_t crc32_slice16( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc32_slice16() updates a CRC-32 value with a block of bytes
+ * using the slicing-by-16 algorithm. Sixteen bytes are processed per iteration
+ * with sixteen independent table lookups. The number of bytes must be a
+ * multiple of sixteen.
+ */
+
+static uint32_t crc32_slice16( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	uint32_t one;
+	uint32_t two;
+	uint32_t three;
+	uint32_t four;
+
+	while ( num_bytes >= 16 ) {
+
+		one   = LOAD_LE32( ptr      ) ^ crc;
+		two   = LOAD_LE32( ptr +  4 );
+		three = LOAD_LE32( ptr +  8 );
+		four  = LOAD_LE32( ptr + 12 );
+
+		crc   = crc_tab32_slice[15][  one          & 0xFF ]
+		      ^ crc_tab32_slice[14][ (one   >>  8) & 0xFF ]
+		      ^ crc_tab32_slice[13][ (one   >> 16) & 0xFF ]
+		      ^ crc_tab32_slice[12][  one   >> 24         ]
+		      ^ crc_tab32_slice[11][  two          & 0xFF ]
+		      ^ crc_tab32_slice[10][ (two   >>  8) & 0xFF ]
+		      ^ crc_tab32_slice[ 9][ (two   >> 16) & 0xFF ]
+		      ^ crc_tab32_slice[ 8][  two   >> 24         ]
+		      ^ crc_tab32_slice[ 7][  three        & 0xFF ]
+		      ^ crc_tab32_slice[ 6][ (three >>  8) & 0xFF ]
+		      ^ crc_tab32_slice[ 5][ (three >> 16) & 0xFF ]
+		      ^ crc_tab32_slice[ 4][  three >> 24         ]
+		      ^ crc_tab32_slice[ 3][  four         & 0xFF ]
+		      ^ crc_tab32_slice[ 2][ (four  >>  8) & 0xFF ]
+		      ^ crc_tab32_slice[ 1][ (four  >> 16) & 0xFF ]
+		      ^ crc_tab32_slice[ 0][  four  >> 24         ];
+
+		ptr       += 16;
+		num_bytes -= 16;
+	}
+
+	return crc;
+
+}  /* crc32_slice16 */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static void crc32_select( void );
+ *
+ * The function crc32_select() is called once at program startup before main()
+ * is entered. It checks the capabilities of the CPU and selects the carry-less
+ * multiplication routine for block CRC-32 calculations if the CPU supports the
+ * PCLMULQDQ and SSE4.1 instructions.
+ */
+
+static LIBCRC_STARTUP void crc32_select( void ) {
+
+	unsigned int features;
+
+	features = libcrc_cpu_features();
+
+	if ( ( features & LIBCRC_CPU_PCLMUL )  &&  ( features & LIBCRC_CPU_SSE41 ) ) crc32_block = crc32_pclmul;
+
+}  /* crc32_select */
+
+/*
+ * static uint32_t crc32_pclmul( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc32_pclmul() updates a CRC-32 value with a block of bytes
+ * with the carry-less multiplication instruction PCLMULQDQ. Four 128 bit
+ * accumulators are folded forward over 64 bytes per iteration. The
+ * accumulators are then folded into one 128 bit value, reduced to 64 bits and
+ * finally reduced to the 32 bit CRC with a Barrett reduction. All constants
+ * are generated by precalc in crc_tab32_fold[]. Blocks shorter than 64 bytes
+ * and the tail of the block which is not a multiple of 16 bytes are handled
+ * by the table driven routine.
+ */
+
+static LIBCRC_TARGET("pclmul,sse4.1") uint32_t crc32_pclmul( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t num_left;
+	__m128i k;
+	__m128i mask;
+	__m128i x1, x2, x3, x4;
+	__m128i x5, x6, x7, x8;
+	__m128i y5, y6, y7, y8;
+
+	if ( num_bytes < 64 ) return crc32_table( crc, ptr, num_bytes );
+
+	num_left   = num_bytes & 0x0F;
+	num_bytes -= num_left;
+
+	x1 = _mm_loadu_si128( (const __m128i *) (ptr +  0) );
+	x2 = _mm_loadu_si128( (const __m128i *) (ptr + 16) );
+	x3 = _mm_loadu_si128( (const __m128i *) (ptr + 32) );
+	x4 = _mm_loadu_si128( (const __m128i *) (ptr + 48) );
+
+	x1 = _mm_xor_si128( x1, _mm_cvtsi32_si128( (int) crc ) );
+	k  = _mm_loadu_si128( (const __m128i *) (crc_tab32_fold + 0) );
+
+	ptr       += 64;
+	num_bytes -= 64;
+
+	/*
+	 * Fold the four accumulators forward over 64 bytes per iteration
+	 */
+
+	while ( num_bytes >= 64 ) {
+
+		x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+		x6 = _mm_clmulepi64_si128( x2, k, 0x00 );
+		x7 = _mm_clmulepi64_si128( x3, k, 0x00 );
+		x8 = _mm_clmulepi64_si128( x4, k, 0x00 );
+
+		x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+		x2 = _mm_clmulepi64_si128( x2, k, 0x11 );
+		x3 = _mm_clmulepi64_si128( x3, k, 0x11 );
+		x4 = _mm_clmulepi64_si128( x4, k, 0x11 );
+
+		y5 = _mm_loadu_si128( (const __m128i *) (ptr +  0) );
+		y6 = _mm_loadu_si128( (const __m128i *) (ptr + 16) );
+		y7 = _mm_loadu_si128( (const __m128i *) (ptr + 32) );
+		y8 = _mm_loadu_si128( (const __m128i *) (ptr + 48) );
+
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x5 ), y5 );
+		x2 = _mm_xor_si128( _mm_xor_si128( x2, x6 ), y6 );
+		x3 = _mm_xor_si128( _mm_xor_si128( x3, x7 ), y7 );
+		x4 = _mm_xor_si128( _mm_xor_si128( x4, x8 ), y8 );
+
+		ptr       += 64;
+		num_bytes -= 64;
+	}
+
+	/*
+	 * Fold the four accumulators into one and continue with single 128 bit
+	 * folds for the remaining 16 byte blocks
+	 */
+
+	k  = _mm_loadu_si128( (const __m128i *) (crc_tab32_fold + 2) );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x5 );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x3 ), x5 );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x4 ), x5 );
+
+	while ( num_bytes >= 16 ) {
+
+		x2 = _mm_loadu_si128( (const __m128i *) ptr );
+
+		x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+		x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x5 );
+
+		ptr       += 16;
+		num_bytes -= 16;
+	}
+
+	/*
+	 * Reduce the 128 bit accumulator to 64 bits
+	 */
+
+	mask = _mm_setr_epi32( -1, 0, -1, 0 );
+
+	x2 = _mm_clmulepi64_si128( x1, k, 0x10 );
+	x1 = _mm_xor_si128( _mm_srli_si128( x1, 8 ), x2 );
+
+	k  = _mm_loadl_epi64( (const __m128i *) (crc_tab32_fold + 4) );
+
+	x2 = _mm_srli_si128( x1, 4 );
+	x1 = _mm_and_si128( x1, mask );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_xor_si128( x1, x2 );
+
+	/*
+	 * Barrett reduction of the remaining 64 bits to the 32 bit CRC
+	 */
+
+	k  = _mm_loadu_si128( (const __m128i *) (crc_tab32_fold + 6) );
+
+	x2 = _mm_and_si128( x1, mask );
+	x2 = _mm_clmulepi64_si128( x2, k, 0x10 );
+	x2 = _mm_and_si128( x2, mask );
+	x2 = _mm_clmulepi64_si128( x2, k, 0x00 );
+	x1 = _mm_xor_si128( x1, x2 );
+
+	crc = (uint32_t) _mm_extract_epi32( x1, 1 );
+
+	return crc32_table( crc, ptr, num_left );
+
+}  /* crc32_pclmul */
+
+#endif
@@ -0,0 +1,304 @@
+/*
+ * Library: libcrc
+ * File:    src/crc32c.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crc32c.c contains the routines which are needed to
+ * calculate the 32 bit CRC-32C value of a sequence of bytes. The CRC-32C uses
+ * the Castagnoli polynomial which is common in storage and network protocols
+ * like iSCSI, SCTP and ext4. Recent x86 processors calculate this CRC in
+ * hardware with the crc32 instruction of the SSE4.2 instruction set.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+static uint32_t		crc32c_table(  uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+
+#if defined(LIBCRC_X86_SIMD)
+static uint32_t		crc32c_sse42(  uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crc32c_select( void );
+#endif
+
+/*
+ * static uint32_t (*crc32c_block)( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function pointer crc32c_block points to the fastest routine available
+ * on the current CPU to update a CRC-32C value with a block of bytes. It is
+ * initialized with the portable table driven routine and changed only once at
+ * program startup by crc32c_select().
+ */
+
+static uint32_t		(*crc32c_block)( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) = crc32c_table;
+
+/*
+ * Include the lookup tables for the CRC-32C calculation. Apart from the byte
+ * wise table crc_tab32c[] and the slicing-by-8 tables, the file contains the
+ * tables crc_tab32c_long[][] and crc_tab32c_short[][] which advance a CRC-32C
+ * value over CRC32C_LONG and CRC32C_SHORT zero bytes respectively.
+ */
+
+#include "../tab/gentab32c.inc"
+
+/*
+ * #define LOAD_LE32( ptr )
+ *
+ * The macro LOAD_LE32() reads four bytes as a little endian 32 bit word
+ * independent of the endianness and alignment requirements of the platform.
+ */
+
+#define LOAD_LE32(ptr)	(   ( (uint32_t) (ptr)[0]       ) | ( (uint32_t) (ptr)[1] <<  8 )	\
+			  | ( (uint32_t) (ptr)[2] << 16 ) | ( (uint32_t) (ptr)[3] << 24 ) )
+
+/*
+ * uint32_t crc_32c( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_32c() calculates in one pass the 32 bit CRC-32C value for a
+ * byte string that is passed to the function together with a parameter
+ * indicating the length.
+ */
+
+uint32_t crc_32c( const unsigned char *input_str, size_t num_bytes ) {
+
+	if ( input_str == NULL ) return 0;
+
+	return crc32c_block( CRC_START_32C, input_str, num_bytes ) ^ 0xFFFFFFFFul;
+
+}  /* crc_32c */
+
+/*
+ * uint32_t update_crc_32c( uint32_t crc, unsigned char c );
+ *
+ * The function update_crc_32c() calculates a new CRC-32C value based on the
+ * previous value of the CRC and the next byte of the data to be checked.
+ */
+
+uint32_t update_crc_32c( uint32_t crc, unsigned char c ) {
+
+	return (crc >> 8) ^ crc_tab32c[ (crc ^ (uint32_t) c) & 0x000000FFul ];
+
+}  /* update_crc_32c */
+
+/*
+ * uint32_t update_crc_32c_block( uint32_t crc, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function update_crc_32c_block() calculates a new CRC-32C value based on
+ * the previous value of the CRC and the next block of data to be checked. The
+ * result is the same as calling update_crc_32c() for every byte in the block.
+ */
+
+uint32_t update_crc_32c_block( uint32_t crc, const unsigned char *input_str, size_t num_bytes ) {
+
+	if ( input_str == NULL ) return crc;
+
+	return crc32c_block( crc, input_str, num_bytes );
+
+}  /* update_crc_32c_block */
+
+/*
+ * static uint32_t crc32c_table( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc32c_table() is the portable routine to update a CRC-32C
+ * value with a block of bytes. The bulk of the block is processed with the
+ * slicing-by-8 algorithm, the unaligned head and the tail byte by byte.
+ */
+
+static uint32_t crc32c_table( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	uint32_t one;
+	uint32_t two;
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (crc >> 8) ^ crc_tab32c[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		one  = LOAD_LE32( ptr     ) ^ crc;
+		two  = LOAD_LE32( ptr + 4 );
+
+		crc  = crc_tab32c_slice[7][  one        & 0xFF ]
+		     ^ crc_tab32c_slice[6][ (one >>  8) & 0xFF ]
+		     ^ crc_tab32c_slice[5][ (one >> 16) & 0xFF ]
+		     ^ crc_tab32c_slice[4][  one >> 24         ]
+		     ^ crc_tab32c_slice[3][  two        & 0xFF ]
+		     ^ crc_tab32c_slice[2][ (two >>  8) & 0xFF ]
+		     ^ crc_tab32c_slice[1][ (two >> 16) & 0xFF ]
+		     ^ crc_tab32c_slice[0][  two >> 24         ];
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc >> 8) ^ crc_tab32c[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc32c_table */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * #define CRC32C_SHIFT( table, crc )
+ *
+ * The macro CRC32C_SHIFT() advances a CRC-32C value over the fixed number of
+ * zero bytes for which the shift table has been generated.
+ */
+
+#define CRC32C_SHIFT(table,crc)	(   (table)[0][  (crc)        & 0xFF ] ^ (table)[1][ ((crc) >>  8) & 0xFF ]	\
+				  ^ (table)[2][ ((crc) >> 16) & 0xFF ] ^ (table)[3][  (crc) >> 24         ] )
+
+/*
+ * static void crc32c_select( void );
+ *
+ * The function crc32c_select() is called once at program startup and selects
+ * the hardware routine for CRC-32C calculations if the CPU supports SSE4.2.
+ */
+
+static LIBCRC_STARTUP void crc32c_select( void ) {
+
+	if ( libcrc_cpu_features() & LIBCRC_CPU_SSE42 ) crc32c_block = crc32c_sse42;
+
+}  /* crc32c_select */
+
+/*
+ * static uint32_t crc32c_sse42( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc32c_sse42() updates a CRC-32C value with the crc32
+ * instruction of the SSE4.2 instruction set. The instruction has a latency of
+ * three cycles, but a throughput of one instruction per cycle. To use the full
+ * throughput, large blocks are split in three parts of equal size which are
+ * processed with three independent instruction streams. The three partial
+ * CRC values are then merged with the precalculated shift tables. Two part
+ * sizes are used, so that also medium sized blocks benefit from the parallel
+ * processing.
+ */
+
+static LIBCRC_TARGET("sse4.2") uint32_t crc32c_sse42( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	uint64_t crc0;
+	uint64_t crc1;
+	uint64_t crc2;
+	uint64_t word0;
+	uint64_t word1;
+	uint64_t word2;
+	const unsigned char *end;
+
+	crc0 = crc;
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc0 = _mm_crc32_u8( (uint32_t) crc0, *ptr++ );
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 3 * CRC32C_LONG ) {
+
+		crc1 = 0;
+		crc2 = 0;
+		end  = ptr + CRC32C_LONG;
+
+		do {
+			memcpy( &word0, ptr,                   8 );
+			memcpy( &word1, ptr +   CRC32C_LONG,   8 );
+			memcpy( &word2, ptr + 2*CRC32C_LONG,   8 );
+
+			crc0 = _mm_crc32_u64( crc0, word0 );
+			crc1 = _mm_crc32_u64( crc1, word1 );
+			crc2 = _mm_crc32_u64( crc2, word2 );
+
+			ptr += 8;
+
+		} while ( ptr < end );
+
+		crc0 = CRC32C_SHIFT( crc_tab32c_long, (uint32_t) crc0 ) ^ crc1;
+		crc0 = CRC32C_SHIFT( crc_tab32c_long, (uint32_t) crc0 ) ^ crc2;
+
+		ptr       += 2 * CRC32C_LONG;
+		num_bytes -= 3 * CRC32C_LONG;
+	}
+
+	while ( num_bytes >= 3 * CRC32C_SHORT ) {
+
+		crc1 = 0;
+		crc2 = 0;
+		end  = ptr + CRC32C_SHORT;
+
+		do {
+			memcpy( &word0, ptr,                   8 );
+			memcpy( &word1, ptr +   CRC32C_SHORT,  8 );
+			memcpy( &word2, ptr + 2*CRC32C_SHORT,  8 );
+
+			crc0 = _mm_crc32_u64( crc0, word0 );
+			crc1 = _mm_crc32_u64( crc1, word1 );
+			crc2 = _mm_crc32_u64( crc2, word2 );
+
+			ptr += 8;
+
+		} while ( ptr < end );
+
+		crc0 = CRC32C_SHIFT( crc_tab32c_short, (uint32_t) crc0 ) ^ crc1;
+		crc0 = CRC32C_SHIFT( crc_tab32c_short, (uint32_t) crc0 ) ^ crc2;
+
+		ptr       += 2 * CRC32C_SHORT;
+		num_bytes -= 3 * CRC32C_SHORT;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		memcpy( &word0, ptr, 8 );
+		crc0 = _mm_crc32_u64( crc0, word0 );
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc0 = _mm_crc32_u8( (uint32_t) crc0, *ptr++ );
+		num_bytes--;
+	}
+
+	return (uint32_t) crc0;
+
+}  /* crc32c_sse42 */
+
+#endif
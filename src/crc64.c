@@ -34,9 +34,30 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
+
+static uint64_t		crc64_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t		crc64_table(  uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+
+#if defined(LIBCRC_X86_SIMD)
+static uint64_t		crc64_pclmul( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crc64_select( void );
+#endif
 
 /*
- * Include the lookup table for the CRC 64 calculation
+ * static uint64_t (*crc64_block)( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function pointer crc64_block points to the fastest routine available on
+ * the current CPU to update a CRC-64 value with a block of bytes. It is
+ * changed only once at program startup by crc64_select().
+ */
+
+static uint64_t		(*crc64_block)( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) = crc64_table;
+
+/*
+ * Include the lookup tables for the CRC 64 calculation. The file contains both
+ * the byte wise table crc_tab64[] and the derived crc_tab64_slice[][] tables
+ * for the slicing-by-8 routine.
  */
 
 #include "../tab/gentab64.inc"
@@ -51,19 +72,7 @@
 
 uint64_t crc_64_ecma( const unsigned char *input_str, size_t num_bytes ) {
 
-	uint64_t crc;
-	const unsigned char *ptr;
-	size_t a;
-
-	crc = CRC_START_64_ECMA;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
-	}
-
-	return crc;
+	return update_crc_64_block( CRC_START_64_ECMA, input_str, num_bytes );
 
 }  /* crc_64_ecma */
 
@@ -77,19 +86,7 @@ uint64_t crc_64_ecma( const unsigned char *input_str, size_t num_bytes ) {
 
 uint64_t crc_64_we( const unsigned char *input_str, size_t num_bytes ) {
 
-	uint64_t crc;
-	const unsigned char *ptr;
-	size_t a;
-
-	crc = CRC_START_64_WE;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
-	}
-
-	return crc ^ 0xFFFFFFFFFFFFFFFFull;
+	return update_crc_64_block( CRC_START_64_WE, input_str, num_bytes ) ^ 0xFFFFFFFFFFFFFFFFull;
 
 }  /* crc_64_we */
 
@@ -105,3 +102,136 @@ uint64_t update_crc_64( uint64_t crc, unsigned char c ) {
 	return (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) c) & 0x00000000000000FFull ];
 
 }  /* update_crc_64 */
+
+/*
+ * uint64_t update_crc_64_block( uint64_t crc, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function update_crc_64_block() calculates a new CRC-64 value based on
+ * the previous value of the CRC and a block of data to be checked. The
+ * function is used both for the ECMA and the WE variant of the CRC-64.
+ */
+
+uint64_t update_crc_64_block( uint64_t crc, const unsigned char *input_str, size_t num_bytes ) {
+
+	if ( input_str == NULL ) return crc;
+
+	return crc64_block( crc, input_str, num_bytes );
+
+}  /* update_crc_64_block */
+
+/*
+ * static uint64_t crc64_table( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc64_table() is the portable routine to update a CRC-64 value
+ * with a block of bytes. Bytes are processed one by one until the pointer is
+ * aligned on an eight byte boundary. The aligned part is processed with the
+ * slicing-by-8 routine and the remaining bytes again one by one.
+ */
+
+static uint64_t crc64_table( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t num_blocks;
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
+		num_bytes--;
+	}
+
+	num_blocks = num_bytes & ~((size_t) 0x07);
+
+	if ( num_blocks > 0 ) {
+
+		crc        = crc64_slice8( crc, ptr, num_blocks );
+		ptr       += num_blocks;
+		num_bytes -= num_blocks;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc64_table */
+
+/*
+ * static uint64_t crc64_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc64_slice8() processes eight bytes per iteration with eight
+ * independent table lookups. The number of bytes must be a multiple of eight.
+ * Because the CRC-64 is calculated with the most significant bit first, the
+ * highest byte of the XOR of the CRC and the data is the oldest byte and is
+ * looked up in the slice for seven following bytes.
+ */
+
+static uint64_t crc64_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	uint64_t val;
+
+	while ( num_bytes >= 8 ) {
+
+		val  = LOAD_BE64( ptr ) ^ crc;
+
+		crc  = crc_tab64_slice[7][  val >> 56         ]
+		     ^ crc_tab64_slice[6][ (val >> 48) & 0xFF ]
+		     ^ crc_tab64_slice[5][ (val >> 40) & 0xFF ]
+		     ^ crc_tab64_slice[4][ (val >> 32) & 0xFF ]
+		     ^ crc_tab64_slice[3][ (val >> 24) & 0xFF ]
+		     ^ crc_tab64_slice[2][ (val >> 16) & 0xFF ]
+		     ^ crc_tab64_slice[1][ (val >>  8) & 0xFF ]
+		     ^ crc_tab64_slice[0][  val        & 0xFF ];
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	return crc;
+
+}  /* crc64_slice8 */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static void crc64_select( void );
+ *
+ * The function crc64_select() is called once at program startup. It selects
+ * the carry-less multiplication routine if the CPU supports the PCLMULQDQ and
+ * SSSE3 instructions.
+ */
+
+static LIBCRC_STARTUP void crc64_select( void ) {
+
+	unsigned int features;
+
+	features = libcrc_cpu_features();
+
+	if ( ( features & LIBCRC_CPU_PCLMUL )  &&  ( features & LIBCRC_CPU_SSSE3 )  &&  ( features & LIBCRC_CPU_SSE41 ) ) crc64_block = crc64_pclmul;
+
+}  /* crc64_select */
+
+/*
+ * static uint64_t crc64_pclmul( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc64_pclmul() updates a CRC-64 value with the generic folding
+ * routine for CRCs with the most significant bit first, using the constants
+ * in crc_tab64_fold[]. Blocks shorter than 64 bytes and the tail of the block
+ * which is not a multiple of 16 bytes are handled by the table driven routine.
+ */
+
+static uint64_t crc64_pclmul( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t num_fold;
+
+	if ( num_bytes < 64 ) return crc64_table( crc, ptr, num_bytes );
+
+	num_fold = num_bytes & ~((size_t) 0x0F);
+	crc      = libcrc_fold_normal( crc_tab64_fold, crc, ptr, num_fold );
+
+	return crc64_table( crc, ptr + num_fold, num_bytes - num_fold );
+
+}  /* crc64_pclmul */
+
+#endif
@@ -29,40 +29,90 @@
  * -----------
  * The source file src/crc8.c contains routines for the calculation of 8 bit
  * CRC values according to the calculation rules used in the SHT1x and SHT7x
- * series of temperature and humidity sensors.
+ * series of temperature and humidity sensors. The same routines calculate the
+ * other common 8 bit CRC algorithms with a family of polynomials for which the
+ * lookup tables and folding constants are generated at compile time.
  */
 
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
+
+static uint8_t		crc8_table(  const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+
+#if defined(LIBCRC_X86_SIMD)
+static uint8_t		crc8_pclmul( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crc8_select( void );
+#endif
+
+/*
+ * Include the lookup tables for the CRC-8 calculation
+ */
+
+#include "../tab/gentab8.inc"
 
 /*
- * static uint8_t sht75_crc_table[];
+ * #define CRC8_FOLD( tab )
  *
- * The SHT75 humidity sensor is capable of calculating an 8 bit CRC checksum to
- * ensure data integrity. The lookup table crc_table[] is used to recalculate
- * the CRC. 
+ * The macro CRC8_FOLD() returns the folding constants of a generated table,
+ * or NULL when the library is compiled without the SIMD routines.
  */
 
-static uint8_t sht75_crc_table[] = {
+#if defined(LIBCRC_X86_SIMD)
+#define CRC8_FOLD(tab)		tab##_fold
+#else
+#define CRC8_FOLD(tab)		NULL
+#endif
+
+/*
+ * struct libcrc_crc8
+ *
+ * The structure libcrc_crc8 describes one member of the CRC-8 family. The
+ * polynomial is stored in normal notation, also for reflected algorithms.
+ */
 
-	0,   49,  98,  83,  196, 245, 166, 151, 185, 136, 219, 234, 125, 76,  31,  46,
-	67,  114, 33,  16,  135, 182, 229, 212, 250, 203, 152, 169, 62,  15,  92,  109,
-	134, 183, 228, 213, 66,  115, 32,  17,  63,  14,  93,  108, 251, 202, 153, 168,
-	197, 244, 167, 150, 1,   48,  99,  82,  124, 77,  30,  47,  184, 137, 218, 235,
-	61,  12,  95,  110, 249, 200, 155, 170, 132, 181, 230, 215, 64,  113, 34,  19,
-	126, 79,  28,  45,  186, 139, 216, 233, 199, 246, 165, 148, 3,   50,  97,  80,
-	187, 138, 217, 232, 127, 78,  29,  44,  2,   51,  96,  81,  198, 247, 164, 149,
-	248, 201, 154, 171, 60,  13,  94,  111, 65,  112, 35,  18,  133, 180, 231, 214,
-	122, 75,  24,  41,  190, 143, 220, 237, 195, 242, 161, 144, 7,   54,  101, 84,
-	57,  8,   91,  106, 253, 204, 159, 174, 128, 177, 226, 211, 68,  117, 38,  23,
-	252, 205, 158, 175, 56,  9,   90,  107, 69,  116, 39,  22,  129, 176, 227, 210,
-	191, 142, 221, 236, 123, 74,  25,  40,  6,   55,  100, 85,  194, 243, 160, 145,
-	71,  118, 37,  20,  131, 178, 225, 208, 254, 207, 156, 173, 58,  11,  88,  105,
-	4,   53,  102, 87,  192, 241, 162, 147, 189, 140, 223, 238, 121, 72,  27,  42,
-	193, 240, 163, 146, 5,   52,  103, 86,  120, 73,  26,  43,  188, 141, 222, 239,
-	130, 179, 224, 209, 70,  119, 36,  21,  59,  10,  89,  104, 255, 206, 157, 172
+							/************************************************/
+struct libcrc_crc8 {					/*						*/
+	uint8_t			poly;			/* The polynomial without the leading term	*/
+	bool			reflected;		/* The CRC is calculated with reflected bits	*/
+	const uint8_t		(*slice)[256];		/* The slicing-by-8 lookup tables		*/
+	const uint64_t *	fold;			/* The folding constants or NULL		*/
+};							/*						*/
+							/************************************************/
+
+/*
+ * static const struct libcrc_crc8 crc8_list[];
+ *
+ * The table crc8_list[] contains the polynomials of the CRC-8 family. Together
+ * they cover all 8 bit algorithms of the model catalogue. The first entry is
+ * the polynomial of the SHT75 CRC which is used by crc_8().
+ */
+
+static const struct libcrc_crc8 crc8_list[] = {
+	{ 0x31, false, crc_tab8_slice,     CRC8_FOLD(crc_tab8)     },
+	{ 0x07, false, crc_tab8_07_slice,  CRC8_FOLD(crc_tab8_07)  },
+	{ 0x07, true,  crc_tab8_07r_slice, CRC8_FOLD(crc_tab8_07r) },
+	{ 0x1D, false, crc_tab8_1d_slice,  CRC8_FOLD(crc_tab8_1d)  },
+	{ 0x2F, false, crc_tab8_2f_slice,  CRC8_FOLD(crc_tab8_2f)  },
+	{ 0x31, true,  crc_tab8_31r_slice, CRC8_FOLD(crc_tab8_31r) },
+	{ 0x9B, false, crc_tab8_9b_slice,  CRC8_FOLD(crc_tab8_9b)  },
+	{ 0x9B, true,  crc_tab8_9br_slice, CRC8_FOLD(crc_tab8_9br) },
+	{ 0xA7, true,  crc_tab8_a7r_slice, CRC8_FOLD(crc_tab8_a7r) },
+	{ 0xD5, false, crc_tab8_d5_slice,  CRC8_FOLD(crc_tab8_d5)  }
 };
 
+#define CRC8_NUM_POLY		( sizeof(crc8_list) / sizeof(crc8_list[0]) )
+
+/*
+ * static uint8_t (*crc8_block)( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function pointer crc8_block points to the fastest routine available on
+ * the current CPU to update a CRC-8 value with a block of bytes. It is changed
+ * only once at program startup by crc8_select().
+ */
+
+static uint8_t		(*crc8_block)( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes ) = crc8_table;
+
 /*
  * uint8_t crc_8( const unsigned char *input_str, size_t num_bytes );
  *
@@ -72,21 +122,102 @@ static uint8_t sht75_crc_table[] = {
 
 uint8_t crc_8( const unsigned char *input_str, size_t num_bytes ) {
 
-	size_t a;
-	uint8_t crc;
-	const unsigned char *ptr;
+	return update_crc_8_block( CRC_START_8, input_str, num_bytes );
 
-	crc = CRC_START_8;
-	ptr = input_str;
+}  /* crc_8 */
 
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
+/*
+ * uint8_t crc_8_autosar( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_8_autosar() calculates the CRC-8/AUTOSAR value of an input
+ * string with the polynomial 0x2F, start value 0xFF and final XOR value 0xFF.
+ */
 
-		crc = sht75_crc_table[(*ptr++) ^ crc];
-	}
+uint8_t crc_8_autosar( const unsigned char *input_str, size_t num_bytes ) {
 
-	return crc;
+	return update_crc_8_poly_block( 0x2F, false, CRC_START_8_AUTOSAR, input_str, num_bytes ) ^ 0xFF;
 
-}  /* crc_8 */
+}  /* crc_8_autosar */
+
+/*
+ * uint8_t crc_8_bluetooth( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_8_bluetooth() calculates the CRC-8/BLUETOOTH value of an
+ * input string with the reflected polynomial 0xA7.
+ */
+
+uint8_t crc_8_bluetooth( const unsigned char *input_str, size_t num_bytes ) {
+
+	return update_crc_8_poly_block( 0xA7, true, CRC_START_8_BLUETOOTH, input_str, num_bytes );
+
+}  /* crc_8_bluetooth */
+
+/*
+ * uint8_t crc_8_cdma2000( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_8_cdma2000() calculates the CRC-8/CDMA2000 value of an input
+ * string with the polynomial 0x9B and start value 0xFF.
+ */
+
+uint8_t crc_8_cdma2000( const unsigned char *input_str, size_t num_bytes ) {
+
+	return update_crc_8_poly_block( 0x9B, false, CRC_START_8_CDMA2000, input_str, num_bytes );
+
+}  /* crc_8_cdma2000 */
+
+/*
+ * uint8_t crc_8_maxim( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_8_maxim() calculates the CRC-8/MAXIM-DOW value of an input
+ * string as used by the Dallas/Maxim 1-Wire devices, with the reflected
+ * polynomial 0x31.
+ */
+
+uint8_t crc_8_maxim( const unsigned char *input_str, size_t num_bytes ) {
+
+	return update_crc_8_poly_block( 0x31, true, CRC_START_8_MAXIM, input_str, num_bytes );
+
+}  /* crc_8_maxim */
+
+/*
+ * uint8_t crc_8_rohc( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_8_rohc() calculates the CRC-8/ROHC value of an input string
+ * with the reflected polynomial 0x07 and start value 0xFF.
+ */
+
+uint8_t crc_8_rohc( const unsigned char *input_str, size_t num_bytes ) {
+
+	return update_crc_8_poly_block( 0x07, true, CRC_START_8_ROHC, input_str, num_bytes );
+
+}  /* crc_8_rohc */
+
+/*
+ * uint8_t crc_8_sae_j1850( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_8_sae_j1850() calculates the CRC-8/SAE-J1850 value of an
+ * input string with the polynomial 0x1D, start value 0xFF and final XOR value
+ * 0xFF.
+ */
+
+uint8_t crc_8_sae_j1850( const unsigned char *input_str, size_t num_bytes ) {
+
+	return update_crc_8_poly_block( 0x1D, false, CRC_START_8_SAE_J1850, input_str, num_bytes ) ^ 0xFF;
+
+}  /* crc_8_sae_j1850 */
+
+/*
+ * uint8_t crc_8_smbus( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_8_smbus() calculates the CRC-8/SMBUS value of an input
+ * string with the polynomial 0x07 as used by the SMBus packet error checking.
+ */
+
+uint8_t crc_8_smbus( const unsigned char *input_str, size_t num_bytes ) {
+
+	return update_crc_8_poly_block( 0x07, false, CRC_START_8_SMBUS, input_str, num_bytes );
+
+}  /* crc_8_smbus */
 
 /*
  * uint8_t update_crc_8( unsigned char crc, unsigned char val );
@@ -98,6 +229,172 @@ uint8_t crc_8( const unsigned char *input_str, size_t num_bytes ) {
 
 uint8_t update_crc_8( unsigned char crc, unsigned char val ) {
 
-	return sht75_crc_table[val ^ crc];
+	return crc_tab8[val ^ crc];
 
 }  /* update_crc_8 */
+
+/*
+ * uint8_t update_crc_8_block( uint8_t crc, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function update_crc_8_block() calculates a new CRC-8 value based on the
+ * previous value of the CRC and a block of data to be checked.
+ */
+
+uint8_t update_crc_8_block( uint8_t crc, const unsigned char *input_str, size_t num_bytes ) {
+
+	if ( input_str == NULL ) return crc;
+
+	return crc8_block( & crc8_list[0], crc, input_str, num_bytes );
+
+}  /* update_crc_8_block */
+
+/*
+ * uint8_t update_crc_8_poly_block( uint8_t poly, bool reflected, uint8_t crc, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function update_crc_8_poly_block() calculates a new 8 bit CRC value for
+ * any polynomial based on the previous value of the CRC and a block of data.
+ * The polynomial is passed in normal notation without the leading x^8 term,
+ * also when the CRC is calculated with reflected bits. Polynomials of the
+ * CRC-8 family use the generated tables and the SIMD routines, other
+ * polynomials are calculated by the generic model engine.
+ */
+
+uint8_t update_crc_8_poly_block( uint8_t poly, bool reflected, uint8_t crc, const unsigned char *input_str, size_t num_bytes ) {
+
+	const struct libcrc_crc8 *family;
+	struct crc_model model;
+
+	if ( input_str == NULL ) return crc;
+
+	family = libcrc_crc8_find( poly, reflected );
+	if ( family != NULL ) return crc8_block( family, crc, input_str, num_bytes );
+
+	model.name   = NULL;
+	model.width  = 8;
+	model.poly   = poly;
+	model.init   = 0;
+	model.refin  = reflected;
+	model.refout = reflected;
+	model.xorout = 0;
+	model.check  = 0;
+
+	if ( reflected ) return (uint8_t)   crc_model_update( & model, crc, input_str, num_bytes );
+	else             return (uint8_t) ( crc_model_update( & model, (uint64_t) crc << 56, input_str, num_bytes ) >> 56 );
+
+}  /* update_crc_8_poly_block */
+
+/*
+ * const struct libcrc_crc8 *libcrc_crc8_find( uint8_t poly, bool reflected );
+ *
+ * The function libcrc_crc8_find() searches the CRC-8 family for a polynomial
+ * and bit order. The function returns NULL if the polynomial is not part of
+ * the family.
+ */
+
+const struct libcrc_crc8 *libcrc_crc8_find( uint8_t poly, bool reflected ) {
+
+	size_t a;
+
+	for (a=0; a<CRC8_NUM_POLY; a++) {
+
+		if ( crc8_list[a].poly == poly  &&  crc8_list[a].reflected == reflected ) return & crc8_list[a];
+	}
+
+	return NULL;
+
+}  /* libcrc_crc8_find */
+
+/*
+ * uint8_t libcrc_crc8_block( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function libcrc_crc8_block() updates a CRC value of a member of the
+ * CRC-8 family with a block of bytes. It is used by the model engine.
+ */
+
+uint8_t libcrc_crc8_block( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc8_block( family, crc, ptr, num_bytes );
+
+}  /* libcrc_crc8_block */
+
+/*
+ * static uint8_t crc8_table( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc8_table() is the portable routine to update a CRC-8 value
+ * with a block of bytes. Eight bytes are processed per iteration with the
+ * slicing-by-8 tables. Because the register is only one byte wide, the same
+ * formula is used for normal and reflected polynomials.
+ */
+
+static uint8_t crc8_table( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	const uint8_t (*tab)[256];
+
+	tab = family->slice;
+
+	while ( num_bytes >= 8 ) {
+
+		crc = tab[7][ ptr[0] ^ crc ] ^ tab[6][ ptr[1] ] ^ tab[5][ ptr[2] ] ^ tab[4][ ptr[3] ]
+		    ^ tab[3][ ptr[4]       ] ^ tab[2][ ptr[5] ] ^ tab[1][ ptr[6] ] ^ tab[0][ ptr[7] ];
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = tab[0][ (*ptr++) ^ crc ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc8_table */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static void crc8_select( void );
+ *
+ * The function crc8_select() is called once at program startup. It selects the
+ * carry-less multiplication routine if the CPU supports the PCLMULQDQ,
+ * SSSE3 and SSE4.1 instructions.
+ */
+
+static LIBCRC_STARTUP void crc8_select( void ) {
+
+	unsigned int features;
+
+	features = libcrc_cpu_features();
+
+	if ( ( features & LIBCRC_CPU_PCLMUL )  &&  ( features & LIBCRC_CPU_SSSE3 )  &&  ( features & LIBCRC_CPU_SSE41 ) ) crc8_block = crc8_pclmul;
+
+}  /* crc8_select */
+
+/*
+ * static uint8_t crc8_pclmul( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc8_pclmul() updates a CRC-8 value with the generic folding
+ * routines. Normal CRCs are passed in the highest 8 bits of the 64 bit
+ * register of libcrc_fold_normal(), reflected CRCs in the lowest 8 bits of
+ * the register of libcrc_fold_reflected(). Blocks shorter than 64 bytes and
+ * the tail of the block which is not a multiple of 16 bytes are handled by the
+ * table driven routine.
+ */
+
+static uint8_t crc8_pclmul( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t num_fold;
+
+	if ( num_bytes < 64 ) return crc8_table( family, crc, ptr, num_bytes );
+
+	num_fold = num_bytes & ~((size_t) 0x0F);
+
+	if ( family->reflected ) crc = (uint8_t)   libcrc_fold_reflected( family->fold, crc, ptr, num_fold );
+	else                     crc = (uint8_t) ( libcrc_fold_normal(    family->fold, (uint64_t) crc << 56, ptr, num_fold ) >> 56 );
+
+	return crc8_table( family, crc, ptr + num_fold, num_bytes - num_fold );
+
+}  /* crc8_pclmul */
+
+#endif
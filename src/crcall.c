@@ -0,0 +1,264 @@
+/*
+ * Library: libcrc
+ * File:    src/crcall.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcall.c contains routines to calculate the CRC values
+ * of several algorithms over the same data in one pass. The data is processed
+ * in blocks which are small enough to stay in the cache of the processor, and
+ * every block is fed to all requested algorithms before the next block is
+ * read from memory. Algorithms which only differ in their start value and
+ * final XOR value share one CRC register. The values of the other algorithms
+ * in such a group are derived from it afterwards with the linearity of the
+ * CRC calculation. The same routines are used to find which algorithms match
+ * the CRC at the end of a received message.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#define ALL_BLOCK_SIZE		4096
+
+/*
+ * struct all_tp
+ *
+ * The structure all_tp describes how the CRC of one algorithm is calculated
+ * in a single pass calculation. The register of the algorithm base is updated
+ * with the data, and the register of the algorithm itself is derived from it
+ * with the polynomial poly. The width is the number of bytes of the CRC value
+ * when it is stored at the end of a message.
+ */
+
+							/************************************************/
+struct all_tp {						/*						*/
+	int			base;			/* The algorithm whose register is updated	*/
+	size_t			width;			/* The width of the CRC in bytes		*/
+	const struct libcrc_poly *poly;		/* The polynomial of the shared register	*/
+};							/*						*/
+							/************************************************/
+
+static const struct all_tp all_list[CRC_NUM_TYPES] = {
+	{ 0,                 0, NULL                },
+	{ CRC_TYPE_8,        1, &libcrc_poly_8      },
+	{ CRC_TYPE_16,       2, &libcrc_poly_16     },
+	{ CRC_TYPE_16,       2, &libcrc_poly_16     },
+	{ CRC_TYPE_XMODEM,   2, &libcrc_poly_ccitt  },
+	{ CRC_TYPE_XMODEM,   2, &libcrc_poly_ccitt  },
+	{ CRC_TYPE_XMODEM,   2, &libcrc_poly_ccitt  },
+	{ CRC_TYPE_KERMIT,   2, &libcrc_poly_kermit },
+	{ CRC_TYPE_SICK,     2, &libcrc_poly_sick   },
+	{ CRC_TYPE_DNP,      2, &libcrc_poly_dnp    },
+	{ CRC_TYPE_32,       4, &libcrc_poly_32     },
+	{ CRC_TYPE_32C,      4, &libcrc_poly_32c    },
+	{ CRC_TYPE_64_ECMA,  8, &libcrc_poly_64     },
+	{ CRC_TYPE_64_ECMA,  8, &libcrc_poly_64     }
+};
+
+static void		all_calc( const unsigned char *input_str, const size_t *data_len, unsigned int type_mask, uint64_t *crc );
+
+/*
+ * void crc_all( const unsigned char *input_str, size_t num_bytes, unsigned int type_mask, uint64_t *crc );
+ *
+ * The function crc_all() calculates the CRC values of all algorithms selected
+ * in type_mask over the same buffer in one pass. An algorithm is selected
+ * with the bit CRC_MASK(type) of its CRC_TYPE_xxxx constant. The array crc
+ * must have CRC_NUM_TYPES elements and is indexed with the type constants.
+ * The elements of the selected algorithms receive the same value as the one
+ * pass function of the algorithm would return, the other elements are set to
+ * zero.
+ */
+
+void crc_all( const unsigned char *input_str, size_t num_bytes, unsigned int type_mask, uint64_t *crc ) {
+
+	int type;
+	size_t data_len[CRC_NUM_TYPES];
+
+	if ( crc == NULL ) return;
+
+	if ( input_str == NULL ) num_bytes = 0;
+
+	for (type=0; type<CRC_NUM_TYPES; type++) {
+
+		crc[type]      = 0;
+		data_len[type] = num_bytes;
+	}
+
+	all_calc( input_str, data_len, type_mask & CRC_MASK_ALL, crc );
+
+}  /* crc_all */
+
+/*
+ * unsigned int crc_detect( const unsigned char *input_str, size_t num_bytes, unsigned int type_mask );
+ *
+ * The function crc_detect() finds the CRC algorithms which were used to
+ * calculate the CRC value at the end of a message. For every algorithm
+ * selected in type_mask the CRC of the buffer without its last bytes is
+ * compared with those last bytes, both in big endian and in little endian
+ * order. The number of bytes is the width of the CRC. All candidates are
+ * calculated in one pass over the data. The function returns the mask of the
+ * algorithms which match. Buffers which are not longer than the CRC of an
+ * algorithm never match that algorithm.
+ */
+
+unsigned int crc_detect( const unsigned char *input_str, size_t num_bytes, unsigned int type_mask ) {
+
+	int type;
+	size_t a;
+	size_t width;
+	unsigned int found;
+	uint64_t big;
+	uint64_t little;
+	uint64_t crc[CRC_NUM_TYPES];
+	size_t data_len[CRC_NUM_TYPES];
+
+	if ( input_str == NULL ) return 0;
+
+	type_mask &= CRC_MASK_ALL;
+
+	for (type=1; type<CRC_NUM_TYPES; type++) {
+
+		data_len[type] = 0;
+
+		if ( num_bytes <= all_list[type].width ) type_mask &= ~CRC_MASK(type);
+		else                                     data_len[type] = num_bytes - all_list[type].width;
+	}
+
+	all_calc( input_str, data_len, type_mask, crc );
+
+	found = 0;
+
+	for (type=1; type<CRC_NUM_TYPES; type++) {
+
+		if ( ! ( type_mask & CRC_MASK(type) ) ) continue;
+
+		width  = all_list[type].width;
+		big    = 0;
+		little = 0;
+
+		for (a=0; a<width; a++) {
+
+			big    = ( big << 8 ) | input_str[ data_len[type] + a ];
+			little = little | ( (uint64_t) input_str[ data_len[type] + a ] << (8*a) );
+		}
+
+		if ( crc[type] == big  ||  crc[type] == little ) found |= CRC_MASK(type);
+	}
+
+	return found;
+
+}  /* crc_detect */
+
+/*
+ * static void all_calc( const unsigned char *input_str, const size_t *data_len, unsigned int type_mask, uint64_t *crc );
+ *
+ * The function all_calc() calculates the CRC values of the algorithms in
+ * type_mask. The array data_len contains for each algorithm the number of
+ * bytes at the start of the buffer which must be included. Algorithms which
+ * share a register must have the same length. The buffer is processed in
+ * blocks of ALL_BLOCK_SIZE bytes and every block is passed to the update
+ * routines of all registers while it is still in the cache.
+ */
+
+static void all_calc( const unsigned char *input_str, const size_t *data_len, unsigned int type_mask, uint64_t *crc ) {
+
+	int a;
+	int type;
+	int base;
+	int num_base;
+	int base_list[CRC_NUM_TYPES];
+	size_t pos;
+	size_t len;
+	size_t max_len;
+	uint64_t start;
+	struct crc_ctx ctx;
+	struct crc_ctx base_ctx[CRC_NUM_TYPES];
+	uint64_t base_start[CRC_NUM_TYPES];
+	size_t base_len[CRC_NUM_TYPES];
+	unsigned int base_mask;
+
+	num_base  = 0;
+	base_mask = 0;
+	max_len   = 0;
+
+	for (type=1; type<CRC_NUM_TYPES; type++) {
+
+		if ( ! ( type_mask & CRC_MASK(type) ) ) continue;
+
+		base = all_list[type].base;
+		if ( base_mask & CRC_MASK(base) ) continue;
+
+		crc_ctx_init( & base_ctx[base], base );
+
+		base_mask            |= CRC_MASK(base);
+		base_list[num_base++] = base;
+		base_start[base]      = base_ctx[base].crc;
+		base_len[base]        = data_len[type];
+
+		if ( data_len[type] > max_len ) max_len = data_len[type];
+	}
+
+	for (pos=0; pos<max_len; pos+=ALL_BLOCK_SIZE) {
+
+		for (a=0; a<num_base; a++) {
+
+			base = base_list[a];
+			if ( pos >= base_len[base] ) continue;
+
+			len = base_len[base] - pos;
+			if ( len > ALL_BLOCK_SIZE ) len = ALL_BLOCK_SIZE;
+
+			crc_ctx_update( & base_ctx[base], input_str + pos, len );
+		}
+	}
+
+	/*
+	 * The register of an algorithm with another start value than the base
+	 * differs from the base register by the difference of the start values,
+	 * advanced over the length of the data.
+	 */
+
+	for (type=1; type<CRC_NUM_TYPES; type++) {
+
+		if ( ! ( type_mask & CRC_MASK(type) ) ) continue;
+
+		base = all_list[type].base;
+		ctx  = base_ctx[base];
+
+		if ( type != base ) {
+
+			crc_ctx_init( & ctx, type );
+			start   = ctx.crc;
+			ctx.crc = base_ctx[base].crc ^ libcrc_shift( all_list[type].poly, start ^ base_start[base], data_len[type] );
+		}
+
+		crc[type] = crc_ctx_final( & ctx );
+	}
+
+}  /* all_calc */
@@ -31,15 +31,32 @@
  * CCITT CRC values of a string of bytes.
  */
 
-#include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
 
-static uint16_t		crc_ccitt_generic( const unsigned char *input_str, size_t num_bytes, uint16_t start_value );
-static void             init_crcccitt_tab( void );
+static uint16_t		crcccitt_table(  uint16_t crc, const unsigned char *ptr, size_t num_bytes );
 
-static bool             crc_tabccitt_init       = false;
-static uint16_t         crc_tabccitt[256];
+#if defined(LIBCRC_X86_SIMD)
+static uint16_t		crcccitt_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crcccitt_select( void );
+#endif
+
+/*
+ * Include the lookup table for the CCITT CRC calculation
+ */
+
+#include "../tab/gentabcc.inc"
+
+/*
+ * static uint16_t (*crcccitt_block)( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function pointer crcccitt_block points to the fastest routine available
+ * on the current CPU to update a CCITT CRC value with a block of bytes. It is
+ * changed only once at program startup by crcccitt_select().
+ */
+
+static uint16_t		(*crcccitt_block)( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) = crcccitt_table;
 
 /*
  * uint16_t crc_xmodem( const unsigned char *input_str, size_t num_bytes );
@@ -50,7 +67,7 @@ static uint16_t         crc_tabccitt[256];
 
 uint16_t crc_xmodem( const unsigned char *input_str, size_t num_bytes ) {
 
-	return crc_ccitt_generic( input_str, num_bytes, CRC_START_XMODEM );
+	return update_crc_ccitt_block( CRC_START_XMODEM, input_str, num_bytes );
 
 }  /* crc_xmodem */
 
@@ -64,7 +81,7 @@ uint16_t crc_xmodem( const unsigned char *input_str, size_t num_bytes ) {
 
 uint16_t crc_ccitt_1d0f( const unsigned char *input_str, size_t num_bytes ) {
 
-	return crc_ccitt_generic( input_str, num_bytes, CRC_START_CCITT_1D0F );
+	return update_crc_ccitt_block( CRC_START_CCITT_1D0F, input_str, num_bytes );
 
 }  /* crc_ccitt_1d0f */
 
@@ -78,85 +95,100 @@ uint16_t crc_ccitt_1d0f( const unsigned char *input_str, size_t num_bytes ) {
 
 uint16_t crc_ccitt_ffff( const unsigned char *input_str, size_t num_bytes ) {
 
-	return crc_ccitt_generic( input_str, num_bytes, CRC_START_CCITT_FFFF );
+	return update_crc_ccitt_block( CRC_START_CCITT_FFFF, input_str, num_bytes );
 
 }  /* crc_ccitt_ffff */
 
 /*
- * static uint16_t crc_ccitt_generic( const unsigned char *input_str, size_t num_bytes, uint16_t start_value );
+ * uint16_t update_crc_ccitt( uint16_t crc, unsigned char c );
  *
- * The function crc_ccitt_generic() is a generic implementation of the CCITT
- * algorithm for a one-pass calculation of the CRC for a byte string. The
- * function accepts an initial start value for the crc.
+ * The function update_crc_ccitt() calculates a new CRC-CCITT value based on
+ * the previous value of the CRC and the next byte of the data to be checked.
  */
 
-static uint16_t crc_ccitt_generic( const unsigned char *input_str, size_t num_bytes, uint16_t start_value ) {
+uint16_t update_crc_ccitt( uint16_t crc, unsigned char c ) {
 
-	uint16_t crc;
-	const unsigned char *ptr;
-	size_t a;
+	return (crc << 8) ^ crc_tabccitt[ ((crc >> 8) ^ (uint16_t) c) & 0x00FF ];
 
-	if ( ! crc_tabccitt_init ) init_crcccitt_tab();
+}  /* update_crc_ccitt */
 
-	crc = start_value;
-	ptr = input_str;
+/*
+ * uint16_t update_crc_ccitt_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function update_crc_ccitt_block() calculates a new CRC-CCITT value based
+ * on the previous value of the CRC and a block of data to be checked. The
+ * function is used for the XModem CRC and both CCITT variants.
+ */
 
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
+uint16_t update_crc_ccitt_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes ) {
 
-		crc = (crc << 8) ^ crc_tabccitt[ ((crc >> 8) ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
+	if ( input_str == NULL ) return crc;
 
-	return crc;
+	return crcccitt_block( crc, input_str, num_bytes );
 
-}  /* crc_ccitt_generic */
+}  /* update_crc_ccitt_block */
 
 /*
- * uint16_t update_crc_ccitt( uint16_t crc, unsigned char c );
+ * static uint16_t crcccitt_table( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
  *
- * The function update_crc_ccitt() calculates a new CRC-CCITT value based on
- * the previous value of the CRC and the next byte of the data to be checked.
+ * The function crcccitt_table() is the portable routine to update a CCITT CRC
+ * value with a block of bytes, one byte per iteration.
  */
 
-uint16_t update_crc_ccitt( uint16_t crc, unsigned char c ) {
+static uint16_t crcccitt_table( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-	if ( ! crc_tabccitt_init ) init_crcccitt_tab();
+	while ( num_bytes > 0 ) {
 
-	return (crc << 8) ^ crc_tabccitt[ ((crc >> 8) ^ (uint16_t) c) & 0x00FF ];
+		crc = (crc << 8) ^ crc_tabccitt[ ((crc >> 8) ^ (uint16_t) *ptr++) & 0x00FF ];
+		num_bytes--;
+	}
 
-}  /* update_crc_ccitt */
+	return crc;
+
+}  /* crcccitt_table */
+
+#if defined(LIBCRC_X86_SIMD)
 
 /*
- * static void init_crcccitt_tab( void );
+ * static void crcccitt_select( void );
  *
- * For optimal performance, the routine to calculate the CRC-CCITT uses a
- * lookup table with pre-compiled values that can be directly applied in the
- * XOR action. This table is created at the first call of the function by the
- * init_crcccitt_tab() routine.
+ * The function crcccitt_select() is called once at program startup. It selects
+ * the carry-less multiplication routine if the CPU supports the PCLMULQDQ,
+ * SSSE3 and SSE4.1 instructions.
  */
 
-static void init_crcccitt_tab( void ) {
+static LIBCRC_STARTUP void crcccitt_select( void ) {
 
-	uint16_t i;
-	uint16_t j;
-	uint16_t crc;
-	uint16_t c;
+	unsigned int features;
 
-	for (i=0; i<256; i++) {
+	features = libcrc_cpu_features();
 
-		crc = 0;
-		c   = i << 8;
+	if ( ( features & LIBCRC_CPU_PCLMUL )  &&  ( features & LIBCRC_CPU_SSSE3 )  &&  ( features & LIBCRC_CPU_SSE41 ) ) crcccitt_block = crcccitt_pclmul;
 
-		for (j=0; j<8; j++) {
+}  /* crcccitt_select */
 
-			if ( (crc ^ c) & 0x8000 ) crc = ( crc << 1 ) ^ CRC_POLY_CCITT;
-			else                      crc =   crc << 1;
+/*
+ * static uint16_t crcccitt_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crcccitt_pclmul() updates a CCITT CRC value with the generic
+ * folding routine libcrc_fold_normal() for CRCs which are calculated with the
+ * most significant bit first. The CRC is passed in the upper 16 bits of the 64
+ * bit register of the folding routine. Blocks shorter than 64 bytes and the
+ * tail of the block which is not a multiple of 16 bytes are handled by the
+ * table driven routine.
+ */
 
-			c = c << 1;
-		}
+static uint16_t crcccitt_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-		crc_tabccitt[i] = crc;
-	}
+	size_t num_fold;
+
+	if ( num_bytes < 64 ) return crcccitt_table( crc, ptr, num_bytes );
+
+	num_fold = num_bytes & ~((size_t) 0x0F);
+	crc      = (uint16_t) ( libcrc_fold_normal( crc_tabccitt_fold, (uint64_t) crc << 48, ptr, num_fold ) >> 48 );
+
+	return crcccitt_table( crc, ptr + num_fold, num_bytes - num_fold );
 
-	crc_tabccitt_init = true;
+}  /* crcccitt_pclmul */
 
-}  /* init_crcccitt_tab */
+#endif
@@ -0,0 +1,339 @@
+/*
+ * Library: libcrc
+ * File:    src/crccomb.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crccomb.c contains routines to combine the CRC values
+ * of two adjacent blocks of data into the CRC value of the concatenated
+ * block, without accessing the data itself. The routines are based on the
+ * linearity of the CRC calculation over GF(2). Advancing a CRC value over n
+ * bytes is a multiplication with x^(8n) modulo the CRC polynomial, which is
+ * calculated in logarithmic time from the precalculated powers x^(8*2^k).
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+/*
+ * Include the tables with the powers x^(8*2^k) mod P for all polynomials
+ */
+
+#include "../tab/genpow.inc"
+
+/*
+ * const struct libcrc_poly libcrc_poly_xxx;
+ *
+ * The polynomial descriptors contain the information needed to do the
+ * arithmetic modulo the CRC polynomial of each algorithm in the library. The
+ * polynomials are stored in the same notation as used by the CRC routines.
+ * The SICK algorithm shifts the CRC only one bit for every input byte. Its
+ * power table therefore contains the values x^(2^k) mod P.
+ */
+
+const struct libcrc_poly libcrc_poly_8      = { 0x31ull,          8, false, crc_pow_8      };
+const struct libcrc_poly libcrc_poly_16     = { CRC_POLY_16,     16, true,  crc_pow_16     };
+const struct libcrc_poly libcrc_poly_ccitt  = { CRC_POLY_CCITT,  16, false, crc_pow_ccitt  };
+const struct libcrc_poly libcrc_poly_kermit = { CRC_POLY_KERMIT, 16, true,  crc_pow_kermit };
+const struct libcrc_poly libcrc_poly_dnp    = { CRC_POLY_DNP,    16, true,  crc_pow_dnp    };
+const struct libcrc_poly libcrc_poly_sick   = { CRC_POLY_SICK,   16, false, crc_pow_sick   };
+const struct libcrc_poly libcrc_poly_32     = { CRC_POLY_32,     32, true,  crc_pow_32     };
+const struct libcrc_poly libcrc_poly_32c    = { CRC_POLY_32C,    32, true,  crc_pow_32c    };
+const struct libcrc_poly libcrc_poly_64     = { CRC_POLY_64,     64, false, crc_pow_64     };
+
+/*
+ * uint64_t libcrc_multiply( const struct libcrc_poly *poly, uint64_t a, uint64_t b );
+ *
+ * The function libcrc_multiply() calculates the product of two polynomials
+ * modulo the CRC polynomial. Both the parameters and the result are in the
+ * notation of the CRC polynomial.
+ */
+
+uint64_t libcrc_multiply( const struct libcrc_poly *poly, uint64_t a, uint64_t b ) {
+
+	int i;
+	uint64_t top;
+	uint64_t mask;
+	uint64_t prod;
+
+	top  = 1ull << (poly->bits - 1);
+	mask = ( top << 1 ) - 1;
+	prod = 0;
+
+	if ( poly->reflected ) {
+
+		for (i=0; i<poly->bits; i++) {
+
+			if ( a & (top >> i) ) prod ^= b;
+
+			if ( b & 1 ) b = ( b >> 1 ) ^ poly->poly;
+			else         b =   b >> 1;
+		}
+	}
+
+	else {
+
+		for (i=0; i<poly->bits; i++) {
+
+			if ( a & 1 ) prod ^= b;
+
+			if ( b & top ) b = ( ( b << 1 ) & mask ) ^ poly->poly;
+			else           b =   ( b << 1 ) & mask;
+
+			a >>= 1;
+		}
+	}
+
+	return prod;
+
+}  /* libcrc_multiply */
+
+/*
+ * uint64_t libcrc_shift( const struct libcrc_poly *poly, uint64_t crc, uint64_t num_units );
+ *
+ * The function libcrc_shift() advances a CRC register value over a number of
+ * zero input units. For all algorithms except SICK a unit is one byte. The
+ * calculation uses the table with precalculated powers of x and needs at most
+ * one polynomial multiplication for every bit in the number of units.
+ */
+
+uint64_t libcrc_shift( const struct libcrc_poly *poly, uint64_t crc, uint64_t num_units ) {
+
+	int k;
+
+	for (k=0; num_units != 0; k++) {
+
+		if ( num_units & 1 ) crc = libcrc_multiply( poly, poly->powers[k], crc );
+
+		num_units >>= 1;
+	}
+
+	return crc;
+
+}  /* libcrc_shift */
+
+/*
+ * uint8_t crc_8_combine( uint8_t crc1, uint8_t crc2, size_t len2 );
+ *
+ * The function crc_8_combine() calculates the CRC-8 of two concatenated blocks
+ * of data from the CRC-8 values of the individual blocks and the length of the
+ * second block.
+ */
+
+uint8_t crc_8_combine( uint8_t crc1, uint8_t crc2, size_t len2 ) {
+
+	return (uint8_t) libcrc_shift( &libcrc_poly_8, crc1, len2 ) ^ crc2;
+
+}  /* crc_8_combine */
+
+/*
+ * uint16_t crc_16_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_16_combine() calculates the CRC-16 of two concatenated
+ * blocks of data from the CRC-16 values of the individual blocks and the
+ * length of the second block.
+ */
+
+uint16_t crc_16_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_16, crc1, len2 ) ^ crc2;
+
+}  /* crc_16_combine */
+
+/*
+ * uint16_t crc_modbus_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_modbus_combine() calculates the Modbus CRC of two
+ * concatenated blocks of data. Because the Modbus CRC starts with a non zero
+ * value, the contribution of the start value of the second block is removed
+ * by shifting it together with the CRC of the first block.
+ */
+
+uint16_t crc_modbus_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_16, crc1 ^ CRC_START_MODBUS, len2 ) ^ crc2;
+
+}  /* crc_modbus_combine */
+
+/*
+ * uint16_t crc_xmodem_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_xmodem_combine() calculates the XModem CRC of two
+ * concatenated blocks of data.
+ */
+
+uint16_t crc_xmodem_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_ccitt, crc1 ^ CRC_START_XMODEM, len2 ) ^ crc2;
+
+}  /* crc_xmodem_combine */
+
+/*
+ * uint16_t crc_ccitt_1d0f_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_ccitt_1d0f_combine() calculates the CCITT CRC with start
+ * value 0x1D0F of two concatenated blocks of data.
+ */
+
+uint16_t crc_ccitt_1d0f_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_ccitt, crc1 ^ CRC_START_CCITT_1D0F, len2 ) ^ crc2;
+
+}  /* crc_ccitt_1d0f_combine */
+
+/*
+ * uint16_t crc_ccitt_ffff_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_ccitt_ffff_combine() calculates the CCITT CRC with start
+ * value 0xFFFF of two concatenated blocks of data.
+ */
+
+uint16_t crc_ccitt_ffff_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_ccitt, crc1 ^ CRC_START_CCITT_FFFF, len2 ) ^ crc2;
+
+}  /* crc_ccitt_ffff_combine */
+
+/*
+ * uint16_t crc_kermit_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_kermit_combine() calculates the Kermit CRC of two
+ * concatenated blocks of data. The Kermit CRC is returned with the bytes
+ * swapped, so the swap is undone before the calculation and redone after it.
+ */
+
+uint16_t crc_kermit_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	uint16_t crc;
+
+	crc = (uint16_t) libcrc_shift( &libcrc_poly_kermit, SWAP16( crc1 ), len2 ) ^ SWAP16( crc2 );
+
+	return SWAP16( crc );
+
+}  /* crc_kermit_combine */
+
+/*
+ * uint16_t crc_dnp_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_dnp_combine() calculates the DNP CRC of two concatenated
+ * blocks of data. The DNP CRC is inverted and byte swapped after the
+ * calculation. The swap is undone first and the inversion of the first CRC is
+ * removed before it is shifted over the length of the second block.
+ */
+
+uint16_t crc_dnp_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	uint16_t crc;
+
+	crc = (uint16_t) libcrc_shift( &libcrc_poly_dnp, SWAP16( crc1 ) ^ 0xFFFF, len2 ) ^ SWAP16( crc2 );
+
+	return SWAP16( crc );
+
+}  /* crc_dnp_combine */
+
+/*
+ * uint16_t crc_sick_combine( uint16_t crc1, uint16_t crc2, size_t len2, unsigned char last_byte1 );
+ *
+ * The function crc_sick_combine() calculates the SICK CRC of two concatenated
+ * blocks of data. The SICK algorithm mixes the previous byte into the CRC
+ * when the next byte is processed. The last byte of the first block therefore
+ * influences the CRC of the concatenated data and must be passed as a
+ * parameter. Its contribution enters the calculation together with the first
+ * byte of the second block.
+ */
+
+uint16_t crc_sick_combine( uint16_t crc1, uint16_t crc2, size_t len2, unsigned char last_byte1 ) {
+
+	uint64_t crc;
+
+	if ( len2 == 0 ) return crc1;
+
+	crc  = libcrc_shift( &libcrc_poly_sick, SWAP16( crc1 ),                len2     );
+	crc ^= libcrc_shift( &libcrc_poly_sick, ((uint16_t) last_byte1) << 8, len2 - 1 );
+	crc ^= SWAP16( crc2 );
+
+	return SWAP16( crc );
+
+}  /* crc_sick_combine */
+
+/*
+ * uint32_t crc_32_combine( uint32_t crc1, uint32_t crc2, size_t len2 );
+ *
+ * The function crc_32_combine() calculates the CRC-32 of two concatenated
+ * blocks of data from the CRC-32 values of the individual blocks and the
+ * length of the second block. The start value and the final inversion of the
+ * CRC-32 cancel each other out in the calculation.
+ */
+
+uint32_t crc_32_combine( uint32_t crc1, uint32_t crc2, size_t len2 ) {
+
+	return (uint32_t) libcrc_shift( &libcrc_poly_32, crc1, len2 ) ^ crc2;
+
+}  /* crc_32_combine */
+
+/*
+ * uint32_t crc_32c_combine( uint32_t crc1, uint32_t crc2, size_t len2 );
+ *
+ * The function crc_32c_combine() calculates the CRC-32C of two concatenated
+ * blocks of data from the CRC-32C values of the individual blocks and the
+ * length of the second block.
+ */
+
+uint32_t crc_32c_combine( uint32_t crc1, uint32_t crc2, size_t len2 ) {
+
+	return (uint32_t) libcrc_shift( &libcrc_poly_32c, crc1, len2 ) ^ crc2;
+
+}  /* crc_32c_combine */
+
+/*
+ * uint64_t crc_64_ecma_combine( uint64_t crc1, uint64_t crc2, size_t len2 );
+ *
+ * The function crc_64_ecma_combine() calculates the ECMA 64 bit CRC of two
+ * concatenated blocks of data.
+ */
+
+uint64_t crc_64_ecma_combine( uint64_t crc1, uint64_t crc2, size_t len2 ) {
+
+	return libcrc_shift( &libcrc_poly_64, crc1, len2 ) ^ crc2;
+
+}  /* crc_64_ecma_combine */
+
+/*
+ * uint64_t crc_64_we_combine( uint64_t crc1, uint64_t crc2, size_t len2 );
+ *
+ * The function crc_64_we_combine() calculates the CRC64-WE 64 bit CRC of two
+ * concatenated blocks of data. As with CRC-32 the start value and the final
+ * inversion cancel each other out.
+ */
+
+uint64_t crc_64_we_combine( uint64_t crc1, uint64_t crc2, size_t len2 ) {
+
+	return libcrc_shift( &libcrc_poly_64, crc1, len2 ) ^ crc2;
+
+}  /* crc_64_we_combine */
@@ -0,0 +1,190 @@
+/*
+ * Library: libcrc
+ * File:    src/crccopy.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crccopy.c contains routines which copy a buffer and
+ * calculate its CRC in one pass. The data is processed in blocks which are
+ * small enough to stay in the first level cache. The CRC of a block is
+ * calculated first, which brings the block into the cache, and the block is
+ * then copied from the cache to the destination. The source is therefore read
+ * from memory only once. Large buffers are written with non-temporal stores,
+ * which bypass the cache and avoid reading the destination into the cache
+ * before it is overwritten.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+#define COPY_BLOCK_SIZE		4096
+#define COPY_STREAM_MIN		(256*1024)
+
+static uint64_t		copy_calc( int type, unsigned char *dst, const unsigned char *src, size_t num_bytes );
+
+#if defined(LIBCRC_X86_SIMD)
+static void		copy_stream( unsigned char *dst, const unsigned char *src, size_t num_bytes );
+#endif
+
+/*
+ * uintXX_t crc_xxx_copy( unsigned char *dst, const unsigned char *src, size_t num_bytes );
+ *
+ * The functions of the form crc_xxx_copy() copy num_bytes bytes from src to
+ * dst and return the CRC of the data. The CRC is the same as the one pass
+ * function crc_xxx() would return for the buffer src. The buffers must not
+ * overlap.
+ */
+
+uint8_t  crc_8_copy(          unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint8_t)  copy_calc( CRC_TYPE_8,          dst, src, num_bytes ); }
+uint16_t crc_16_copy(         unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint16_t) copy_calc( CRC_TYPE_16,         dst, src, num_bytes ); }
+uint16_t crc_modbus_copy(     unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint16_t) copy_calc( CRC_TYPE_MODBUS,     dst, src, num_bytes ); }
+uint16_t crc_xmodem_copy(     unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint16_t) copy_calc( CRC_TYPE_XMODEM,     dst, src, num_bytes ); }
+uint16_t crc_ccitt_1d0f_copy( unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint16_t) copy_calc( CRC_TYPE_CCITT_1D0F, dst, src, num_bytes ); }
+uint16_t crc_ccitt_ffff_copy( unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint16_t) copy_calc( CRC_TYPE_CCITT_FFFF, dst, src, num_bytes ); }
+uint16_t crc_kermit_copy(     unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint16_t) copy_calc( CRC_TYPE_KERMIT,     dst, src, num_bytes ); }
+uint16_t crc_sick_copy(       unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint16_t) copy_calc( CRC_TYPE_SICK,       dst, src, num_bytes ); }
+uint16_t crc_dnp_copy(        unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint16_t) copy_calc( CRC_TYPE_DNP,        dst, src, num_bytes ); }
+uint32_t crc_32_copy(         unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint32_t) copy_calc( CRC_TYPE_32,         dst, src, num_bytes ); }
+uint32_t crc_32c_copy(        unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return (uint32_t) copy_calc( CRC_TYPE_32C,        dst, src, num_bytes ); }
+uint64_t crc_64_ecma_copy(    unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return            copy_calc( CRC_TYPE_64_ECMA,    dst, src, num_bytes ); }
+uint64_t crc_64_we_copy(      unsigned char *dst, const unsigned char *src, size_t num_bytes ) { return            copy_calc( CRC_TYPE_64_WE,      dst, src, num_bytes ); }
+
+/*
+ * static uint64_t copy_calc( int type, unsigned char *dst, const unsigned char *src, size_t num_bytes );
+ *
+ * The function copy_calc() copies the buffer src to dst in blocks of
+ * COPY_BLOCK_SIZE bytes and calculates the CRC of algorithm type over it.
+ * Each block is first passed to the streaming CRC routines and then copied
+ * while it is still in the cache. Buffers of at least COPY_STREAM_MIN bytes
+ * are larger than the caches of most processors and are written with
+ * non-temporal stores if the platform supports them. Nothing is copied if one
+ * of the pointers is NULL.
+ */
+
+static uint64_t copy_calc( int type, unsigned char *dst, const unsigned char *src, size_t num_bytes ) {
+
+	size_t len;
+	size_t pos;
+	bool stream;
+	struct crc_ctx ctx;
+
+	crc_ctx_init( & ctx, type );
+
+	if ( dst == NULL  ||  src == NULL ) return crc_ctx_final( & ctx );
+
+	stream = ( num_bytes >= COPY_STREAM_MIN );
+
+	for (pos=0; pos<num_bytes; pos+=len) {
+
+		len = num_bytes - pos;
+		if ( len > COPY_BLOCK_SIZE ) len = COPY_BLOCK_SIZE;
+
+		crc_ctx_update( & ctx, src + pos, len );
+
+#if defined(LIBCRC_X86_SIMD)
+		if ( stream ) copy_stream( dst + pos, src + pos, len );
+		else          memcpy(      dst + pos, src + pos, len );
+#else
+		memcpy( dst + pos, src + pos, len );
+#endif
+	}
+
+#if defined(LIBCRC_X86_SIMD)
+	if ( stream ) _mm_sfence();
+#else
+	(void) stream;
+#endif
+
+	return crc_ctx_final( & ctx );
+
+}  /* copy_calc */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static void copy_stream( unsigned char *dst, const unsigned char *src, size_t num_bytes );
+ *
+ * The function copy_stream() copies a block of data with the non-temporal
+ * store instructions of SSE2, which are available on every x86-64 CPU. The
+ * stores need an aligned destination, so the bytes up to the first 16 byte
+ * boundary of the destination and the bytes after the last complete 16 byte
+ * block are copied normally. The caller must issue a store fence after the
+ * last block.
+ */
+
+static void copy_stream( unsigned char *dst, const unsigned char *src, size_t num_bytes ) {
+
+	size_t head;
+	__m128i x1, x2, x3, x4;
+
+	head = ( 16 - ( (uintptr_t) dst & 0x0F ) ) & 0x0F;
+	if ( head > num_bytes ) head = num_bytes;
+
+	memcpy( dst, src, head );
+
+	dst       += head;
+	src       += head;
+	num_bytes -= head;
+
+	while ( num_bytes >= 64 ) {
+
+		x1 = _mm_loadu_si128( (const __m128i *) (src +  0) );
+		x2 = _mm_loadu_si128( (const __m128i *) (src + 16) );
+		x3 = _mm_loadu_si128( (const __m128i *) (src + 32) );
+		x4 = _mm_loadu_si128( (const __m128i *) (src + 48) );
+
+		_mm_stream_si128( (__m128i *) (dst +  0), x1 );
+		_mm_stream_si128( (__m128i *) (dst + 16), x2 );
+		_mm_stream_si128( (__m128i *) (dst + 32), x3 );
+		_mm_stream_si128( (__m128i *) (dst + 48), x4 );
+
+		dst       += 64;
+		src       += 64;
+		num_bytes -= 64;
+	}
+
+	while ( num_bytes >= 16 ) {
+
+		_mm_stream_si128( (__m128i *) dst, _mm_loadu_si128( (const __m128i *) src ) );
+
+		dst       += 16;
+		src       += 16;
+		num_bytes -= 16;
+	}
+
+	memcpy( dst, src, num_bytes );
+
+}  /* copy_stream */
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Library: libcrc
+ * File:    src/crcctx.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcctx.c contains routines to calculate the CRC of data
+ * which is not available in one buffer. A context structure is initialized
+ * for one of the CRC algorithms, the data is added to it in blocks of any
+ * size and the final CRC value is read from it. The start values, the final
+ * inversion and the byte swapping of the different algorithms are handled by
+ * the routines. The blocks are processed with the same fast routines as the
+ * one pass CRC functions.
+ */
+
+#include <stdlib.h>
+#include "checksum.h"
+
+/*
+ * struct crc_ctx *crc_ctx_init( struct crc_ctx *ctx, int type );
+ *
+ * The function crc_ctx_init() initializes a context structure for the
+ * calculation of the CRC algorithm type, which is one of the CRC_TYPE_xxxx
+ * constants. The function returns a pointer to the context, or NULL if the
+ * context pointer is NULL or the type is unknown.
+ */
+
+struct crc_ctx *crc_ctx_init( struct crc_ctx *ctx, int type ) {
+
+	if ( ctx == NULL ) return NULL;
+
+	switch ( type ) {
+
+		case CRC_TYPE_8           : ctx->crc = CRC_START_8;          break;
+		case CRC_TYPE_16          : ctx->crc = CRC_START_16;         break;
+		case CRC_TYPE_MODBUS      : ctx->crc = CRC_START_MODBUS;     break;
+		case CRC_TYPE_XMODEM      : ctx->crc = CRC_START_XMODEM;     break;
+		case CRC_TYPE_CCITT_1D0F  : ctx->crc = CRC_START_CCITT_1D0F; break;
+		case CRC_TYPE_CCITT_FFFF  : ctx->crc = CRC_START_CCITT_FFFF; break;
+		case CRC_TYPE_KERMIT      : ctx->crc = CRC_START_KERMIT;     break;
+		case CRC_TYPE_SICK        : ctx->crc = CRC_START_SICK;       break;
+		case CRC_TYPE_DNP         : ctx->crc = CRC_START_DNP;        break;
+		case CRC_TYPE_32          : ctx->crc = CRC_START_32;         break;
+		case CRC_TYPE_32C         : ctx->crc = CRC_START_32C;        break;
+		case CRC_TYPE_64_ECMA     : ctx->crc = CRC_START_64_ECMA;    break;
+		case CRC_TYPE_64_WE       : ctx->crc = CRC_START_64_WE;      break;
+		default                   : return NULL;
+	}
+
+	ctx->type      = type;
+	ctx->prev_byte = 0;
+
+	return ctx;
+
+}  /* crc_ctx_init */
+
+/*
+ * void crc_ctx_update( struct crc_ctx *ctx, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_ctx_update() adds a block of data to a streaming CRC
+ * calculation.
+ */
+
+void crc_ctx_update( struct crc_ctx *ctx, const unsigned char *input_str, size_t num_bytes ) {
+
+	if ( ctx == NULL  ||  input_str == NULL  ||  num_bytes == 0 ) return;
+
+	switch ( ctx->type ) {
+
+		case CRC_TYPE_8           : ctx->crc = update_crc_8_block(      (uint8_t)  ctx->crc, input_str, num_bytes ); break;
+		case CRC_TYPE_16          :
+		case CRC_TYPE_MODBUS      : ctx->crc = update_crc_16_block(     (uint16_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_TYPE_XMODEM      :
+		case CRC_TYPE_CCITT_1D0F  :
+		case CRC_TYPE_CCITT_FFFF  : ctx->crc = update_crc_ccitt_block(  (uint16_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_TYPE_KERMIT      : ctx->crc = update_crc_kermit_block( (uint16_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_TYPE_DNP         : ctx->crc = update_crc_dnp_block(    (uint16_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_TYPE_32          : ctx->crc = update_crc_32_block(     (uint32_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_TYPE_32C         : ctx->crc = update_crc_32c_block(    (uint32_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_TYPE_64_ECMA     :
+		case CRC_TYPE_64_WE       : ctx->crc = update_crc_64_block(                ctx->crc, input_str, num_bytes ); break;
+
+		case CRC_TYPE_SICK        : ctx->crc       = update_crc_sick_block( (uint16_t) ctx->crc, input_str, num_bytes, ctx->prev_byte );
+					    ctx->prev_byte = input_str[num_bytes-1];
+					    break;
+	}
+
+}  /* crc_ctx_update */
+
+/*
+ * uint64_t crc_ctx_final( const struct crc_ctx *ctx );
+ *
+ * The function crc_ctx_final() returns the CRC value of all data which has
+ * been added to the context. The value is the same as the one pass CRC
+ * function of the algorithm would have returned for the concatenated data.
+ * The context is not changed, so more data can be added afterwards.
+ */
+
+uint64_t crc_ctx_final( const struct crc_ctx *ctx ) {
+
+	uint16_t crc16;
+
+	if ( ctx == NULL ) return 0;
+
+	switch ( ctx->type ) {
+
+		case CRC_TYPE_KERMIT      :
+		case CRC_TYPE_SICK        : crc16 = (uint16_t) ctx->crc;
+					    return (uint16_t) ( (crc16 >> 8) | (crc16 << 8) );
+
+		case CRC_TYPE_DNP         : crc16 = (uint16_t) ~ctx->crc;
+					    return (uint16_t) ( (crc16 >> 8) | (crc16 << 8) );
+
+		case CRC_TYPE_32          : return ctx->crc ^ 0xFFFFFFFFul;
+		case CRC_TYPE_32C         : return ctx->crc ^ 0xFFFFFFFFul;
+		case CRC_TYPE_64_WE       : return ctx->crc ^ 0xFFFFFFFFFFFFFFFFull;
+	}
+
+	return ctx->crc;
+
+}  /* crc_ctx_final */
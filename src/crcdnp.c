@@ -31,16 +31,32 @@
  * the CRC value in DNP messages.
  */
 
-
-
-#include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
+
+static uint16_t		crcdnp_table(  uint16_t crc, const unsigned char *ptr, size_t num_bytes );
 
-static void             init_crcdnp_tab( void );
+#if defined(LIBCRC_X86_SIMD)
+static uint16_t		crcdnp_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crcdnp_select( void );
+#endif
+
+/*
+ * Include the lookup table for the DNP CRC calculation
+ */
+
+#include "../tab/gentabdnp.inc"
+
+/*
+ * static uint16_t (*crcdnp_block)( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function pointer crcdnp_block points to the fastest routine available on
+ * the current CPU to update a DNP CRC value with a block of bytes. It is
+ * changed only once at program startup by crcdnp_select().
+ */
 
-static bool             crc_tabdnp_init         = false;
-static uint16_t         crc_tabdnp[256];
+static uint16_t		(*crcdnp_block)( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) = crcdnp_table;
 
 /*
  * uint16_t crc_dnp( const unsigned char* input_str, size_t num_bytes );
@@ -54,18 +70,8 @@ uint16_t crc_dnp( const unsigned char *input_str, size_t num_bytes ) {
 	uint16_t crc;
 	uint16_t low_byte;
 	uint16_t high_byte;
-	const unsigned char *ptr;
-	size_t a;
 
-	if ( ! crc_tabdnp_init ) init_crcdnp_tab();
-
-	crc = CRC_START_DNP;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc >> 8) ^ crc_tabdnp[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
+	crc = update_crc_dnp_block( CRC_START_DNP, input_str, num_bytes );
 
 	crc       = ~crc;
 	low_byte  = (crc & 0xff00) >> 8;
@@ -85,44 +91,87 @@ uint16_t crc_dnp( const unsigned char *input_str, size_t num_bytes ) {
 
 uint16_t update_crc_dnp( uint16_t crc, unsigned char c ) {
 
-	if ( ! crc_tabdnp_init ) init_crcdnp_tab();
-
 	return (crc >> 8) ^ crc_tabdnp[ (crc ^ (uint16_t) c) & 0x00FF ];
 
 }  /* update_crc_dnp */
 
 /*
- * static void init_crcdnp_tab( void );
+ * uint16_t update_crc_dnp_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes );
  *
- * For better performance, the DNP CRC calculation uses a precompiled list with
- * bit patterns that are used in the XOR operation in the main routine. This
- * table is calculated once at the start of the program by the
- * init_crcdnp_tab() routine.
+ * The function update_crc_dnp_block() calculates a new CRC-DNP value based on
+ * the previous value of the CRC and a block of data to be checked. The result
+ * is not inverted and its bytes are not swapped.
  */
 
-static void init_crcdnp_tab( void ) {
+uint16_t update_crc_dnp_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes ) {
 
-	int i;
-	int j;
-	uint16_t crc;
-	uint16_t c;
+	if ( input_str == NULL ) return crc;
 
-	for (i=0; i<256; i++) {
+	return crcdnp_block( crc, input_str, num_bytes );
 
-		crc = 0;
-		c   = (uint16_t) i;
+}  /* update_crc_dnp_block */
 
-		for (j=0; j<8; j++) {
+/*
+ * static uint16_t crcdnp_table( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crcdnp_table() is the portable routine to update a DNP CRC value
+ * with a block of bytes, one byte per iteration.
+ */
 
-			if ( (crc ^ c) & 0x0001 ) crc = ( crc >> 1 ) ^ CRC_POLY_DNP;
-			else                      crc =   crc >> 1;
+static uint16_t crcdnp_table( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-			c = c >> 1;
-		}
+	while ( num_bytes > 0 ) {
 
-		crc_tabdnp[i] = crc;
+		crc = (crc >> 8) ^ crc_tabdnp[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
+		num_bytes--;
 	}
 
-	crc_tabdnp_init = true;
+	return crc;
+
+}  /* crcdnp_table */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static void crcdnp_select( void );
+ *
+ * The function crcdnp_select() is called once at program startup. It selects
+ * the carry-less multiplication routine if the CPU supports the PCLMULQDQ and
+ * SSE4.1 instructions.
+ */
+
+static LIBCRC_STARTUP void crcdnp_select( void ) {
+
+	unsigned int features;
+
+	features = libcrc_cpu_features();
+
+	if ( ( features & LIBCRC_CPU_PCLMUL )  &&  ( features & LIBCRC_CPU_SSE41 ) ) crcdnp_block = crcdnp_pclmul;
+
+}  /* crcdnp_select */
+
+/*
+ * static uint16_t crcdnp_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crcdnp_pclmul() updates a DNP CRC value with the generic folding
+ * routine libcrc_fold_reflected() for CRCs which are calculated with the least
+ * significant bit first. The CRC is passed in the lower 16 bits of the 64 bit
+ * register of the folding routine. Blocks shorter than 64 bytes and the tail of
+ * the block which is not a multiple of 16 bytes are handled by the table driven
+ * routine.
+ */
+
+static uint16_t crcdnp_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t num_fold;
+
+	if ( num_bytes < 64 ) return crcdnp_table( crc, ptr, num_bytes );
+
+	num_fold = num_bytes & ~((size_t) 0x0F);
+	crc      = (uint16_t) libcrc_fold_reflected( crc_tabdnp_fold, crc, ptr, num_fold );
+
+	return crcdnp_table( crc, ptr + num_fold, num_bytes - num_fold );
+
+}  /* crcdnp_pclmul */
 
-}  /* init_crcdnp_tab */
+#endif
@@ -0,0 +1,226 @@
+/*
+ * Library: libcrc
+ * File:    src/crcfile.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcfile.c contains a routine which calculates the CRC
+ * of a file. On platforms which can report the holes in sparse files with
+ * SEEK_HOLE and SEEK_DATA, the holes are not read. The CRC is advanced over
+ * them in logarithmic time instead.
+ */
+
+#if ! defined(_WIN32)
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if ! defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+/*
+ * #define FILE_BUFFER_SIZE
+ *
+ * The data of the file is read in blocks of FILE_BUFFER_SIZE bytes.
+ */
+
+#define FILE_BUFFER_SIZE	(256u*1024u)
+
+#if defined(_WIN32)
+
+/*
+ * int crc_ctx_file( struct crc_ctx *ctx, const char *filename );
+ *
+ * The function crc_ctx_file() adds the contents of a file to a streaming CRC
+ * context. This platform cannot report the holes in sparse files, so all data
+ * is read. The function returns 0 on success and -1 if the file could not be
+ * opened or read.
+ */
+
+int crc_ctx_file( struct crc_ctx *ctx, const char *filename ) {
+
+	FILE *fp;
+	size_t num;
+	unsigned char *buffer;
+	bool failed;
+
+	if ( ctx == NULL  ||  filename == NULL ) { errno = EINVAL; return -1; }
+
+	buffer = malloc( FILE_BUFFER_SIZE );
+	if ( buffer == NULL ) return -1;
+
+	if ( fopen_s( & fp, filename, "rb" ) != 0 ) {
+
+		free( buffer );
+		return -1;
+	}
+
+	while ( ( num = fread( buffer, 1, FILE_BUFFER_SIZE, fp ) ) > 0 ) crc_ctx_update( ctx, buffer, num );
+
+	failed = ( ferror( fp ) != 0 );
+
+	fclose( fp );
+	free( buffer );
+
+	return ( failed ) ? -1 : 0;
+
+}  /* crc_ctx_file */
+
+#else
+
+static bool		file_read( struct crc_ctx *ctx, int fd, unsigned char *buffer, off_t pos, off_t end );
+
+/*
+ * int crc_ctx_file( struct crc_ctx *ctx, const char *filename );
+ *
+ * The function crc_ctx_file() adds the contents of a file to a streaming CRC
+ * context. The file is walked from data region to data region with SEEK_DATA
+ * and SEEK_HOLE. Only the data regions are read and the CRC is advanced over
+ * the holes with crc_ctx_zeros(), so a hole costs the same time whatever its
+ * size. If the file system does not report holes, or the file is not a regular
+ * file, all data is read. The function returns 0 on success and -1 with errno
+ * set if the file could not be opened or read.
+ */
+
+int crc_ctx_file( struct crc_ctx *ctx, const char *filename ) {
+
+	int fd;
+	int error;
+	bool sparse;
+	bool success;
+	off_t pos;
+	off_t data;
+	off_t hole;
+	struct stat st;
+	unsigned char *buffer;
+
+	if ( ctx == NULL  ||  filename == NULL ) { errno = EINVAL; return -1; }
+
+	fd = open( filename, O_RDONLY );
+	if ( fd < 0 ) return -1;
+
+	buffer = malloc( FILE_BUFFER_SIZE );
+
+	if ( buffer == NULL  ||  fstat( fd, & st ) != 0 ) {
+
+		error = ( buffer == NULL ) ? ENOMEM : errno;
+		free( buffer );
+		close( fd );
+		errno = error;
+		return -1;
+	}
+
+	if ( ! S_ISREG( st.st_mode ) ) success = file_read( ctx, fd, buffer, 0, -1 );
+	else {
+
+		success = true;
+		sparse  = true;
+		pos     = 0;
+
+		while ( success  &&  pos < st.st_size ) {
+
+			/*
+			 * The hole before the next data region is added as
+			 * zeros. ENXIO means that the rest of the file is a
+			 * hole. Without support for SEEK_DATA the rest of the
+			 * file is treated as one data region.
+			 */
+
+			data = ( sparse ) ? lseek( fd, pos, SEEK_DATA ) : pos;
+
+			if ( data < 0 ) {
+
+				if      ( errno == ENXIO  ) data = st.st_size;
+				else if ( errno == EINVAL ) { data = pos; sparse = false; }
+				else                        { success = false; break; }
+			}
+
+			if ( data > st.st_size ) data = st.st_size;
+
+			crc_ctx_zeros( ctx, (uint64_t) ( data - pos ) );
+			pos = data;
+
+			if ( pos >= st.st_size ) break;
+
+			hole = ( sparse ) ? lseek( fd, pos, SEEK_HOLE ) : st.st_size;
+			if ( hole < 0  ||  hole > st.st_size ) hole = st.st_size;
+
+			success = file_read( ctx, fd, buffer, pos, hole );
+			pos     = hole;
+		}
+	}
+
+	error = errno;
+	free( buffer );
+	close( fd );
+	errno = error;
+
+	return ( success ) ? 0 : -1;
+
+}  /* crc_ctx_file */
+
+/*
+ * static bool file_read( struct crc_ctx *ctx, int fd, unsigned char *buffer, off_t pos, off_t end );
+ *
+ * The function file_read() adds the bytes from position pos up to end of a
+ * file to a CRC context. With an end of -1 the file is read sequentially up to
+ * its end. A file which is shorter than expected ends the region early. The
+ * function returns false if a read error occurred.
+ */
+
+static bool file_read( struct crc_ctx *ctx, int fd, unsigned char *buffer, off_t pos, off_t end ) {
+
+	size_t len;
+	ssize_t num;
+
+	while ( end < 0  ||  pos < end ) {
+
+		len = ( end < 0  ||  end - pos > (off_t) FILE_BUFFER_SIZE ) ? FILE_BUFFER_SIZE : (size_t) ( end - pos );
+		num = ( end < 0 ) ? read( fd, buffer, len ) : pread( fd, buffer, len, pos );
+
+		if ( num < 0  &&  errno == EINTR ) continue;
+		if ( num < 0                     ) return false;
+		if ( num == 0                    ) break;
+
+		crc_ctx_update( ctx, buffer, (size_t) num );
+		pos += num;
+	}
+
+	return true;
+
+}  /* file_read */
+
+#endif
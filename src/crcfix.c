@@ -0,0 +1,398 @@
+/*
+ * Library: libcrc
+ * File:    src/crcfix.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcfix.c contains routines which correct single bit
+ * errors and short error bursts in a frame which is protected with a CRC-32.
+ * The XOR of the calculated and the received CRC, the syndrome, depends only
+ * on the error pattern and its distance to the end of the frame. For a burst
+ * e(x) at a distance of d bits the syndrome is e(x) * x^d * x^32 mod P. The
+ * CRC-32 polynomial is primitive, so every burst pattern has an inverse and
+ * the distance follows from a lookup of the syndrome multiplied with the
+ * inverse of the pattern in a sorted table of the values x^d * x^32 mod P.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+/*
+ * #define FIX_ONE
+ *
+ * In the reflected notation of the CRC-32 the coefficient of x^0 is stored in
+ * the highest bit, so the polynomial 1 is the value FIX_ONE.
+ */
+
+#define FIX_ONE			0x80000000ul
+
+						/************************************************/
+struct fix_entry {				/*						*/
+	uint32_t	syndrome;		/* The value x^d * x^32 mod P			*/
+	uint32_t	distance;		/* The distance d in bits to the end of a frame	*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crc_fix
+ *
+ * The structure crc_fix contains the precalculated tables for the error
+ * correction. The syndromes of single bit errors are sorted for a binary
+ * search, and the inverses of all burst patterns are stored by pattern. A
+ * pattern has its lowest bit set, which is the bit closest to the end of the
+ * frame.
+ */
+
+							/************************************************/
+struct crc_fix {					/*						*/
+	size_t			max_bytes;		/* The maximum length of a frame		*/
+	int			max_burst;		/* The maximum length of an error burst in bits	*/
+	size_t			num_entries;		/* The number of entries in the table		*/
+	struct fix_entry *	table;			/* Sorted syndromes of single bit errors	*/
+	uint32_t *		inverse;		/* Inverses of the burst patterns modulo P	*/
+};							/*						*/
+							/************************************************/
+
+static int		fix_compare( const void *a, const void *b );
+static bool		fix_find( const struct crc_fix *fix, uint32_t syndrome, uint32_t *distance );
+static int		fix_degree( uint64_t value );
+static uint32_t		fix_inverse( uint32_t pattern );
+static int		fix_span( uint32_t value );
+
+/*
+ * struct crc_fix *crc_32_fix_create( size_t max_bytes, int max_burst );
+ *
+ * The function crc_32_fix_create() allocates and calculates the tables which
+ * are needed to correct frames of up to max_bytes bytes with error bursts of
+ * up to max_burst bits. A single bit error is a burst of one bit. The
+ * function returns NULL if the parameters are out of range or if no memory is
+ * available. The tables must be released with crc_32_fix_free().
+ */
+
+struct crc_fix *crc_32_fix_create( size_t max_bytes, int max_burst ) {
+
+	size_t a;
+	uint32_t crc;
+	uint32_t pattern;
+	struct crc_fix *fix;
+
+	if ( max_bytes < 1  ||  max_bytes > CRC_32_FIX_MAX_BYTES ) return NULL;
+	if ( max_burst < 1  ||  max_burst > CRC_32_FIX_MAX_BURST ) return NULL;
+
+	fix = malloc( sizeof(struct crc_fix) );
+	if ( fix == NULL ) return NULL;
+
+	fix->max_bytes   = max_bytes;
+	fix->max_burst   = max_burst;
+	fix->num_entries = max_bytes * 8;
+	fix->table       = malloc( fix->num_entries * sizeof(struct fix_entry) );
+	fix->inverse     = malloc( ( (size_t) 1 << ( max_burst - 1 ) ) * sizeof(uint32_t) );
+
+	if ( fix->table == NULL  ||  fix->inverse == NULL ) {
+
+		crc_32_fix_free( fix );
+		return NULL;
+	}
+
+	/*
+	 * A single one bit followed by zero bits leaves x^32 mod P in the
+	 * register, which is the reflected polynomial itself. Every following
+	 * zero bit multiplies the register with x.
+	 */
+
+	crc = CRC_POLY_32;
+
+	for (a=0; a<fix->num_entries; a++) {
+
+		fix->table[a].syndrome = crc;
+		fix->table[a].distance = (uint32_t) a;
+
+		if ( crc & 0x00000001ul ) crc = ( crc >> 1 ) ^ CRC_POLY_32;
+		else                      crc =   crc >> 1;
+	}
+
+	qsort( fix->table, fix->num_entries, sizeof(struct fix_entry), fix_compare );
+
+	for (pattern=0; pattern < ( 1ul << ( max_burst - 1 ) ); pattern++) {
+
+		fix->inverse[pattern] = fix_inverse( pattern * 2 + 1 );
+	}
+
+	return fix;
+
+}  /* crc_32_fix_create */
+
+/*
+ * void crc_32_fix_free( struct crc_fix *fix );
+ *
+ * The function crc_32_fix_free() releases the tables which were allocated by
+ * crc_32_fix_create().
+ */
+
+void crc_32_fix_free( struct crc_fix *fix ) {
+
+	if ( fix == NULL ) return;
+
+	free( fix->table   );
+	free( fix->inverse );
+	free( fix          );
+
+}  /* crc_32_fix_free */
+
+/*
+ * int crc_32_fix( const struct crc_fix *fix, unsigned char *input_str, size_t num_bytes, uint32_t crc );
+ *
+ * The function crc_32_fix() checks a frame against its received CRC-32 and
+ * corrects a single error burst in the frame in place. Every burst pattern of
+ * up to the maximum length is tried. A correction is only made if exactly one
+ * burst in the data, or exactly one burst in the received CRC value itself,
+ * explains the difference between the calculated and received CRC. The
+ * function returns CRC_FIX_NONE if the frame is correct, CRC_FIX_DATA if the
+ * data has been corrected, CRC_FIX_CRC if the data is correct and the error
+ * is in the received CRC, and CRC_FIX_FAILED if the error cannot be corrected.
+ */
+
+int crc_32_fix( const struct crc_fix *fix, unsigned char *input_str, size_t num_bytes, uint32_t crc ) {
+
+	int i;
+	int b;
+	int result;
+	uint32_t pattern;
+	uint32_t product;
+	uint32_t syndrome;
+	uint32_t distance;
+	uint32_t found_pattern;
+	uint32_t found_distance;
+	uint64_t num_bits;
+	uint64_t pos;
+	uint32_t mul[4][256];
+
+	if ( fix == NULL  ||  input_str == NULL  ||  num_bytes > fix->max_bytes ) return CRC_FIX_FAILED;
+
+	syndrome = crc_32( input_str, num_bytes ) ^ crc;
+	if ( syndrome == 0 ) return CRC_FIX_NONE;
+
+	num_bits       = (uint64_t) num_bytes * 8;
+	found_pattern  = 0;
+	found_distance = 0;
+	result         = ( fix_span( syndrome ) <= fix->max_burst ) ? CRC_FIX_CRC : CRC_FIX_NONE;
+
+	/*
+	 * The syndrome is multiplied with the inverse of every pattern. The
+	 * products of the syndrome with every byte of the inverse are put in
+	 * four tables, starting with the syndrome times x^i for the single bits.
+	 * Bit 31 of the reflected notation is the coefficient of x^0.
+	 */
+
+	product = syndrome;
+
+	for (i=0; i<32; i++) {
+
+		mul[ ( 31 - i ) >> 3 ][ 1 << ( ( 31 - i ) & 7 ) ] = product;
+
+		if ( product & 0x00000001ul ) product = ( product >> 1 ) ^ CRC_POLY_32;
+		else                          product =   product >> 1;
+	}
+
+	for (i=0; i<4; i++) {
+
+		mul[i][0] = 0;
+		for (b=3; b<256; b++) if ( b & ( b - 1 ) ) mul[i][b] = mul[i][ b & ( b - 1 ) ] ^ mul[i][ b & -b ];
+	}
+
+	for (pattern=0; pattern < ( 1ul << ( fix->max_burst - 1 ) ); pattern++) {
+
+		product = mul[0][  fix->inverse[pattern]        & 0xFF ]
+			^ mul[1][ (fix->inverse[pattern] >>  8) & 0xFF ]
+			^ mul[2][ (fix->inverse[pattern] >> 16) & 0xFF ]
+			^ mul[3][  fix->inverse[pattern] >> 24         ];
+
+		if ( ! fix_find( fix, product, & distance ) ) continue;
+		if ( distance + (uint64_t) fix_span( pattern * 2 + 1 ) > num_bits                                             ) continue;
+
+		if ( result != CRC_FIX_NONE ) return CRC_FIX_FAILED;
+
+		result         = CRC_FIX_DATA;
+		found_pattern  = pattern * 2 + 1;
+		found_distance = distance;
+	}
+
+	if ( result != CRC_FIX_DATA ) return ( result == CRC_FIX_CRC ) ? CRC_FIX_CRC : CRC_FIX_FAILED;
+
+	/*
+	 * Bit i of the pattern lies i bits before the bit at the found distance
+	 * from the end of the frame. The bits of a byte are sent with the least
+	 * significant bit first.
+	 */
+
+	for (i=0; i<32; i++) {
+
+		if ( ! ( found_pattern & ( 1ul << i ) ) ) continue;
+
+		pos = num_bits - 1 - found_distance - (uint64_t) i;
+		input_str[pos >> 3] ^= (unsigned char) ( 1u << ( pos & 7 ) );
+	}
+
+	return CRC_FIX_DATA;
+
+}  /* crc_32_fix */
+
+/*
+ * static int fix_compare( const void *a, const void *b );
+ *
+ * The function fix_compare() compares two table entries by syndrome for
+ * qsort().
+ */
+
+static int fix_compare( const void *a, const void *b ) {
+
+	uint32_t sa;
+	uint32_t sb;
+
+	sa = ( (const struct fix_entry *) a )->syndrome;
+	sb = ( (const struct fix_entry *) b )->syndrome;
+
+	return ( sa > sb ) - ( sa < sb );
+
+}  /* fix_compare */
+
+/*
+ * static bool fix_find( const struct crc_fix *fix, uint32_t syndrome, uint32_t *distance );
+ *
+ * The function fix_find() searches the sorted table for the syndrome of a
+ * single bit error. If it is found the distance of the bit to the end of the
+ * frame is stored and the function returns true.
+ */
+
+static bool fix_find( const struct crc_fix *fix, uint32_t syndrome, uint32_t *distance ) {
+
+	size_t low;
+	size_t high;
+	size_t mid;
+
+	low  = 0;
+	high = fix->num_entries;
+
+	while ( low < high ) {
+
+		mid = low + ( high - low ) / 2;
+
+		if ( fix->table[mid].syndrome < syndrome ) low  = mid + 1;
+		else                                       high = mid;
+	}
+
+	if ( low >= fix->num_entries  ||  fix->table[low].syndrome != syndrome ) return false;
+
+	*distance = fix->table[low].distance;
+
+	return true;
+
+}  /* fix_find */
+
+/*
+ * static int fix_degree( uint64_t value );
+ *
+ * The function fix_degree() returns the degree of a non zero polynomial with
+ * the coefficient of x^i in bit i.
+ */
+
+static int fix_degree( uint64_t value ) {
+
+	int degree;
+
+	for (degree=63; ! ( value & ( 1ull << degree ) ); degree--) ;
+
+	return degree;
+
+}  /* fix_degree */
+
+/*
+ * static uint32_t fix_inverse( uint32_t pattern );
+ *
+ * The function fix_inverse() calculates the inverse of a burst pattern modulo
+ * the CRC-32 polynomial with the extended Euclidean algorithm. The pattern has
+ * the coefficient of x^i in bit i, the inverse is returned in the reflected
+ * notation of the CRC-32.
+ */
+
+static uint32_t fix_inverse( uint32_t pattern ) {
+
+	int i;
+	int shift;
+	uint64_t r0;
+	uint64_t r1;
+	uint64_t s0;
+	uint64_t s1;
+	uint64_t swap;
+	uint32_t result;
+
+	r0 = 0x104C11DB7ull;
+	r1 = pattern;
+	s0 = 0;
+	s1 = 1;
+
+	while ( r1 != 1 ) {
+
+		while ( r0 != 0  &&  fix_degree( r0 ) >= fix_degree( r1 ) ) {
+
+			shift = fix_degree( r0 ) - fix_degree( r1 );
+			r0   ^= r1 << shift;
+			s0   ^= s1 << shift;
+		}
+
+		swap = r0; r0 = r1; r1 = swap;
+		swap = s0; s0 = s1; s1 = swap;
+	}
+
+	result = 0;
+
+	for (i=0; i<32; i++) if ( s1 & ( 1ull << i ) ) result |= FIX_ONE >> i;
+
+	return result;
+
+}  /* fix_inverse */
+
+/*
+ * static int fix_span( uint32_t value );
+ *
+ * The function fix_span() returns the number of bits from the lowest to the
+ * highest set bit of a non zero value.
+ */
+
+static int fix_span( uint32_t value ) {
+
+	int low;
+	int high;
+
+	for (low=0;   ! ( value & ( 1ul << low  ) ); low++ ) ;
+	for (high=31; ! ( value & ( 1ul << high ) ); high--) ;
+
+	return high - low + 1;
+
+}  /* fix_span */
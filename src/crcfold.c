@@ -0,0 +1,299 @@
+/*
+ * Library: libcrc
+ * File:    src/crcfold.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcfold.c contains the generic carry-less multiplication
+ * folding routines which are shared by the CRC algorithms. The routines are
+ * parameterized by a table of constants generated by precalc, so one routine
+ * serves all polynomials of the same bit order. The routines are only compiled
+ * on platforms with x86-64 SIMD support and are only called when the CPU
+ * detection has found the required instructions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_SIMD)
+
+#include <immintrin.h>
+
+/*
+ * uint64_t libcrc_fold_normal( const uint64_t *fold, uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function libcrc_fold_normal() updates the register of a CRC which is
+ * calculated with the most significant bit first with a block of data. The
+ * register is 64 bits wide. Narrower CRCs are passed in the upper bits of the
+ * register with a table of constants for the polynomial scaled to 64 bits.
+ *
+ * Each 16 byte block is loaded in reversed byte order, so that the first bit
+ * of the data becomes the highest power of x in the 128 bit register. Four
+ * accumulators are folded forward over 64 bytes per iteration. They are then
+ * folded into one accumulator which is reduced to the 64 bit CRC with a
+ * Barrett reduction. The block must be at least 64 bytes long. Only the part
+ * which is a multiple of 16 bytes is processed and the caller must process
+ * the remaining bytes.
+ */
+
+LIBCRC_TARGET("pclmul,ssse3,sse4.1") uint64_t libcrc_fold_normal( const uint64_t *fold, uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	__m128i k;
+	__m128i swap;
+	__m128i x1, x2, x3, x4;
+	__m128i x5, x6, x7, x8;
+	__m128i y5, y6, y7, y8;
+
+	num_bytes &= ~((size_t) 0x0F);
+	swap       = _mm_setr_epi8( 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 );
+
+	x1 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr +  0) ), swap );
+	x2 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 16) ), swap );
+	x3 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 32) ), swap );
+	x4 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 48) ), swap );
+
+	x1 = _mm_xor_si128( x1, _mm_set_epi64x( (long long) crc, 0 ) );
+	k  = _mm_loadu_si128( (const __m128i *) (fold + 0) );
+
+	ptr       += 64;
+	num_bytes -= 64;
+
+	/*
+	 * Fold the four accumulators forward over 64 bytes per iteration
+	 */
+
+	while ( num_bytes >= 64 ) {
+
+		x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+		x6 = _mm_clmulepi64_si128( x2, k, 0x00 );
+		x7 = _mm_clmulepi64_si128( x3, k, 0x00 );
+		x8 = _mm_clmulepi64_si128( x4, k, 0x00 );
+
+		x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+		x2 = _mm_clmulepi64_si128( x2, k, 0x11 );
+		x3 = _mm_clmulepi64_si128( x3, k, 0x11 );
+		x4 = _mm_clmulepi64_si128( x4, k, 0x11 );
+
+		y5 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr +  0) ), swap );
+		y6 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 16) ), swap );
+		y7 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 32) ), swap );
+		y8 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 48) ), swap );
+
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x5 ), y5 );
+		x2 = _mm_xor_si128( _mm_xor_si128( x2, x6 ), y6 );
+		x3 = _mm_xor_si128( _mm_xor_si128( x3, x7 ), y7 );
+		x4 = _mm_xor_si128( _mm_xor_si128( x4, x8 ), y8 );
+
+		ptr       += 64;
+		num_bytes -= 64;
+	}
+
+	/*
+	 * Fold the four accumulators into one and continue with single 128 bit
+	 * folds for the remaining 16 byte blocks
+	 */
+
+	k  = _mm_loadu_si128( (const __m128i *) (fold + 2) );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x5 );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x3 ), x5 );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x4 ), x5 );
+
+	while ( num_bytes >= 16 ) {
+
+		x2 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) ptr ), swap );
+
+		x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+		x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x5 );
+
+		ptr       += 16;
+		num_bytes -= 16;
+	}
+
+	/*
+	 * Multiply the accumulator by x^64 and reduce the high half, which leaves
+	 * a 128 bit value T with the same remainder as the CRC
+	 */
+
+	x2 = _mm_clmulepi64_si128( x1, k, 0x01 );
+	x1 = _mm_xor_si128( _mm_slli_si128( x1, 8 ), x2 );
+
+	/*
+	 * Barrett reduction of T to the 64 bit CRC. The quotient of the upper half
+	 * of T times x^64 divided by P is calculated with the constant
+	 * floor(x^128 / P) and the remainder is added to the lower half of T.
+	 */
+
+	k  = _mm_loadu_si128( (const __m128i *) (fold + 4) );
+
+	x2 = _mm_clmulepi64_si128( x1, k, 0x01 );
+	x2 = _mm_xor_si128( _mm_srli_si128( x2, 8 ), _mm_srli_si128( x1, 8 ) );
+	x2 = _mm_clmulepi64_si128( x2, k, 0x10 );
+	x1 = _mm_xor_si128( x1, x2 );
+
+	return (uint64_t) _mm_cvtsi128_si64( x1 );
+
+}  /* libcrc_fold_normal */
+
+/*
+ * uint64_t libcrc_fold_reflected( const uint64_t *fold, uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function libcrc_fold_reflected() updates the register of a CRC which is
+ * calculated with the least significant bit first with a block of data. The
+ * register is 64 bits wide. Narrower CRCs are passed in the lower bits of the
+ * register with a table of constants for the polynomial scaled to 64 bits.
+ *
+ * The data is loaded in normal byte order, which puts the first bit of the
+ * data in the lowest bit of the 128 bit register. The folding is the same as
+ * in libcrc_fold_normal(), but the roles of the lower and upper halves of the
+ * registers are exchanged. The Barrett reduction corrects for the extra
+ * factor x in the products of reflected values. The block must be at least 64
+ * bytes long. Only the part which is a multiple of 16 bytes is processed and
+ * the caller must process the remaining bytes.
+ */
+
+LIBCRC_TARGET("pclmul,sse4.1") uint64_t libcrc_fold_reflected( const uint64_t *fold, uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	__m128i k;
+	__m128i x1, x2, x3, x4;
+	__m128i x5, x6, x7, x8;
+	__m128i y5, y6, y7, y8;
+
+	num_bytes &= ~((size_t) 0x0F);
+
+	x1 = _mm_loadu_si128( (const __m128i *) (ptr +  0) );
+	x2 = _mm_loadu_si128( (const __m128i *) (ptr + 16) );
+	x3 = _mm_loadu_si128( (const __m128i *) (ptr + 32) );
+	x4 = _mm_loadu_si128( (const __m128i *) (ptr + 48) );
+
+	x1 = _mm_xor_si128( x1, _mm_cvtsi64_si128( (long long) crc ) );
+	k  = _mm_loadu_si128( (const __m128i *) (fold + 0) );
+
+	ptr       += 64;
+	num_bytes -= 64;
+
+	/*
+	 * Fold the four accumulators forward over 64 bytes per iteration
+	 */
+
+	while ( num_bytes >= 64 ) {
+
+		x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+		x6 = _mm_clmulepi64_si128( x2, k, 0x00 );
+		x7 = _mm_clmulepi64_si128( x3, k, 0x00 );
+		x8 = _mm_clmulepi64_si128( x4, k, 0x00 );
+
+		x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+		x2 = _mm_clmulepi64_si128( x2, k, 0x11 );
+		x3 = _mm_clmulepi64_si128( x3, k, 0x11 );
+		x4 = _mm_clmulepi64_si128( x4, k, 0x11 );
+
+		y5 = _mm_loadu_si128( (const __m128i *) (ptr +  0) );
+		y6 = _mm_loadu_si128( (const __m128i *) (ptr + 16) );
+		y7 = _mm_loadu_si128( (const __m128i *) (ptr + 32) );
+		y8 = _mm_loadu_si128( (const __m128i *) (ptr + 48) );
+
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x5 ), y5 );
+		x2 = _mm_xor_si128( _mm_xor_si128( x2, x6 ), y6 );
+		x3 = _mm_xor_si128( _mm_xor_si128( x3, x7 ), y7 );
+		x4 = _mm_xor_si128( _mm_xor_si128( x4, x8 ), y8 );
+
+		ptr       += 64;
+		num_bytes -= 64;
+	}
+
+	/*
+	 * Fold the four accumulators into one and continue with single 128 bit
+	 * folds for the remaining 16 byte blocks
+	 */
+
+	k  = _mm_loadu_si128( (const __m128i *) (fold + 2) );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x5 );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x3 ), x5 );
+
+	x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x4 ), x5 );
+
+	while ( num_bytes >= 16 ) {
+
+		x2 = _mm_loadu_si128( (const __m128i *) ptr );
+
+		x5 = _mm_clmulepi64_si128( x1, k, 0x00 );
+		x1 = _mm_clmulepi64_si128( x1, k, 0x11 );
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x5 );
+
+		ptr       += 16;
+		num_bytes -= 16;
+	}
+
+	/*
+	 * Multiply the accumulator by x^64 and reduce the high order half, which
+	 * leaves a 128 bit value T with the same remainder as the CRC. The high
+	 * order half of T is in the lower 64 bits of the register.
+	 */
+
+	x2 = _mm_clmulepi64_si128( x1, k, 0x10 );
+	x1 = _mm_xor_si128( _mm_srli_si128( x1, 8 ), x2 );
+
+	/*
+	 * Barrett reduction of T to the 64 bit CRC. The reflected products are
+	 * shifted one bit to the left for the quotient and 63 bits to the right
+	 * for the remainder, which ends up in the upper 64 bits of the register.
+	 */
+
+	k  = _mm_loadu_si128( (const __m128i *) (fold + 4) );
+
+	x2 = _mm_clmulepi64_si128( x1, k, 0x00 );
+	x2 = _mm_xor_si128( _mm_slli_epi64( x2, 1 ), x1 );
+	x2 = _mm_clmulepi64_si128( x2, k, 0x10 );
+	x3 = _mm_slli_si128( _mm_srli_epi64( x2, 63 ), 8 );
+	x2 = _mm_slli_epi64( x2, 1 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x3 );
+
+	return (uint64_t) _mm_extract_epi64( x1, 1 );
+
+}  /* libcrc_fold_reflected */
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Library: libcrc
+ * File:    src/crcint.h
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The header file src/crcint.h contains definitions and prototypes which are
+ * shared between the source files of the libcrc library, but which are not
+ * part of the public interface of the library.
+ */
+
+#ifndef DEF_LIBCRC_CRCINT_H
+#define DEF_LIBCRC_CRCINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * #define LIBCRC_X86_SIMD
+ *
+ * The constant LIBCRC_X86_SIMD is defined when the library is compiled with a
+ * compiler which supports the x86-64 SIMD intrinsics with per function target
+ * attributes. The SIMD routines are compiled in the library in that case, but
+ * they are only used when the CPU detection at startup has found the required
+ * instruction set extensions. No special compiler flags are needed. Defining
+ * LIBCRC_NO_SIMD at compile time builds the library with only the portable
+ * routines.
+ */
+
+#if defined(__GNUC__)  &&  defined(__x86_64__)  &&  ! defined(LIBCRC_NO_SIMD)
+#define LIBCRC_X86_SIMD
+#define LIBCRC_TARGET(x)	__attribute__((target(x)))
+#define LIBCRC_STARTUP		__attribute__((constructor))
+#endif
+
+/*
+ * #define LIBCRC_THREADS
+ *
+ * The constant LIBCRC_THREADS is defined when the library is compiled on a
+ * platform with POSIX threads. It enables the multi threaded routines and the
+ * locking of shared data. Defining LIBCRC_NO_THREADS at compile time builds
+ * the library without thread support.
+ */
+
+#if ! defined(_WIN32)  &&  ! defined(LIBCRC_NO_THREADS)
+#define LIBCRC_THREADS
+#include <pthread.h>
+#endif
+
+/*
+ * #define LIBCRC_CPU_xxxx
+ *
+ * The constants of the form LIBCRC_CPU_xxxx are the flags returned by the
+ * function libcrc_cpu_features() for the instruction set extensions which are
+ * used by the optimized routines in the library.
+ */
+
+#define		LIBCRC_CPU_SSSE3	0x0001u
+#define		LIBCRC_CPU_SSE41	0x0002u
+#define		LIBCRC_CPU_SSE42	0x0004u
+#define		LIBCRC_CPU_PCLMUL	0x0008u
+
+/*
+ * #define LOAD_BE64( ptr )
+ *
+ * The macro LOAD_BE64() reads eight bytes as a big endian 64 bit word, with
+ * the first byte in the highest byte of the word. This is the order in which
+ * the CRC routines with the most significant bit first process the data. The
+ * bytes are read individually to be independent of the endianness and
+ * alignment requirements of the platform.
+ */
+
+#define LOAD_BE64(ptr)	(   ( (uint64_t) (ptr)[0] << 56 ) | ( (uint64_t) (ptr)[1] << 48 )	\
+			  | ( (uint64_t) (ptr)[2] << 40 ) | ( (uint64_t) (ptr)[3] << 32 )	\
+			  | ( (uint64_t) (ptr)[4] << 24 ) | ( (uint64_t) (ptr)[5] << 16 )	\
+			  | ( (uint64_t) (ptr)[6] <<  8 ) | ( (uint64_t) (ptr)[7]       ) )
+
+/*
+ * #define LOAD_LE64( ptr )
+ *
+ * The macro LOAD_LE64() reads eight bytes as a little endian 64 bit word, with
+ * the first byte in the lowest byte of the word. This is the order in which
+ * the reflected CRC routines process the data.
+ */
+
+#define LOAD_LE64(ptr)	(   ( (uint64_t) (ptr)[7] << 56 ) | ( (uint64_t) (ptr)[6] << 48 )	\
+			  | ( (uint64_t) (ptr)[5] << 40 ) | ( (uint64_t) (ptr)[4] << 32 )	\
+			  | ( (uint64_t) (ptr)[3] << 24 ) | ( (uint64_t) (ptr)[2] << 16 )	\
+			  | ( (uint64_t) (ptr)[1] <<  8 ) | ( (uint64_t) (ptr)[0]       ) )
+
+/*
+ * #define SWAP16( crc )
+ *
+ * The macro SWAP16() swaps the two bytes of a 16 bit CRC value. It is used for
+ * the algorithms which return the CRC in reversed byte order.
+ */
+
+#define SWAP16(crc)	((uint16_t) ( ( ((crc) & 0xFF00) >> 8 ) | ( ((crc) & 0x00FF) << 8 ) ))
+
+/*
+ * struct libcrc_poly
+ *
+ * The structure libcrc_poly describes a CRC polynomial for the arithmetic in
+ * GF(2) modulo that polynomial. The polynomial is stored in the notation of
+ * the CRC routines without the leading term. The powers table contains the
+ * values x^(8*2^k) mod P for k = 0..63 in the same notation.
+ */
+
+							/************************************************/
+struct libcrc_poly {					/*						*/
+	uint64_t		poly;			/* The polynomial without the leading term	*/
+	int			bits;			/* The width of the CRC in bits			*/
+	bool			reflected;		/* The CRC is calculated with reflected bits	*/
+	const uint64_t *	powers;			/* Table with the powers x^(8*2^k) mod P	*/
+};							/*						*/
+							/************************************************/
+
+/*
+ * struct libcrc_crc8
+ *
+ * The structure libcrc_crc8 describes one polynomial of the CRC-8 family with
+ * generated tables. Its contents are private to src/crc8.c.
+ */
+
+struct libcrc_crc8;
+
+/*
+ * Prototype list of internal functions
+ */
+
+unsigned int		libcrc_cpu_features( void );
+uint8_t			libcrc_crc8_block( const struct libcrc_crc8 *family, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+const struct libcrc_crc8 *libcrc_crc8_find( uint8_t poly, bool reflected );
+int			libcrc_nmea_hex( unsigned char c );
+size_t			libcrc_nmea_payload( const unsigned char *ptr, size_t num_bytes, unsigned char *checksum );
+size_t			libcrc_nmea_start( const unsigned char *ptr, size_t num_bytes );
+uint64_t		libcrc_multiply( const struct libcrc_poly *poly, uint64_t a, uint64_t b );
+uint64_t		libcrc_shift( const struct libcrc_poly *poly, uint64_t crc, uint64_t num_units );
+
+#if defined(LIBCRC_X86_SIMD)
+uint64_t		libcrc_fold_normal( const uint64_t *fold, uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+uint64_t		libcrc_fold_reflected( const uint64_t *fold, uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+#endif
+
+/*
+ * Lookup tables generated by precalc which are shared between source files
+ */
+
+extern const uint8_t	crc_tab8[256];
+extern const uint16_t	crc_tab16[256];
+extern const uint16_t	crc_tabccitt[256];
+extern const uint16_t	crc_tabdnp[256];
+extern const uint16_t	crc_tabkermit[256];
+extern const uint32_t	crc_tab32_slice[16][256];
+extern const uint32_t	crc_tab32c_slice[8][256];
+extern const uint64_t	crc_tab64_slice[8][256];
+
+/*
+ * Polynomial descriptors of the CRC algorithms in the library
+ */
+
+extern const struct libcrc_poly	libcrc_poly_8;
+extern const struct libcrc_poly	libcrc_poly_16;
+extern const struct libcrc_poly	libcrc_poly_ccitt;
+extern const struct libcrc_poly	libcrc_poly_kermit;
+extern const struct libcrc_poly	libcrc_poly_dnp;
+extern const struct libcrc_poly	libcrc_poly_sick;
+extern const struct libcrc_poly	libcrc_poly_32;
+extern const struct libcrc_poly	libcrc_poly_32c;
+extern const struct libcrc_poly	libcrc_poly_64;
+
+#endif  // DEF_LIBCRC_CRCINT_H
@@ -0,0 +1,126 @@
+/*
+ * Library: libcrc
+ * File:    src/crciov.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crciov.c contains routines to calculate the CRC of data
+ * which is scattered over several buffers, described by an array of iovec
+ * structures as used by readv() and writev(). The typical case is a frame in
+ * a circular receive buffer which wraps around at the end of the buffer. The
+ * buffers are passed to the same fast routines as the one pass functions
+ * without copying them. Only small buffers, like the short fragments of a
+ * chain of network buffers, are first joined in a bridge buffer on the stack.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+
+#define IOV_BRIDGE_SIZE		256
+
+static uint64_t		iov_calc( int type, const struct iovec *iov, int iovcnt );
+
+/*
+ * uintXX_t crc_xxx_iov( const struct iovec *iov, int iovcnt );
+ *
+ * The functions of the form crc_xxx_iov() calculate the CRC of the
+ * concatenation of iovcnt buffers described by the array iov. The result is
+ * the same as the one pass function crc_xxx() would return for the data in
+ * one contiguous buffer.
+ */
+
+uint8_t  crc_8_iov(          const struct iovec *iov, int iovcnt ) { return (uint8_t)  iov_calc( CRC_TYPE_8,          iov, iovcnt ); }
+uint16_t crc_16_iov(         const struct iovec *iov, int iovcnt ) { return (uint16_t) iov_calc( CRC_TYPE_16,         iov, iovcnt ); }
+uint16_t crc_modbus_iov(     const struct iovec *iov, int iovcnt ) { return (uint16_t) iov_calc( CRC_TYPE_MODBUS,     iov, iovcnt ); }
+uint16_t crc_xmodem_iov(     const struct iovec *iov, int iovcnt ) { return (uint16_t) iov_calc( CRC_TYPE_XMODEM,     iov, iovcnt ); }
+uint16_t crc_ccitt_1d0f_iov( const struct iovec *iov, int iovcnt ) { return (uint16_t) iov_calc( CRC_TYPE_CCITT_1D0F, iov, iovcnt ); }
+uint16_t crc_ccitt_ffff_iov( const struct iovec *iov, int iovcnt ) { return (uint16_t) iov_calc( CRC_TYPE_CCITT_FFFF, iov, iovcnt ); }
+uint16_t crc_kermit_iov(     const struct iovec *iov, int iovcnt ) { return (uint16_t) iov_calc( CRC_TYPE_KERMIT,     iov, iovcnt ); }
+uint16_t crc_sick_iov(       const struct iovec *iov, int iovcnt ) { return (uint16_t) iov_calc( CRC_TYPE_SICK,       iov, iovcnt ); }
+uint16_t crc_dnp_iov(        const struct iovec *iov, int iovcnt ) { return (uint16_t) iov_calc( CRC_TYPE_DNP,        iov, iovcnt ); }
+uint32_t crc_32_iov(         const struct iovec *iov, int iovcnt ) { return (uint32_t) iov_calc( CRC_TYPE_32,         iov, iovcnt ); }
+uint32_t crc_32c_iov(        const struct iovec *iov, int iovcnt ) { return (uint32_t) iov_calc( CRC_TYPE_32C,        iov, iovcnt ); }
+uint64_t crc_64_ecma_iov(    const struct iovec *iov, int iovcnt ) { return            iov_calc( CRC_TYPE_64_ECMA,    iov, iovcnt ); }
+uint64_t crc_64_we_iov(      const struct iovec *iov, int iovcnt ) { return            iov_calc( CRC_TYPE_64_WE,      iov, iovcnt ); }
+
+/*
+ * static uint64_t iov_calc( int type, const struct iovec *iov, int iovcnt );
+ *
+ * The function iov_calc() calculates the CRC of algorithm type over the
+ * buffers in iov. Large buffers are passed directly to the streaming routines.
+ * Small buffers are collected in the bridge buffer and passed as one block
+ * when the next buffer does not fit anymore, because every call of the fast
+ * routines has a fixed cost which is high compared to a copy of a few bytes.
+ */
+
+static uint64_t iov_calc( int type, const struct iovec *iov, int iovcnt ) {
+
+	int a;
+	size_t len;
+	size_t fill;
+	const unsigned char *ptr;
+	unsigned char bridge[IOV_BRIDGE_SIZE];
+	struct crc_ctx ctx;
+
+	crc_ctx_init( & ctx, type );
+
+	if ( iov == NULL ) iovcnt = 0;
+
+	fill = 0;
+
+	for (a=0; a<iovcnt; a++) {
+
+		ptr = iov[a].iov_base;
+		len = iov[a].iov_len;
+
+		if ( ptr == NULL  ||  len == 0 ) continue;
+
+		if ( len <= IOV_BRIDGE_SIZE - fill ) {
+
+			memcpy( bridge + fill, ptr, len );
+			fill += len;
+			continue;
+		}
+
+		crc_ctx_update( & ctx, bridge, fill );
+		fill = 0;
+
+		if ( len <= IOV_BRIDGE_SIZE ) {
+
+			memcpy( bridge, ptr, len );
+			fill = len;
+		}
+
+		else crc_ctx_update( & ctx, ptr, len );
+	}
+
+	crc_ctx_update( & ctx, bridge, fill );
+
+	return crc_ctx_final( & ctx );
+
+}  /* iov_calc */
@@ -31,14 +31,32 @@
  * Kermit cyclic redundancy check value for an incomming byte string.
  */
 
-#include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
 
-static void		init_crc_tab( void );
+static uint16_t		crckrmit_table(  uint16_t crc, const unsigned char *ptr, size_t num_bytes );
 
-static bool		crc_tab_init		= false;
-static uint16_t		crc_tab[256];
+#if defined(LIBCRC_X86_SIMD)
+static uint16_t		crckrmit_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crckrmit_select( void );
+#endif
+
+/*
+ * Include the lookup table for the Kermit CRC calculation
+ */
+
+#include "../tab/gentabkrm.inc"
+
+/*
+ * static uint16_t (*crckrmit_block)( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function pointer crckrmit_block points to the fastest routine available
+ * on the current CPU to update a Kermit CRC value with a block of bytes. It is
+ * changed only once at program startup by crckrmit_select().
+ */
+
+static uint16_t		(*crckrmit_block)( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) = crckrmit_table;
 
 /*
  * uint16_t crc_kermit( const unsigned char *input_str, size_t num_bytes );
@@ -53,18 +71,8 @@ uint16_t crc_kermit( const unsigned char *input_str, size_t num_bytes ) {
 	uint16_t crc;
 	uint16_t low_byte;
 	uint16_t high_byte;
-	const unsigned char *ptr;
-	size_t a;
-
-	if ( ! crc_tab_init ) init_crc_tab();
 
-	crc = CRC_START_KERMIT;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc >> 8) ^ crc_tab[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
+	crc = update_crc_kermit_block( CRC_START_KERMIT, input_str, num_bytes );
 
 	low_byte  = (crc & 0xff00) >> 8;
 	high_byte = (crc & 0x00ff) << 8;
@@ -83,44 +91,87 @@ uint16_t crc_kermit( const unsigned char *input_str, size_t num_bytes ) {
 
 uint16_t update_crc_kermit( uint16_t crc, unsigned char c ) {
 
-	if ( ! crc_tab_init ) init_crc_tab();
-
-	return (crc >> 8) ^ crc_tab[ (crc ^ (uint16_t) c) & 0x00FF ];
+	return (crc >> 8) ^ crc_tabkermit[ (crc ^ (uint16_t) c) & 0x00FF ];
 
 }  /* update_crc_kermit */
 
 /*
- * static void init_crc_tab( void );
+ * uint16_t update_crc_kermit_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes );
  *
- * For optimal performance, the  CRC Kermit routine uses a lookup table with
- * values that can be used directly in the XOR arithmetic in the algorithm.
- * This lookup table is calculated by the init_crc_tab() routine, the first
- * time the CRC function is called.
+ * The function update_crc_kermit_block() calculates a new CRC Kermit value
+ * based on the previous value of the CRC and a block of data to be checked.
+ * The bytes of the result are not swapped.
  */
 
-static void init_crc_tab( void ) {
+uint16_t update_crc_kermit_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes ) {
 
-	uint16_t i;
-	uint16_t j;
-	uint16_t crc;
-	uint16_t c;
+	if ( input_str == NULL ) return crc;
 
-	for (i=0; i<256; i++) {
+	return crckrmit_block( crc, input_str, num_bytes );
 
-		crc = 0;
-		c   = i;
+}  /* update_crc_kermit_block */
 
-		for (j=0; j<8; j++) {
+/*
+ * static uint16_t crckrmit_table( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crckrmit_table() is the portable routine to update a Kermit CRC
+ * value with a block of bytes, one byte per iteration.
+ */
 
-			if ( (crc ^ c) & 0x0001 ) crc = ( crc >> 1 ) ^ CRC_POLY_KERMIT;
-			else                      crc =   crc >> 1;
+static uint16_t crckrmit_table( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-			c = c >> 1;
-		}
+	while ( num_bytes > 0 ) {
 
-		crc_tab[i] = crc;
+		crc = (crc >> 8) ^ crc_tabkermit[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
+		num_bytes--;
 	}
 
-	crc_tab_init = true;
+	return crc;
+
+}  /* crckrmit_table */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static void crckrmit_select( void );
+ *
+ * The function crckrmit_select() is called once at program startup. It selects
+ * the carry-less multiplication routine if the CPU supports the PCLMULQDQ and
+ * SSE4.1 instructions.
+ */
+
+static LIBCRC_STARTUP void crckrmit_select( void ) {
+
+	unsigned int features;
+
+	features = libcrc_cpu_features();
+
+	if ( ( features & LIBCRC_CPU_PCLMUL )  &&  ( features & LIBCRC_CPU_SSE41 ) ) crckrmit_block = crckrmit_pclmul;
+
+}  /* crckrmit_select */
+
+/*
+ * static uint16_t crckrmit_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crckrmit_pclmul() updates a Kermit CRC value with the generic
+ * folding routine libcrc_fold_reflected() for CRCs which are calculated with
+ * the least significant bit first. The CRC is passed in the lower 16 bits of
+ * the 64 bit register of the folding routine. Blocks shorter than 64 bytes and
+ * the tail of the block which is not a multiple of 16 bytes are handled by the
+ * table driven routine.
+ */
+
+static uint16_t crckrmit_pclmul( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t num_fold;
+
+	if ( num_bytes < 64 ) return crckrmit_table( crc, ptr, num_bytes );
+
+	num_fold = num_bytes & ~((size_t) 0x0F);
+	crc      = (uint16_t) libcrc_fold_reflected( crc_tabkermit_fold, crc, ptr, num_fold );
+
+	return crckrmit_table( crc, ptr + num_fold, num_bytes - num_fold );
+
+}  /* crckrmit_pclmul */
 
-}  /* init_crc_tab */
+#endif
@@ -0,0 +1,827 @@
+/*
+ * Library: libcrc
+ * File:    src/crcmodel.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcmodel.c contains a generic CRC engine which
+ * calculates any CRC algorithm that can be described with the parameters of
+ * the Rocksoft model: the width, polynomial, start value, reflection of the
+ * input and output and the final XOR value. A catalogue with the parameters of
+ * the common CRC algorithms is included.
+ *
+ * Parameter sets which are also implemented by the dedicated routines of the
+ * library are calculated with those routines, including their SIMD versions.
+ * For all other parameter sets slicing-by-8 lookup tables are calculated on
+ * first use. The tables only depend on the width, the polynomial and the
+ * reflection of the input, and they are shared by all models with the same
+ * values in a registry which is protected against concurrent access.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#define MODEL_SLICES		8
+
+/*
+ * struct model_engine
+ *
+ * The structure model_engine contains the slicing-by-8 lookup tables for one
+ * combination of width, polynomial and input reflection. The engines are kept
+ * in a linked list and are never released.
+ */
+
+							/************************************************/
+struct model_engine {					/*						*/
+	int			width;			/* The width of the CRC in bits			*/
+	uint64_t		poly;			/* The polynomial in normal notation		*/
+	bool			refin;			/* The input bytes are reflected		*/
+	struct model_engine *	next;			/* The next engine in the registry		*/
+	uint64_t		table[MODEL_SLICES][256]; /* The slicing-by-8 lookup tables		*/
+};							/*						*/
+							/************************************************/
+
+/*
+ * struct model_fast
+ *
+ * The structure model_fast links a combination of width, polynomial and input
+ * reflection to the dedicated block routine of the library for that CRC.
+ */
+
+							/************************************************/
+struct model_fast {					/*						*/
+	int			width;			/* The width of the CRC in bits			*/
+	uint64_t		poly;			/* The polynomial in normal notation		*/
+	bool			refin;			/* The input bytes are reflected		*/
+	uint64_t		(*block)( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+};							/*						*/
+							/************************************************/
+
+/*
+ * struct model_alias
+ *
+ * The structure model_alias links an alternative name of a CRC algorithm to
+ * its name in the catalogue.
+ */
+
+							/************************************************/
+struct model_alias {					/*						*/
+	const char *		alias;			/* The alternative name				*/
+	const char *		name;			/* The name in the catalogue			*/
+};							/*						*/
+							/************************************************/
+
+static uint64_t			engine_bitwise( const struct crc_model *model, uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t			engine_block(   const struct model_engine *engine, uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static struct model_engine *	engine_create(  int width, uint64_t poly, bool refin );
+static struct model_engine *	engine_find(    struct model_engine *engine, int width, uint64_t poly, bool refin );
+static struct model_engine *	engine_get(     const struct crc_model *model );
+static uint64_t			fast_16(     uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t			fast_32(     uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t			fast_32c(    uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t			fast_64(     uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t			fast_ccitt(  uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t			fast_dnp(    uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t			fast_kermit( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static uint64_t			model_mask(    int width );
+static bool			model_name_eq( const char *name1, const char *name2 );
+static uint64_t			model_reflect( uint64_t val, int width );
+
+/*
+ * static const struct crc_model model_list[];
+ *
+ * The catalogue with the parameters of the common CRC algorithms. The names
+ * and parameters follow the catalogue of parametrised CRC algorithms by Greg
+ * Cook. The entries are sorted on width and name.
+ */
+
+static const struct crc_model model_list[] = {
+	{ "CRC-3/GSM",          3, 0x3ull,                0x0ull,                false, false, 0x7ull,                0x4ull },
+	{ "CRC-3/ROHC",         3, 0x3ull,                0x7ull,                true,  true,  0x0ull,                0x6ull },
+	{ "CRC-4/G-704",        4, 0x3ull,                0x0ull,                true,  true,  0x0ull,                0x7ull },
+	{ "CRC-4/INTERLAKEN",   4, 0x3ull,                0xFull,                false, false, 0xFull,                0xBull },
+	{ "CRC-5/EPC-C1G2",     5, 0x09ull,               0x09ull,               false, false, 0x00ull,               0x00ull },
+	{ "CRC-5/G-704",        5, 0x15ull,               0x00ull,               true,  true,  0x00ull,               0x07ull },
+	{ "CRC-5/USB",          5, 0x05ull,               0x1Full,               true,  true,  0x1Full,               0x19ull },
+	{ "CRC-6/CDMA2000-A",   6, 0x27ull,               0x3Full,               false, false, 0x00ull,               0x0Dull },
+	{ "CRC-6/G-704",        6, 0x03ull,               0x00ull,               true,  true,  0x00ull,               0x06ull },
+	{ "CRC-7/MMC",          7, 0x09ull,               0x00ull,               false, false, 0x00ull,               0x75ull },
+	{ "CRC-7/ROHC",         7, 0x4Full,               0x7Full,               true,  true,  0x00ull,               0x53ull },
+	{ "CRC-8/AUTOSAR",      8, 0x2Full,               0xFFull,               false, false, 0xFFull,               0xDFull },
+	{ "CRC-8/BLUETOOTH",    8, 0xA7ull,               0x00ull,               true,  true,  0x00ull,               0x26ull },
+	{ "CRC-8/CDMA2000",     8, 0x9Bull,               0xFFull,               false, false, 0x00ull,               0xDAull },
+	{ "CRC-8/DVB-S2",       8, 0xD5ull,               0x00ull,               false, false, 0x00ull,               0xBCull },
+	{ "CRC-8/I-432-1",      8, 0x07ull,               0x00ull,               false, false, 0x55ull,               0xA1ull },
+	{ "CRC-8/I-CODE",       8, 0x1Dull,               0xFDull,               false, false, 0x00ull,               0x7Eull },
+	{ "CRC-8/MAXIM-DOW",    8, 0x31ull,               0x00ull,               true,  true,  0x00ull,               0xA1ull },
+	{ "CRC-8/NRSC-5",       8, 0x31ull,               0xFFull,               false, false, 0x00ull,               0xF7ull },
+	{ "CRC-8/ROHC",         8, 0x07ull,               0xFFull,               true,  true,  0x00ull,               0xD0ull },
+	{ "CRC-8/SAE-J1850",    8, 0x1Dull,               0xFFull,               false, false, 0xFFull,               0x4Bull },
+	{ "CRC-8/SMBUS",        8, 0x07ull,               0x00ull,               false, false, 0x00ull,               0xF4ull },
+	{ "CRC-8/WCDMA",        8, 0x9Bull,               0x00ull,               true,  true,  0x00ull,               0x25ull },
+	{ "CRC-10/ATM",        10, 0x233ull,              0x000ull,              false, false, 0x000ull,              0x199ull },
+	{ "CRC-10/CDMA2000",   10, 0x3D9ull,              0x3FFull,              false, false, 0x000ull,              0x233ull },
+	{ "CRC-11/FLEXRAY",    11, 0x385ull,              0x01Aull,              false, false, 0x000ull,              0x5A3ull },
+	{ "CRC-12/CDMA2000",   12, 0xF13ull,              0xFFFull,              false, false, 0x000ull,              0xD4Dull },
+	{ "CRC-12/DECT",       12, 0x80Full,              0x000ull,              false, false, 0x000ull,              0xF5Bull },
+	{ "CRC-12/UMTS",       12, 0x80Full,              0x000ull,              false, true,  0x000ull,              0xDAFull },
+	{ "CRC-13/BBC",        13, 0x1CF5ull,             0x0000ull,             false, false, 0x0000ull,             0x04FAull },
+	{ "CRC-14/DARC",       14, 0x0805ull,             0x0000ull,             true,  true,  0x0000ull,             0x082Dull },
+	{ "CRC-15/CAN",        15, 0x4599ull,             0x0000ull,             false, false, 0x0000ull,             0x059Eull },
+	{ "CRC-15/MPT1327",    15, 0x6815ull,             0x0000ull,             false, false, 0x0001ull,             0x2566ull },
+	{ "CRC-16/ARC",        16, 0x8005ull,             0x0000ull,             true,  true,  0x0000ull,             0xBB3Dull },
+	{ "CRC-16/CDMA2000",   16, 0xC867ull,             0xFFFFull,             false, false, 0x0000ull,             0x4C06ull },
+	{ "CRC-16/DDS-110",    16, 0x8005ull,             0x800Dull,             false, false, 0x0000ull,             0x9ECFull },
+	{ "CRC-16/DECT-X",     16, 0x0589ull,             0x0000ull,             false, false, 0x0000ull,             0x007Full },
+	{ "CRC-16/DNP",        16, 0x3D65ull,             0x0000ull,             true,  true,  0xFFFFull,             0xEA82ull },
+	{ "CRC-16/EN-13757",   16, 0x3D65ull,             0x0000ull,             false, false, 0xFFFFull,             0xC2B7ull },
+	{ "CRC-16/GENIBUS",    16, 0x1021ull,             0xFFFFull,             false, false, 0xFFFFull,             0xD64Eull },
+	{ "CRC-16/IBM-3740",   16, 0x1021ull,             0xFFFFull,             false, false, 0x0000ull,             0x29B1ull },
+	{ "CRC-16/IBM-SDLC",   16, 0x1021ull,             0xFFFFull,             true,  true,  0xFFFFull,             0x906Eull },
+	{ "CRC-16/KERMIT",     16, 0x1021ull,             0x0000ull,             true,  true,  0x0000ull,             0x2189ull },
+	{ "CRC-16/MAXIM-DOW",  16, 0x8005ull,             0x0000ull,             true,  true,  0xFFFFull,             0x44C2ull },
+	{ "CRC-16/MCRF4XX",    16, 0x1021ull,             0xFFFFull,             true,  true,  0x0000ull,             0x6F91ull },
+	{ "CRC-16/MODBUS",     16, 0x8005ull,             0xFFFFull,             true,  true,  0x0000ull,             0x4B37ull },
+	{ "CRC-16/SPI-FUJITSU", 16, 0x1021ull,             0x1D0Full,             false, false, 0x0000ull,             0xE5CCull },
+	{ "CRC-16/T10-DIF",    16, 0x8BB7ull,             0x0000ull,             false, false, 0x0000ull,             0xD0DBull },
+	{ "CRC-16/TELEDISK",   16, 0xA097ull,             0x0000ull,             false, false, 0x0000ull,             0x0FB3ull },
+	{ "CRC-16/UMTS",       16, 0x8005ull,             0x0000ull,             false, false, 0x0000ull,             0xFEE8ull },
+	{ "CRC-16/USB",        16, 0x8005ull,             0xFFFFull,             true,  true,  0xFFFFull,             0xB4C8ull },
+	{ "CRC-16/XMODEM",     16, 0x1021ull,             0x0000ull,             false, false, 0x0000ull,             0x31C3ull },
+	{ "CRC-17/CAN-FD",     17, 0x1685Bull,            0x00000ull,            false, false, 0x00000ull,            0x04F03ull },
+	{ "CRC-21/CAN-FD",     21, 0x102899ull,           0x000000ull,           false, false, 0x000000ull,           0x0ED841ull },
+	{ "CRC-24/BLE",        24, 0x00065Bull,           0x555555ull,           true,  true,  0x000000ull,           0xC25A56ull },
+	{ "CRC-24/FLEXRAY-A",  24, 0x5D6DCBull,           0xFEDCBAull,           false, false, 0x000000ull,           0x7979BDull },
+	{ "CRC-24/LTE-A",      24, 0x864CFBull,           0x000000ull,           false, false, 0x000000ull,           0xCDE703ull },
+	{ "CRC-24/LTE-B",      24, 0x800063ull,           0x000000ull,           false, false, 0x000000ull,           0x23EF52ull },
+	{ "CRC-24/OPENPGP",    24, 0x864CFBull,           0xB704CEull,           false, false, 0x000000ull,           0x21CF02ull },
+	{ "CRC-30/CDMA",       30, 0x2030B9C7ull,         0x3FFFFFFFull,         false, false, 0x3FFFFFFFull,         0x04C34ABFull },
+	{ "CRC-31/PHILIPS",    31, 0x04C11DB7ull,         0x7FFFFFFFull,         false, false, 0x7FFFFFFFull,         0x0CE9E46Cull },
+	{ "CRC-32/AIXM",       32, 0x814141ABull,         0x00000000ull,         false, false, 0x00000000ull,         0x3010BF7Full },
+	{ "CRC-32/AUTOSAR",    32, 0xF4ACFB13ull,         0xFFFFFFFFull,         true,  true,  0xFFFFFFFFull,         0x1697D06Aull },
+	{ "CRC-32/BASE91-D",   32, 0xA833982Bull,         0xFFFFFFFFull,         true,  true,  0xFFFFFFFFull,         0x87315576ull },
+	{ "CRC-32/BZIP2",      32, 0x04C11DB7ull,         0xFFFFFFFFull,         false, false, 0xFFFFFFFFull,         0xFC891918ull },
+	{ "CRC-32/CD-ROM-EDC", 32, 0x8001801Bull,         0x00000000ull,         true,  true,  0x00000000ull,         0x6EC2EDC4ull },
+	{ "CRC-32/CKSUM",      32, 0x04C11DB7ull,         0x00000000ull,         false, false, 0xFFFFFFFFull,         0x765E7680ull },
+	{ "CRC-32/ISCSI",      32, 0x1EDC6F41ull,         0xFFFFFFFFull,         true,  true,  0xFFFFFFFFull,         0xE3069283ull },
+	{ "CRC-32/ISO-HDLC",   32, 0x04C11DB7ull,         0xFFFFFFFFull,         true,  true,  0xFFFFFFFFull,         0xCBF43926ull },
+	{ "CRC-32/JAMCRC",     32, 0x04C11DB7ull,         0xFFFFFFFFull,         true,  true,  0x00000000ull,         0x340BC6D9ull },
+	{ "CRC-32/MPEG-2",     32, 0x04C11DB7ull,         0xFFFFFFFFull,         false, false, 0x00000000ull,         0x0376E6E7ull },
+	{ "CRC-32/XFER",       32, 0x000000AFull,         0x00000000ull,         false, false, 0x00000000ull,         0xBD0BE338ull },
+	{ "CRC-40/GSM",        40, 0x0004820009ull,       0x0000000000ull,       false, false, 0xFFFFFFFFFFull,       0xD4164FC646ull },
+	{ "CRC-64/ECMA-182",   64, 0x42F0E1EBA9EA3693ull, 0x0000000000000000ull, false, false, 0x0000000000000000ull, 0x6C40DF5F0B497347ull },
+	{ "CRC-64/GO-ISO",     64, 0x000000000000001Bull, 0xFFFFFFFFFFFFFFFFull, true,  true,  0xFFFFFFFFFFFFFFFFull, 0xB90956C775A41001ull },
+	{ "CRC-64/MS",         64, 0x259C84CBA6426349ull, 0xFFFFFFFFFFFFFFFFull, true,  true,  0x0000000000000000ull, 0x75D4B74F024ECEEAull },
+	{ "CRC-64/REDIS",      64, 0xAD93D23594C935A9ull, 0x0000000000000000ull, true,  true,  0x0000000000000000ull, 0xE9C6D914C4B8D9CAull },
+	{ "CRC-64/WE",         64, 0x42F0E1EBA9EA3693ull, 0xFFFFFFFFFFFFFFFFull, false, false, 0xFFFFFFFFFFFFFFFFull, 0x62EC59E3F1A4F00Aull },
+	{ "CRC-64/XZ",         64, 0x42F0E1EBA9EA3693ull, 0xFFFFFFFFFFFFFFFFull, true,  true,  0xFFFFFFFFFFFFFFFFull, 0x995DC9BBDF1939FAull }
+};
+
+#define NUM_MODELS		( sizeof(model_list) / sizeof(model_list[0]) )
+
+/*
+ * static const struct model_alias alias_list[];
+ *
+ * Alternative names under which the CRC algorithms in the catalogue are also
+ * commonly known.
+ */
+
+static const struct model_alias alias_list[] = {
+	{ "CRC-4/ITU",          "CRC-4/G-704"        },
+	{ "CRC-5/ITU",          "CRC-5/G-704"        },
+	{ "CRC-6/ITU",          "CRC-6/G-704"        },
+	{ "CRC-8",              "CRC-8/SMBUS"        },
+	{ "CRC-8/ITU",          "CRC-8/I-432-1"      },
+	{ "CRC-8/MAXIM",        "CRC-8/MAXIM-DOW"    },
+	{ "DOW-CRC",            "CRC-8/MAXIM-DOW"    },
+	{ "CRC-12/3GPP",        "CRC-12/UMTS"        },
+	{ "CRC-15",             "CRC-15/CAN"         },
+	{ "ARC",                "CRC-16/ARC"         },
+	{ "CRC-16",             "CRC-16/ARC"         },
+	{ "CRC-16/LHA",         "CRC-16/ARC"         },
+	{ "CRC-IBM",            "CRC-16/ARC"         },
+	{ "CRC-16/BUYPASS",     "CRC-16/UMTS"        },
+	{ "CRC-16/VERIFONE",    "CRC-16/UMTS"        },
+	{ "CRC-16/AUG-CCITT",   "CRC-16/SPI-FUJITSU" },
+	{ "CRC-16/AUTOSAR",     "CRC-16/IBM-3740"    },
+	{ "CRC-16/CCITT-FALSE", "CRC-16/IBM-3740"    },
+	{ "CRC-16/CCITT",       "CRC-16/KERMIT"      },
+	{ "CRC-16/CCITT-TRUE",  "CRC-16/KERMIT"      },
+	{ "CRC-16/V-41-LSB",    "CRC-16/KERMIT"      },
+	{ "KERMIT",             "CRC-16/KERMIT"      },
+	{ "CRC-16/DARC",        "CRC-16/GENIBUS"     },
+	{ "CRC-16/EPC",         "CRC-16/GENIBUS"     },
+	{ "CRC-16/I-CODE",      "CRC-16/GENIBUS"     },
+	{ "CRC-16/ISO-HDLC",    "CRC-16/IBM-SDLC"    },
+	{ "CRC-16/X-25",        "CRC-16/IBM-SDLC"    },
+	{ "CRC-B",              "CRC-16/IBM-SDLC"    },
+	{ "X-25",               "CRC-16/IBM-SDLC"    },
+	{ "CRC-16/MAXIM",       "CRC-16/MAXIM-DOW"   },
+	{ "MODBUS",             "CRC-16/MODBUS"      },
+	{ "CRC-16/ACORN",       "CRC-16/XMODEM"      },
+	{ "CRC-16/LTE",         "CRC-16/XMODEM"      },
+	{ "CRC-16/V-41-MSB",    "CRC-16/XMODEM"      },
+	{ "XMODEM",             "CRC-16/XMODEM"      },
+	{ "ZMODEM",             "CRC-16/XMODEM"      },
+	{ "X-CRC-16",           "CRC-16/DECT-X"      },
+	{ "CRC-24",             "CRC-24/OPENPGP"     },
+	{ "CRC-32/AAL5",        "CRC-32/BZIP2"       },
+	{ "CRC-32/DECT-B",      "CRC-32/BZIP2"       },
+	{ "B-CRC-32",           "CRC-32/BZIP2"       },
+	{ "CKSUM",              "CRC-32/CKSUM"       },
+	{ "CRC-32/POSIX",       "CRC-32/CKSUM"       },
+	{ "CRC-32C",            "CRC-32/ISCSI"       },
+	{ "CRC-32/CASTAGNOLI",  "CRC-32/ISCSI"       },
+	{ "CRC-32/INTERLAKEN",  "CRC-32/ISCSI"       },
+	{ "CRC-32",             "CRC-32/ISO-HDLC"    },
+	{ "CRC-32/ADCCP",       "CRC-32/ISO-HDLC"    },
+	{ "CRC-32/V-42",        "CRC-32/ISO-HDLC"    },
+	{ "CRC-32/XZ",          "CRC-32/ISO-HDLC"    },
+	{ "PKZIP",              "CRC-32/ISO-HDLC"    },
+	{ "JAMCRC",             "CRC-32/JAMCRC"      },
+	{ "CRC-32Q",            "CRC-32/AIXM"        },
+	{ "XFER",               "CRC-32/XFER"        },
+	{ "CRC-64",             "CRC-64/ECMA-182"    },
+	{ "CRC-64/GO-ECMA",     "CRC-64/XZ"          },
+	{ NULL,                 NULL                 }
+};
+
+/*
+ * static const struct model_fast fast_list[];
+ *
+ * The combinations of width, polynomial and input reflection for which the
+ * library has a dedicated block routine. These routines use the fastest
+ * method available on the CPU. The 8 bit polynomials of the CRC-8 family are
+ * looked up separately with libcrc_crc8_find().
+ */
+
+static const struct model_fast fast_list[] = {
+	{ 16, 0x8005ull,             true,  fast_16     },
+	{ 16, 0x1021ull,             false, fast_ccitt  },
+	{ 16, 0x1021ull,             true,  fast_kermit },
+	{ 16, 0x3D65ull,             true,  fast_dnp    },
+	{ 32, 0x04C11DB7ull,         true,  fast_32     },
+	{ 32, 0x1EDC6F41ull,         true,  fast_32c    },
+	{ 64, 0x42F0E1EBA9EA3693ull, false, fast_64     },
+	{  0, 0x00ull,               false, NULL        }
+};
+
+/*
+ * The registry with the lookup tables which have been calculated for the
+ * parameter sets without a dedicated routine. New engines are only added at
+ * the head of the list while the lock is held and are never removed, so the
+ * list can be searched without the lock once the head has been read.
+ */
+
+static struct model_engine *	engine_list		= NULL;
+
+#if defined(LIBCRC_THREADS)
+static pthread_mutex_t		engine_lock		= PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/*
+ * uint64_t crc_model_calc( const struct crc_model *model, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_model_calc() calculates in one pass the CRC of a byte
+ * string with the algorithm described by a model. The value 0 is returned if
+ * the model is invalid.
+ */
+
+uint64_t crc_model_calc( const struct crc_model *model, const unsigned char *input_str, size_t num_bytes ) {
+
+	uint64_t crc;
+
+	crc = crc_model_init(   model );
+	crc = crc_model_update( model, crc, input_str, num_bytes );
+
+	return crc_model_final( model, crc );
+
+}  /* crc_model_calc */
+
+/*
+ * const struct crc_model *crc_model_catalogue( size_t *num_models );
+ *
+ * The function crc_model_catalogue() returns a pointer to the array with the
+ * models in the built-in catalogue. The number of models in the array is
+ * stored in num_models if that pointer is not NULL.
+ */
+
+const struct crc_model *crc_model_catalogue( size_t *num_models ) {
+
+	if ( num_models != NULL ) *num_models = NUM_MODELS;
+
+	return model_list;
+
+}  /* crc_model_catalogue */
+
+/*
+ * const struct crc_model *crc_model_find( const char *name );
+ *
+ * The function crc_model_find() searches the catalogue for a CRC algorithm
+ * with a given name or alias. The comparison is case insensitive. The function
+ * returns a pointer to the model, or NULL if the name is not found.
+ */
+
+const struct crc_model *crc_model_find( const char *name ) {
+
+	size_t a;
+
+	if ( name == NULL ) return NULL;
+
+	for (a=0; alias_list[a].alias != NULL; a++) {
+
+		if ( model_name_eq( name, alias_list[a].alias ) ) {
+
+			name = alias_list[a].name;
+			break;
+		}
+	}
+
+	for (a=0; a<NUM_MODELS; a++) if ( model_name_eq( name, model_list[a].name ) ) return & model_list[a];
+
+	return NULL;
+
+}  /* crc_model_find */
+
+/*
+ * uint64_t crc_model_init( const struct crc_model *model );
+ *
+ * The function crc_model_init() returns the start value of the CRC register
+ * for a model. The value is in the internal format of the engine and should
+ * only be passed to crc_model_update() and crc_model_final().
+ */
+
+uint64_t crc_model_init( const struct crc_model *model ) {
+
+	uint64_t init;
+
+	if ( model == NULL  ||  model->width < 1  ||  model->width > 64 ) return 0;
+
+	init = model->init & model_mask( model->width );
+
+	if ( model->refin ) return model_reflect( init, model->width );
+	else                return init << ( 64 - model->width );
+
+}  /* crc_model_init */
+
+/*
+ * uint64_t crc_model_update( const struct crc_model *model, uint64_t crc, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_model_update() adds a block of bytes to a CRC register
+ * value which was returned by crc_model_init() or an earlier call to this
+ * function. The new register value is returned.
+ */
+
+uint64_t crc_model_update( const struct crc_model *model, uint64_t crc, const unsigned char *input_str, size_t num_bytes ) {
+
+	uint64_t poly;
+	const struct model_engine *engine;
+	const struct model_fast *fast;
+	const struct libcrc_crc8 *family;
+
+	if ( model == NULL  ||  model->width < 1  ||  model->width > 64  ||  input_str == NULL ) return crc;
+
+	poly = model->poly & model_mask( model->width );
+
+	if ( model->width == 8 ) {
+
+		family = libcrc_crc8_find( (uint8_t) poly, model->refin );
+
+		if ( family != NULL ) {
+
+			if ( model->refin ) return             libcrc_crc8_block( family, (uint8_t)   crc,         input_str, num_bytes );
+			else                return (uint64_t) libcrc_crc8_block( family, (uint8_t) ( crc >> 56 ), input_str, num_bytes ) << 56;
+		}
+	}
+
+	for (fast=fast_list; fast->block != NULL; fast++) {
+
+		if ( fast->width == model->width  &&  fast->poly == poly  &&  fast->refin == model->refin ) return fast->block( crc, input_str, num_bytes );
+	}
+
+	engine = engine_get( model );
+
+	if ( engine == NULL ) return engine_bitwise( model, crc, input_str, num_bytes );
+	else                  return engine_block(   engine, crc, input_str, num_bytes );
+
+}  /* crc_model_update */
+
+/*
+ * uint64_t crc_model_final( const struct crc_model *model, uint64_t crc );
+ *
+ * The function crc_model_final() converts a CRC register value to the final
+ * CRC value of a model. The output reflection and the final XOR are applied.
+ * The register value itself is not changed, so more data can be added to it
+ * afterwards.
+ */
+
+uint64_t crc_model_final( const struct crc_model *model, uint64_t crc ) {
+
+	if ( model == NULL  ||  model->width < 1  ||  model->width > 64 ) return 0;
+
+	if ( ! model->refin ) crc >>= 64 - model->width;
+	if ( model->refin != model->refout ) crc = model_reflect( crc, model->width );
+
+	return ( crc ^ model->xorout ) & model_mask( model->width );
+
+}  /* crc_model_final */
+
+/*
+ * static struct model_engine *engine_get( const struct crc_model *model );
+ *
+ * The function engine_get() searches the registry for the lookup tables of
+ * the width, polynomial and input reflection of a model. The tables are
+ * calculated and added to the registry if they are not present yet. Only
+ * this last step takes the lock; the head of the list is published with a
+ * release store so that a search without the lock sees complete engines. The
+ * function returns NULL if no memory could be allocated for the tables.
+ */
+
+static struct model_engine *engine_get( const struct crc_model *model ) {
+
+	uint64_t poly;
+	struct model_engine *engine;
+
+	poly = model->poly & model_mask( model->width );
+
+#if defined(LIBCRC_THREADS)
+	engine = engine_find( __atomic_load_n( & engine_list, __ATOMIC_ACQUIRE ), model->width, poly, model->refin );
+#else
+	engine = engine_find( engine_list, model->width, poly, model->refin );
+#endif
+
+	if ( engine != NULL ) return engine;
+
+#if defined(LIBCRC_THREADS)
+	pthread_mutex_lock( & engine_lock );
+
+	engine = engine_find( engine_list, model->width, poly, model->refin );
+#endif
+
+	if ( engine == NULL ) {
+
+		engine = engine_create( model->width, poly, model->refin );
+
+		if ( engine != NULL ) {
+
+			engine->next = engine_list;
+#if defined(LIBCRC_THREADS)
+			__atomic_store_n( & engine_list, engine, __ATOMIC_RELEASE );
+#else
+			engine_list  = engine;
+#endif
+		}
+	}
+
+#if defined(LIBCRC_THREADS)
+	pthread_mutex_unlock( & engine_lock );
+#endif
+
+	return engine;
+
+}  /* engine_get */
+
+/*
+ * static struct model_engine *engine_find( struct model_engine *engine, int width, uint64_t poly, bool refin );
+ *
+ * The function engine_find() walks the registry from the given engine and
+ * returns the engine with the width, polynomial and input reflection, or NULL
+ * if the tables of that parameter set have not been calculated yet.
+ */
+
+static struct model_engine *engine_find( struct model_engine *engine, int width, uint64_t poly, bool refin ) {
+
+	while ( engine != NULL ) {
+
+		if ( engine->width == width  &&  engine->poly == poly  &&  engine->refin == refin ) return engine;
+
+		engine = engine->next;
+	}
+
+	return NULL;
+
+}  /* engine_find */
+
+/*
+ * static struct model_engine *engine_create( int width, uint64_t poly, bool refin );
+ *
+ * The function engine_create() allocates an engine and calculates its lookup
+ * tables. Reflected CRC values are kept in the lowest bits of the register,
+ * other CRC values in the highest bits so that the same 64 bit routines work
+ * for all widths. The function returns NULL if no memory is available.
+ */
+
+static struct model_engine *engine_create( int width, uint64_t poly, bool refin ) {
+
+	int a;
+	int b;
+	int c;
+	uint64_t crc;
+	uint64_t prev;
+	uint64_t reg_poly;
+	struct model_engine *engine;
+
+	engine = malloc( sizeof(struct model_engine) );
+	if ( engine == NULL ) return NULL;
+
+	engine->width = width;
+	engine->poly  = poly;
+	engine->refin = refin;
+	engine->next  = NULL;
+
+	if ( refin ) reg_poly = model_reflect( poly, width );
+	else         reg_poly = poly << ( 64 - width );
+
+	for (b=0; b<256; b++) {
+
+		if ( refin ) {
+
+			crc = (uint64_t) b;
+
+			for (c=0; c<8; c++) {
+
+				if ( crc & 0x0000000000000001ull ) crc = ( crc >> 1 ) ^ reg_poly;
+				else                               crc =   crc >> 1;
+			}
+		}
+
+		else {
+
+			crc = (uint64_t) b << 56;
+
+			for (c=0; c<8; c++) {
+
+				if ( crc & 0x8000000000000000ull ) crc = ( crc << 1 ) ^ reg_poly;
+				else                               crc =   crc << 1;
+			}
+		}
+
+		engine->table[0][b] = crc;
+	}
+
+	for (a=1; a<MODEL_SLICES; a++) {
+
+		for (b=0; b<256; b++) {
+
+			prev = engine->table[a-1][b];
+
+			if ( refin ) engine->table[a][b] = ( prev >> 8 ) ^ engine->table[0][ prev & 0xFF ];
+			else         engine->table[a][b] = ( prev << 8 ) ^ engine->table[0][ prev >> 56  ];
+		}
+	}
+
+	return engine;
+
+}  /* engine_create */
+
+/*
+ * static uint64_t engine_block( const struct model_engine *engine, uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function engine_block() updates a CRC register value with a block of
+ * bytes using the slicing-by-8 lookup tables of an engine. Eight bytes are
+ * processed per step and the remaining bytes one by one.
+ */
+
+static uint64_t engine_block( const struct model_engine *engine, uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	uint64_t val;
+	const uint64_t (*tab)[256];
+
+	tab = engine->table;
+
+	if ( engine->refin ) {
+
+		while ( num_bytes >= 8 ) {
+
+			val  = crc ^ LOAD_LE64( ptr );
+
+			crc  = tab[7][  val        & 0xFF ]
+			     ^ tab[6][ (val >>  8) & 0xFF ]
+			     ^ tab[5][ (val >> 16) & 0xFF ]
+			     ^ tab[4][ (val >> 24) & 0xFF ]
+			     ^ tab[3][ (val >> 32) & 0xFF ]
+			     ^ tab[2][ (val >> 40) & 0xFF ]
+			     ^ tab[1][ (val >> 48) & 0xFF ]
+			     ^ tab[0][  val >> 56         ];
+
+			ptr       += 8;
+			num_bytes -= 8;
+		}
+
+		while ( num_bytes-- > 0 ) crc = ( crc >> 8 ) ^ tab[0][ (crc ^ (uint64_t) *ptr++) & 0xFF ];
+	}
+
+	else {
+
+		while ( num_bytes >= 8 ) {
+
+			val  = crc ^ LOAD_BE64( ptr );
+
+			crc  = tab[7][  val >> 56         ]
+			     ^ tab[6][ (val >> 48) & 0xFF ]
+			     ^ tab[5][ (val >> 40) & 0xFF ]
+			     ^ tab[4][ (val >> 32) & 0xFF ]
+			     ^ tab[3][ (val >> 24) & 0xFF ]
+			     ^ tab[2][ (val >> 16) & 0xFF ]
+			     ^ tab[1][ (val >>  8) & 0xFF ]
+			     ^ tab[0][  val        & 0xFF ];
+
+			ptr       += 8;
+			num_bytes -= 8;
+		}
+
+		while ( num_bytes-- > 0 ) crc = ( crc << 8 ) ^ tab[0][ (crc >> 56) ^ (uint64_t) *ptr++ ];
+	}
+
+	return crc;
+
+}  /* engine_block */
+
+/*
+ * static uint64_t engine_bitwise( const struct crc_model *model, uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function engine_bitwise() updates a CRC register value bit by bit. It
+ * is only used when no memory could be allocated for the lookup tables, so
+ * that the result is always correct.
+ */
+
+static uint64_t engine_bitwise( const struct crc_model *model, uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	int c;
+	uint64_t reg_poly;
+
+	reg_poly = model->poly & model_mask( model->width );
+
+	if ( model->refin ) reg_poly = model_reflect( reg_poly, model->width );
+	else                reg_poly = reg_poly << ( 64 - model->width );
+
+	while ( num_bytes-- > 0 ) {
+
+		if ( model->refin ) {
+
+			crc ^= (uint64_t) *ptr++;
+
+			for (c=0; c<8; c++) {
+
+				if ( crc & 0x0000000000000001ull ) crc = ( crc >> 1 ) ^ reg_poly;
+				else                               crc =   crc >> 1;
+			}
+		}
+
+		else {
+
+			crc ^= (uint64_t) *ptr++ << 56;
+
+			for (c=0; c<8; c++) {
+
+				if ( crc & 0x8000000000000000ull ) crc = ( crc << 1 ) ^ reg_poly;
+				else                               crc =   crc << 1;
+			}
+		}
+	}
+
+	return crc;
+
+}  /* engine_bitwise */
+
+/*
+ * static uint64_t fast_xxx( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The fast_xxx() functions convert the register value of the generic engine
+ * to the register of a dedicated block routine of the library and back.
+ * Reflected registers are stored in the lowest bits, other registers in the
+ * highest bits of the 64 bit value.
+ */
+
+static uint64_t fast_16( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return update_crc_16_block( (uint16_t) crc, ptr, num_bytes );
+
+}  /* fast_16 */
+
+static uint64_t fast_32( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return update_crc_32_block( (uint32_t) crc, ptr, num_bytes );
+
+}  /* fast_32 */
+
+static uint64_t fast_32c( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return update_crc_32c_block( (uint32_t) crc, ptr, num_bytes );
+
+}  /* fast_32c */
+
+static uint64_t fast_64( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return update_crc_64_block( crc, ptr, num_bytes );
+
+}  /* fast_64 */
+
+static uint64_t fast_ccitt( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return (uint64_t) update_crc_ccitt_block( (uint16_t) ( crc >> 48 ), ptr, num_bytes ) << 48;
+
+}  /* fast_ccitt */
+
+static uint64_t fast_dnp( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return update_crc_dnp_block( (uint16_t) crc, ptr, num_bytes );
+
+}  /* fast_dnp */
+
+static uint64_t fast_kermit( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return update_crc_kermit_block( (uint16_t) crc, ptr, num_bytes );
+
+}  /* fast_kermit */
+
+/*
+ * static uint64_t model_mask( int width );
+ *
+ * The function model_mask() returns a value with the lowest width bits set.
+ */
+
+static uint64_t model_mask( int width ) {
+
+	if ( width >= 64 ) return 0xFFFFFFFFFFFFFFFFull;
+
+	return ( 1ull << width ) - 1;
+
+}  /* model_mask */
+
+/*
+ * static uint64_t model_reflect( uint64_t val, int width );
+ *
+ * The function model_reflect() returns the lowest width bits of a value in
+ * reversed order.
+ */
+
+static uint64_t model_reflect( uint64_t val, int width ) {
+
+	int a;
+	uint64_t result;
+
+	result = 0;
+
+	for (a=0; a<width; a++) {
+
+		result = ( result << 1 ) | ( val & 0x0000000000000001ull );
+		val  >>= 1;
+	}
+
+	return result;
+
+}  /* model_reflect */
+
+/*
+ * static bool model_name_eq( const char *name1, const char *name2 );
+ *
+ * The function model_name_eq() compares two names of CRC algorithms without
+ * regard to the case of the letters.
+ */
+
+static bool model_name_eq( const char *name1, const char *name2 ) {
+
+	unsigned char c1;
+	unsigned char c2;
+
+	do {
+		c1 = (unsigned char) *name1++;
+		c2 = (unsigned char) *name2++;
+
+		if ( c1 >= 'a'  &&  c1 <= 'z' ) c1 -= 'a' - 'A';
+		if ( c2 >= 'a'  &&  c2 <= 'z' ) c2 -= 'a' - 'A';
+
+		if ( c1 != c2 ) return false;
+
+	} while ( c1 != '\0' );
+
+	return true;
+
+}  /* model_name_eq */
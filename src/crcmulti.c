@@ -0,0 +1,639 @@
+/*
+ * Library: libcrc
+ * File:    src/crcmulti.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcmulti.c contains routines to calculate the CRC values
+ * of many independent buffers in one call. The CRC of a single buffer is one
+ * long chain of dependent table lookups, where each step has to wait for the
+ * result of the previous one. For short buffers this latency, and not the
+ * number of instructions, limits the speed. The routines in this file
+ * process four buffers at the same time with independent CRC registers, so
+ * that the processor can overlap the lookups of the different buffers.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+#define MULTI_LANES		4
+
+#define MULTI_NONE		0
+#define MULTI_8			1
+#define MULTI_16_NORMAL		2
+#define MULTI_16_REFLECTED	3
+#define MULTI_32		4
+#define MULTI_32C		5
+#define MULTI_64		6
+
+/*
+ * struct multi_tp
+ *
+ * The structure multi_tp describes how the interleaved routines calculate the
+ * CRC of one algorithm. The final value is the register XOR-ed with xorout,
+ * with the two bytes swapped for the Kermit and DNP algorithms. Buffers
+ * longer than limit bytes are passed to the single buffer routines.
+ */
+
+							/************************************************/
+struct multi_tp {					/*						*/
+	int			kernel;			/* The interleaved routine MULTI_xxx		*/
+	const uint16_t *	tab16;			/* Lookup table for the 16 bit algorithms	*/
+	uint64_t		start;			/* The start value of the CRC register		*/
+	uint64_t		xorout;			/* The value XOR-ed with the final register	*/
+	bool			swap;			/* Swap the bytes of the 16 bit result		*/
+	size_t			limit;			/* Maximum length of an interleaved buffer	*/
+};							/*						*/
+							/************************************************/
+
+static bool		multi_init( struct multi_tp *mt, int type );
+static void		multi_8(            const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+static void		multi_16_normal(    const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+static void		multi_16_reflected( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+static void		multi_32_table(     const uint32_t (*slice)[256], uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+static void		multi_64_table(     const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+
+#if defined(LIBCRC_X86_SIMD)
+static void		multi_32c_sse42(    const uint32_t (*slice)[256], uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+static void		multi_select( void );
+#endif
+
+/*
+ * static void (*multi_32c)( const uint32_t (*slice)[256], uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+ *
+ * The function pointer multi_32c points to the fastest routine available on
+ * the current CPU to calculate four CRC-32C values at the same time. It is
+ * initialized with the table driven routine and changed only once at program
+ * startup by multi_select().
+ */
+
+static void		(*multi_32c)( const uint32_t (*slice)[256], uint64_t *crc, const unsigned char **ptr, size_t num_bytes ) = multi_32_table;
+
+/*
+ * static size_t multi_limit_xxx;
+ *
+ * Beyond these lengths the single buffer routine of an algorithm is faster
+ * than the interleaved routine, because it uses carry-less multiplication
+ * folding or the crc32 instruction on several parts of the buffer. The folding
+ * routines of the reflected algorithms need PCLMULQDQ and SSE4.1, those of the
+ * non reflected algorithms also need SSSE3 to swap the byte order. The values
+ * are only lowered at program startup by multi_select() when the CPU supports
+ * the same instructions as the single buffer routine.
+ */
+
+static size_t		multi_limit_reflected = SIZE_MAX;
+static size_t		multi_limit_normal    = SIZE_MAX;
+static size_t		multi_limit_32c       = SIZE_MAX;
+
+/*
+ * #define STEP_xxx( crc, ptr )
+ *
+ * The macros of the form STEP_xxx() update the CRC register of one buffer.
+ * The STEP_32 and STEP_64 macros process eight bytes with the slicing-by-8
+ * tables, the other macros process one byte.
+ */
+
+#define STEP_8(crc,ptr)		( crc = crc_tab8[ (crc ^ *(ptr)++) & 0xFF ] )
+
+#define STEP_16N(crc,ptr)	( crc = (uint16_t) ( (crc << 8) ^ tab[ ((crc >> 8) ^ *(ptr)++) & 0xFF ] ) )
+
+#define STEP_16R(crc,ptr)	( crc = (uint16_t) ( (crc >> 8) ^ tab[  (crc       ^ *(ptr)++) & 0xFF ] ) )
+
+#define STEP_32B(crc,ptr)	( crc = (crc >> 8) ^ slice[0][ (crc ^ *(ptr)++) & 0xFF ] )
+
+#define STEP_64B(crc,ptr)	( crc = (crc << 8) ^ crc_tab64_slice[0][ ((crc >> 56) ^ *(ptr)++) & 0xFF ] )
+
+#define STEP_32(crc,ptr)	( val  = LOAD_LE64( ptr ) ^ crc, (ptr) += 8,					\
+				  crc  = slice[7][  val        & 0xFF ] ^ slice[6][ (val >>  8) & 0xFF ]	\
+				       ^ slice[5][ (val >> 16) & 0xFF ] ^ slice[4][ (val >> 24) & 0xFF ]	\
+				       ^ slice[3][ (val >> 32) & 0xFF ] ^ slice[2][ (val >> 40) & 0xFF ]	\
+				       ^ slice[1][ (val >> 48) & 0xFF ] ^ slice[0][  val >> 56         ] )
+
+#define STEP_64(crc,ptr)	( val  = LOAD_BE64( ptr ) ^ crc, (ptr) += 8,					\
+				  crc  = crc_tab64_slice[7][  val >> 56         ]				\
+				       ^ crc_tab64_slice[6][ (val >> 48) & 0xFF ]				\
+				       ^ crc_tab64_slice[5][ (val >> 40) & 0xFF ]				\
+				       ^ crc_tab64_slice[4][ (val >> 32) & 0xFF ]				\
+				       ^ crc_tab64_slice[3][ (val >> 24) & 0xFF ]				\
+				       ^ crc_tab64_slice[2][ (val >> 16) & 0xFF ]				\
+				       ^ crc_tab64_slice[1][ (val >>  8) & 0xFF ]				\
+				       ^ crc_tab64_slice[0][  val        & 0xFF ] )
+
+/*
+ * void crc_multi( int type, const unsigned char * const *input_str, const size_t *num_bytes, uint64_t *crc, size_t num_buffers );
+ *
+ * The function crc_multi() calculates the CRC values of num_buffers separate
+ * buffers with the algorithm type, which is one of the CRC_TYPE_xxxx
+ * constants. The buffers are described by the arrays input_str and num_bytes,
+ * and the CRC of each buffer is stored in the array crc with the same value
+ * as the one pass function of the algorithm would return.
+ *
+ * Four buffers are processed at the same time, each with its own CRC
+ * register. When a buffer is finished, its CRC value is stored and the next
+ * buffer takes its place. Buffers which are long enough to be processed
+ * efficiently by the SIMD routines of the library are passed to those
+ * routines directly, as are the last buffers when less than four remain. For
+ * an unknown type all CRC values are set to zero.
+ */
+
+void crc_multi( int type, const unsigned char * const *input_str, const size_t *num_bytes, uint64_t *crc, size_t num_buffers ) {
+
+	size_t a;
+	size_t b;
+	size_t next;
+	size_t step;
+	size_t num_lanes;
+	size_t lane_buf[MULTI_LANES];
+	size_t lane_left[MULTI_LANES];
+	uint64_t reg[MULTI_LANES];
+	uint64_t val;
+	const unsigned char *ptr[MULTI_LANES];
+	struct crc_ctx ctx;
+	struct multi_tp mt;
+
+	if ( crc == NULL ) return;
+
+	if ( input_str == NULL  ||  num_bytes == NULL  ||  ! multi_init( &mt, type ) ) {
+
+		for (a=0; a<num_buffers; a++) crc[a] = 0;
+		return;
+	}
+
+	next      = 0;
+	num_lanes = 0;
+
+	while ( true ) {
+
+		/*
+		 * Fill the empty lanes with the next buffers. Empty and long
+		 * buffers are calculated directly.
+		 */
+
+		while ( num_lanes < MULTI_LANES  &&  next < num_buffers ) {
+
+			if ( mt.kernel == MULTI_NONE  ||  input_str[next] == NULL  ||  num_bytes[next] == 0  ||  num_bytes[next] > mt.limit ) {
+
+				crc_ctx_init( &ctx, type );
+				crc_ctx_update( &ctx, input_str[next], num_bytes[next] );
+				crc[next++] = crc_ctx_final( &ctx );
+				continue;
+			}
+
+			lane_buf[num_lanes]  = next;
+			lane_left[num_lanes] = num_bytes[next];
+			ptr[num_lanes]       = input_str[next];
+			reg[num_lanes]       = mt.start;
+
+			num_lanes++;
+			next++;
+		}
+
+		if ( num_lanes < MULTI_LANES ) break;
+
+		step = lane_left[0];
+		for (b=1; b<MULTI_LANES; b++) if ( lane_left[b] < step ) step = lane_left[b];
+
+		switch ( mt.kernel ) {
+
+			case MULTI_8            : multi_8(            &mt,               reg, ptr, step ); break;
+			case MULTI_16_NORMAL    : multi_16_normal(    &mt,               reg, ptr, step ); break;
+			case MULTI_16_REFLECTED : multi_16_reflected( &mt,               reg, ptr, step ); break;
+			case MULTI_32           : multi_32_table(     crc_tab32_slice,   reg, ptr, step ); break;
+			case MULTI_32C          : multi_32c(          crc_tab32c_slice,  reg, ptr, step ); break;
+			case MULTI_64           : multi_64_table(     &mt,               reg, ptr, step ); break;
+		}
+
+		/*
+		 * Store the CRC values of the finished buffers and compact the
+		 * lanes which are still in use.
+		 */
+
+		a = 0;
+
+		for (b=0; b<MULTI_LANES; b++) {
+
+			lane_left[b] -= step;
+
+			if ( lane_left[b] == 0 ) {
+
+				val = reg[b] ^ mt.xorout;
+				if ( mt.swap ) val = ( (val >> 8) & 0x00FF ) | ( (val << 8) & 0xFF00 );
+
+				crc[ lane_buf[b] ] = val;
+				continue;
+			}
+
+			lane_buf[a]  = lane_buf[b];
+			lane_left[a] = lane_left[b];
+			ptr[a]       = ptr[b];
+			reg[a]       = reg[b];
+			a++;
+		}
+
+		num_lanes = a;
+	}
+
+	/*
+	 * Less than four buffers are left. These are finished one by one with
+	 * the single buffer routines.
+	 */
+
+	for (b=0; b<num_lanes; b++) {
+
+		crc_ctx_init( &ctx, type );
+		ctx.crc = reg[b];
+		crc_ctx_update( &ctx, ptr[b], lane_left[b] );
+		crc[ lane_buf[b] ] = crc_ctx_final( &ctx );
+	}
+
+}  /* crc_multi */
+
+/*
+ * static bool multi_init( struct multi_tp *mt, int type );
+ *
+ * The function multi_init() fills the description of the interleaved
+ * calculation of the CRC algorithm type. The function returns false if the
+ * type is unknown. Algorithms without an interleaved routine get the kernel
+ * MULTI_NONE and are calculated buffer by buffer.
+ */
+
+static bool multi_init( struct multi_tp *mt, int type ) {
+
+	mt->kernel = MULTI_NONE;
+	mt->tab16  = NULL;
+	mt->xorout = 0;
+	mt->swap   = false;
+	mt->limit  = multi_limit_reflected;
+
+	switch ( type ) {
+
+		case CRC_TYPE_8          : mt->kernel = MULTI_8;            mt->start = CRC_START_8;          mt->limit  = SIZE_MAX;        break;
+		case CRC_TYPE_16         : mt->kernel = MULTI_16_REFLECTED; mt->start = CRC_START_16;         mt->tab16  = crc_tab16;       break;
+		case CRC_TYPE_MODBUS     : mt->kernel = MULTI_16_REFLECTED; mt->start = CRC_START_MODBUS;     mt->tab16  = crc_tab16;       break;
+		case CRC_TYPE_XMODEM     : mt->kernel = MULTI_16_NORMAL;    mt->start = CRC_START_XMODEM;     mt->tab16  = crc_tabccitt;    mt->limit  = multi_limit_normal; break;
+		case CRC_TYPE_CCITT_1D0F : mt->kernel = MULTI_16_NORMAL;    mt->start = CRC_START_CCITT_1D0F; mt->tab16  = crc_tabccitt;    mt->limit  = multi_limit_normal; break;
+		case CRC_TYPE_CCITT_FFFF : mt->kernel = MULTI_16_NORMAL;    mt->start = CRC_START_CCITT_FFFF; mt->tab16  = crc_tabccitt;    mt->limit  = multi_limit_normal; break;
+		case CRC_TYPE_KERMIT     : mt->kernel = MULTI_16_REFLECTED; mt->start = CRC_START_KERMIT;     mt->tab16  = crc_tabkermit;   mt->swap   = true;       break;
+		case CRC_TYPE_DNP        : mt->kernel = MULTI_16_REFLECTED; mt->start = CRC_START_DNP;        mt->tab16  = crc_tabdnp;      mt->swap   = true;       mt->xorout = 0xFFFFull; break;
+		case CRC_TYPE_SICK       : mt->kernel = MULTI_NONE;         mt->start = CRC_START_SICK;       break;
+		case CRC_TYPE_32         : mt->kernel = MULTI_32;           mt->start = CRC_START_32;         mt->xorout = 0xFFFFFFFFull;   break;
+		case CRC_TYPE_32C        : mt->kernel = MULTI_32C;          mt->start = CRC_START_32C;        mt->xorout = 0xFFFFFFFFull;   mt->limit  = multi_limit_32c; break;
+		case CRC_TYPE_64_ECMA    : mt->kernel = MULTI_64;           mt->start = CRC_START_64_ECMA;    mt->limit  = multi_limit_normal; break;
+		case CRC_TYPE_64_WE      : mt->kernel = MULTI_64;           mt->start = CRC_START_64_WE;      mt->xorout = 0xFFFFFFFFFFFFFFFFull; mt->limit  = multi_limit_normal; break;
+		default                  : return false;
+	}
+
+	return true;
+
+}  /* multi_init */
+
+/*
+ * static void multi_8( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+ *
+ * The function multi_8() updates four CRC-8 registers with num_bytes bytes of
+ * their own buffer. The pointers are advanced past the processed bytes.
+ */
+
+static void multi_8( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes ) {
+
+	uint8_t crc0;
+	uint8_t crc1;
+	uint8_t crc2;
+	uint8_t crc3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	(void) mt;
+
+	crc0 = (uint8_t) crc[0]; ptr0 = ptr[0];
+	crc1 = (uint8_t) crc[1]; ptr1 = ptr[1];
+	crc2 = (uint8_t) crc[2]; ptr2 = ptr[2];
+	crc3 = (uint8_t) crc[3]; ptr3 = ptr[3];
+
+	while ( num_bytes-- > 0 ) {
+
+		STEP_8( crc0, ptr0 );
+		STEP_8( crc1, ptr1 );
+		STEP_8( crc2, ptr2 );
+		STEP_8( crc3, ptr3 );
+	}
+
+	crc[0] = crc0; ptr[0] = ptr0;
+	crc[1] = crc1; ptr[1] = ptr1;
+	crc[2] = crc2; ptr[2] = ptr2;
+	crc[3] = crc3; ptr[3] = ptr3;
+
+}  /* multi_8 */
+
+/*
+ * static void multi_16_normal( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+ *
+ * The function multi_16_normal() updates four registers of a 16 bit CRC
+ * which is calculated with the most significant bit first, using the byte
+ * wise lookup table of the algorithm.
+ */
+
+static void multi_16_normal( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes ) {
+
+	uint16_t crc0;
+	uint16_t crc1;
+	uint16_t crc2;
+	uint16_t crc3;
+	const uint16_t *tab;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	tab  = mt->tab16;
+
+	crc0 = (uint16_t) crc[0]; ptr0 = ptr[0];
+	crc1 = (uint16_t) crc[1]; ptr1 = ptr[1];
+	crc2 = (uint16_t) crc[2]; ptr2 = ptr[2];
+	crc3 = (uint16_t) crc[3]; ptr3 = ptr[3];
+
+	while ( num_bytes-- > 0 ) {
+
+		STEP_16N( crc0, ptr0 );
+		STEP_16N( crc1, ptr1 );
+		STEP_16N( crc2, ptr2 );
+		STEP_16N( crc3, ptr3 );
+	}
+
+	crc[0] = crc0; ptr[0] = ptr0;
+	crc[1] = crc1; ptr[1] = ptr1;
+	crc[2] = crc2; ptr[2] = ptr2;
+	crc[3] = crc3; ptr[3] = ptr3;
+
+}  /* multi_16_normal */
+
+/*
+ * static void multi_16_reflected( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+ *
+ * The function multi_16_reflected() updates four registers of a 16 bit CRC
+ * which is calculated with the least significant bit first, using the byte
+ * wise lookup table of the algorithm.
+ */
+
+static void multi_16_reflected( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes ) {
+
+	uint16_t crc0;
+	uint16_t crc1;
+	uint16_t crc2;
+	uint16_t crc3;
+	const uint16_t *tab;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	tab  = mt->tab16;
+
+	crc0 = (uint16_t) crc[0]; ptr0 = ptr[0];
+	crc1 = (uint16_t) crc[1]; ptr1 = ptr[1];
+	crc2 = (uint16_t) crc[2]; ptr2 = ptr[2];
+	crc3 = (uint16_t) crc[3]; ptr3 = ptr[3];
+
+	while ( num_bytes-- > 0 ) {
+
+		STEP_16R( crc0, ptr0 );
+		STEP_16R( crc1, ptr1 );
+		STEP_16R( crc2, ptr2 );
+		STEP_16R( crc3, ptr3 );
+	}
+
+	crc[0] = crc0; ptr[0] = ptr0;
+	crc[1] = crc1; ptr[1] = ptr1;
+	crc[2] = crc2; ptr[2] = ptr2;
+	crc[3] = crc3; ptr[3] = ptr3;
+
+}  /* multi_16_reflected */
+
+/*
+ * static void multi_32_table( const uint32_t (*slice)[256], uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+ *
+ * The function multi_32_table() updates four registers of a reflected 32 bit
+ * CRC with the slicing-by-8 tables slice. It is used for both the CRC-32 and
+ * the CRC-32C. The bytes after the last complete block of eight are
+ * processed one by one.
+ */
+
+static void multi_32_table( const uint32_t (*slice)[256], uint64_t *crc, const unsigned char **ptr, size_t num_bytes ) {
+
+	uint64_t val;
+	uint32_t crc0;
+	uint32_t crc1;
+	uint32_t crc2;
+	uint32_t crc3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	crc0 = (uint32_t) crc[0]; ptr0 = ptr[0];
+	crc1 = (uint32_t) crc[1]; ptr1 = ptr[1];
+	crc2 = (uint32_t) crc[2]; ptr2 = ptr[2];
+	crc3 = (uint32_t) crc[3]; ptr3 = ptr[3];
+
+	while ( num_bytes >= 8 ) {
+
+		STEP_32( crc0, ptr0 );
+		STEP_32( crc1, ptr1 );
+		STEP_32( crc2, ptr2 );
+		STEP_32( crc3, ptr3 );
+
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes-- > 0 ) {
+
+		STEP_32B( crc0, ptr0 );
+		STEP_32B( crc1, ptr1 );
+		STEP_32B( crc2, ptr2 );
+		STEP_32B( crc3, ptr3 );
+	}
+
+	crc[0] = crc0; ptr[0] = ptr0;
+	crc[1] = crc1; ptr[1] = ptr1;
+	crc[2] = crc2; ptr[2] = ptr2;
+	crc[3] = crc3; ptr[3] = ptr3;
+
+}  /* multi_32_table */
+
+/*
+ * static void multi_64_table( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+ *
+ * The function multi_64_table() updates four CRC-64 registers with the
+ * slicing-by-8 tables. The bytes after the last complete block of eight are
+ * processed one by one.
+ */
+
+static void multi_64_table( const struct multi_tp *mt, uint64_t *crc, const unsigned char **ptr, size_t num_bytes ) {
+
+	uint64_t val;
+	uint64_t crc0;
+	uint64_t crc1;
+	uint64_t crc2;
+	uint64_t crc3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	(void) mt;
+
+	crc0 = crc[0]; ptr0 = ptr[0];
+	crc1 = crc[1]; ptr1 = ptr[1];
+	crc2 = crc[2]; ptr2 = ptr[2];
+	crc3 = crc[3]; ptr3 = ptr[3];
+
+	while ( num_bytes >= 8 ) {
+
+		STEP_64( crc0, ptr0 );
+		STEP_64( crc1, ptr1 );
+		STEP_64( crc2, ptr2 );
+		STEP_64( crc3, ptr3 );
+
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes-- > 0 ) {
+
+		STEP_64B( crc0, ptr0 );
+		STEP_64B( crc1, ptr1 );
+		STEP_64B( crc2, ptr2 );
+		STEP_64B( crc3, ptr3 );
+	}
+
+	crc[0] = crc0; ptr[0] = ptr0;
+	crc[1] = crc1; ptr[1] = ptr1;
+	crc[2] = crc2; ptr[2] = ptr2;
+	crc[3] = crc3; ptr[3] = ptr3;
+
+}  /* multi_64_table */
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static void multi_select( void );
+ *
+ * The function multi_select() is called once at program startup. It selects
+ * the hardware routine for CRC-32C calculations if the CPU supports SSE4.2,
+ * and sets the lengths above which the single buffer SIMD routines are used.
+ */
+
+static LIBCRC_STARTUP void multi_select( void ) {
+
+	unsigned int features;
+
+	features = libcrc_cpu_features();
+
+	if ( ( features & LIBCRC_CPU_PCLMUL )  &&  ( features & LIBCRC_CPU_SSE41 ) ) {
+
+		multi_limit_reflected = 63;
+		if ( features & LIBCRC_CPU_SSSE3 ) multi_limit_normal = 63;
+	}
+
+	if ( features & LIBCRC_CPU_SSE42 ) {
+
+		multi_32c       = multi_32c_sse42;
+		multi_limit_32c = 767;
+	}
+
+}  /* multi_select */
+
+/*
+ * static void multi_32c_sse42( const uint32_t (*slice)[256], uint64_t *crc, const unsigned char **ptr, size_t num_bytes );
+ *
+ * The function multi_32c_sse42() updates four CRC-32C registers with the
+ * crc32 instruction of SSE4.2. The instruction has a latency of three cycles
+ * and a throughput of one per cycle, so the four independent registers keep
+ * the instruction unit busy. The lookup tables are not used.
+ */
+
+static LIBCRC_TARGET("sse4.2") void multi_32c_sse42( const uint32_t (*slice)[256], uint64_t *crc, const unsigned char **ptr, size_t num_bytes ) {
+
+	uint64_t word0;
+	uint64_t word1;
+	uint64_t word2;
+	uint64_t word3;
+	uint64_t crc0;
+	uint64_t crc1;
+	uint64_t crc2;
+	uint64_t crc3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	(void) slice;
+
+	crc0 = crc[0]; ptr0 = ptr[0];
+	crc1 = crc[1]; ptr1 = ptr[1];
+	crc2 = crc[2]; ptr2 = ptr[2];
+	crc3 = crc[3]; ptr3 = ptr[3];
+
+	while ( num_bytes >= 8 ) {
+
+		memcpy( &word0, ptr0, 8 ); ptr0 += 8;
+		memcpy( &word1, ptr1, 8 ); ptr1 += 8;
+		memcpy( &word2, ptr2, 8 ); ptr2 += 8;
+		memcpy( &word3, ptr3, 8 ); ptr3 += 8;
+
+		crc0 = _mm_crc32_u64( crc0, word0 );
+		crc1 = _mm_crc32_u64( crc1, word1 );
+		crc2 = _mm_crc32_u64( crc2, word2 );
+		crc3 = _mm_crc32_u64( crc3, word3 );
+
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes-- > 0 ) {
+
+		crc0 = _mm_crc32_u8( (uint32_t) crc0, *ptr0++ );
+		crc1 = _mm_crc32_u8( (uint32_t) crc1, *ptr1++ );
+		crc2 = _mm_crc32_u8( (uint32_t) crc2, *ptr2++ );
+		crc3 = _mm_crc32_u8( (uint32_t) crc3, *ptr3++ );
+	}
+
+	crc[0] = crc0; ptr[0] = ptr0;
+	crc[1] = crc1; ptr[1] = ptr1;
+	crc[2] = crc2; ptr[2] = ptr2;
+	crc[3] = crc3; ptr[3] = ptr3;
+
+}  /* multi_32c_sse42 */
+
+#endif
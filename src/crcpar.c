@@ -0,0 +1,362 @@
+/*
+ * Library: libcrc
+ * File:    src/crcpar.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcpar.c contains routines to calculate the CRC of large
+ * buffers with multiple threads. The buffer is split in chunks which are
+ * processed in parallel by a thread pool. The partial CRC values are stitched
+ * together with the combine functions, which gives the same result as the
+ * single threaded routines. The threads are created on first use and are kept
+ * alive for later calls. Small buffers are calculated directly by the calling
+ * thread, because the handoff to other threads would cost more than it saves.
+ *
+ * On platforms without POSIX threads, or when the library is compiled with
+ * LIBCRC_NO_THREADS defined, the routines always use the single threaded
+ * calculation.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_THREADS)
+#include <unistd.h>
+#endif
+
+/*
+ * #define PAR_xxxx
+ *
+ * Buffers shorter than PAR_MIN_BYTES are always calculated by the calling
+ * thread. The buffer is split in about PAR_CHUNKS_PER_THREAD chunks per thread
+ * so that a thread which is delayed does not hold up the whole calculation.
+ * Chunks are at least PAR_MIN_CHUNK bytes long and a multiple of PAR_ALIGN
+ * bytes, which keeps every chunk on its own cache lines and pages. The number
+ * of threads is limited to PAR_MAX_THREADS.
+ */
+
+#define PAR_MIN_BYTES		(512u*1024u)
+#define PAR_MIN_CHUNK		(128u*1024u)
+#define PAR_ALIGN		4096u
+#define PAR_CHUNKS_PER_THREAD	4
+#define PAR_MAX_THREADS		64
+
+typedef uint64_t (*par_calc_fn)( const unsigned char *input_str, size_t num_bytes );
+typedef uint64_t (*par_comb_fn)( uint64_t crc1, uint64_t crc2, size_t len2 );
+
+static uint64_t		par_calc( const unsigned char *input_str, size_t num_bytes, int num_threads, par_calc_fn calc, par_comb_fn comb );
+
+#if defined(LIBCRC_THREADS)
+
+/*
+ * struct par_job
+ *
+ * The structure par_job describes one parallel CRC calculation. Chunks are
+ * handed out in order to the threads of the pool and to the calling thread.
+ * The job is in the list of pending jobs as long as there are chunks which
+ * have not been handed out.
+ */
+
+							/************************************************/
+struct par_job {					/*						*/
+	struct par_job *	next;			/* Next job in the list of pending jobs		*/
+	par_calc_fn		calc;			/* Routine to calculate the CRC of a chunk	*/
+	const unsigned char *	input_str;		/* Start of the buffer				*/
+	size_t			num_bytes;		/* Length of the buffer				*/
+	size_t			chunk_size;		/* Length of all chunks except the last		*/
+	size_t			num_chunks;		/* Number of chunks				*/
+	size_t			next_chunk;		/* Next chunk to be handed out			*/
+	size_t			done_chunks;		/* Number of chunks which have been calculated	*/
+	uint64_t *		result;			/* The CRC values of the individual chunks	*/
+	pthread_cond_t		done;			/* Signalled when all chunks are calculated	*/
+};							/*						*/
+							/************************************************/
+
+static pthread_mutex_t		pool_lock		= PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t		pool_work		= PTHREAD_COND_INITIALIZER;
+static struct par_job *		pool_jobs		= NULL;
+static int			pool_size		= 0;
+
+static void			grow_pool( int num_threads );
+static void *			pool_worker( void *arg );
+static void			run_chunk( struct par_job *job );
+
+#endif
+
+/*
+ * Wrappers to call the CRC routines of different widths through the same
+ * function pointer types.
+ */
+
+static uint64_t par_crc_32(       const unsigned char *p, size_t n ) { return crc_32(       p, n ); }
+static uint64_t par_crc_32c(      const unsigned char *p, size_t n ) { return crc_32c(      p, n ); }
+static uint64_t par_crc_64_ecma(  const unsigned char *p, size_t n ) { return crc_64_ecma(  p, n ); }
+static uint64_t par_crc_64_we(    const unsigned char *p, size_t n ) { return crc_64_we(    p, n ); }
+
+static uint64_t par_comb_32(      uint64_t a, uint64_t b, size_t n ) { return crc_32_combine(      (uint32_t) a, (uint32_t) b, n ); }
+static uint64_t par_comb_32c(     uint64_t a, uint64_t b, size_t n ) { return crc_32c_combine(     (uint32_t) a, (uint32_t) b, n ); }
+static uint64_t par_comb_64_ecma( uint64_t a, uint64_t b, size_t n ) { return crc_64_ecma_combine( a, b, n ); }
+static uint64_t par_comb_64_we(   uint64_t a, uint64_t b, size_t n ) { return crc_64_we_combine(   a, b, n ); }
+
+/*
+ * uint32_t crc_32_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads );
+ *
+ * The function crc_32_parallel() calculates the same CRC-32 value as crc_32()
+ * with up to num_threads threads. When num_threads is zero or negative the
+ * number of online processors is used.
+ */
+
+uint32_t crc_32_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads ) {
+
+	return (uint32_t) par_calc( input_str, num_bytes, num_threads, par_crc_32, par_comb_32 );
+
+}  /* crc_32_parallel */
+
+/*
+ * uint32_t crc_32c_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads );
+ *
+ * The function crc_32c_parallel() calculates the same CRC-32C value as
+ * crc_32c() with up to num_threads threads.
+ */
+
+uint32_t crc_32c_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads ) {
+
+	return (uint32_t) par_calc( input_str, num_bytes, num_threads, par_crc_32c, par_comb_32c );
+
+}  /* crc_32c_parallel */
+
+/*
+ * uint64_t crc_64_ecma_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads );
+ *
+ * The function crc_64_ecma_parallel() calculates the same CRC-64 value as
+ * crc_64_ecma() with up to num_threads threads.
+ */
+
+uint64_t crc_64_ecma_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads ) {
+
+	return par_calc( input_str, num_bytes, num_threads, par_crc_64_ecma, par_comb_64_ecma );
+
+}  /* crc_64_ecma_parallel */
+
+/*
+ * uint64_t crc_64_we_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads );
+ *
+ * The function crc_64_we_parallel() calculates the same CRC-64 value as
+ * crc_64_we() with up to num_threads threads.
+ */
+
+uint64_t crc_64_we_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads ) {
+
+	return par_calc( input_str, num_bytes, num_threads, par_crc_64_we, par_comb_64_we );
+
+}  /* crc_64_we_parallel */
+
+/*
+ * static uint64_t par_calc( const unsigned char *input_str, size_t num_bytes, int num_threads, par_calc_fn calc, par_comb_fn comb );
+ *
+ * The function par_calc() splits the buffer in chunks, lets the thread pool
+ * and the calling thread calculate the CRC values of the chunks and combines
+ * them in the CRC value of the whole buffer. The calculation falls back to the
+ * single threaded routine if the buffer is small, if only one thread is
+ * requested or if the resources for the parallel calculation are not
+ * available.
+ */
+
+static uint64_t par_calc( const unsigned char *input_str, size_t num_bytes, int num_threads, par_calc_fn calc, par_comb_fn comb ) {
+
+#if defined(LIBCRC_THREADS)
+
+	long num_cpu;
+	size_t a;
+	size_t last;
+	uint64_t crc;
+	struct par_job job;
+
+	if ( input_str == NULL  ||  num_bytes < PAR_MIN_BYTES ) return calc( input_str, num_bytes );
+
+	if ( num_threads <= 0 ) {
+
+		num_cpu     = sysconf( _SC_NPROCESSORS_ONLN );
+		num_threads = ( num_cpu > PAR_MAX_THREADS ) ? PAR_MAX_THREADS : (int) num_cpu;
+	}
+
+	if ( num_threads > PAR_MAX_THREADS ) num_threads = PAR_MAX_THREADS;
+	if ( num_threads <= 1              ) return calc( input_str, num_bytes );
+
+	job.chunk_size = num_bytes / ( (size_t) num_threads * PAR_CHUNKS_PER_THREAD );
+	job.chunk_size = ( job.chunk_size + PAR_ALIGN - 1 ) & ~( (size_t) PAR_ALIGN - 1 );
+	if ( job.chunk_size < PAR_MIN_CHUNK ) job.chunk_size = PAR_MIN_CHUNK;
+
+	job.num_chunks = ( num_bytes + job.chunk_size - 1 ) / job.chunk_size;
+	job.result     = malloc( job.num_chunks * sizeof(uint64_t) );
+
+	if ( job.result == NULL ) return calc( input_str, num_bytes );
+
+	if ( pthread_cond_init( & job.done, NULL ) != 0 ) {
+
+		free( job.result );
+		return calc( input_str, num_bytes );
+	}
+
+	job.next        = NULL;
+	job.calc        = calc;
+	job.input_str   = input_str;
+	job.num_bytes   = num_bytes;
+	job.next_chunk  = 0;
+	job.done_chunks = 0;
+
+	pthread_mutex_lock( & pool_lock );
+
+	grow_pool( num_threads - 1 );
+
+	job.next  = pool_jobs;
+	pool_jobs = & job;
+
+	pthread_cond_broadcast( & pool_work );
+
+	while ( job.next_chunk  < job.num_chunks ) run_chunk( & job );
+	while ( job.done_chunks < job.num_chunks ) pthread_cond_wait( & job.done, & pool_lock );
+
+	pthread_mutex_unlock( & pool_lock );
+	pthread_cond_destroy( & job.done );
+
+	last = num_bytes - ( job.num_chunks - 1 ) * job.chunk_size;
+	crc  = job.result[0];
+
+	for (a=1; a<job.num_chunks; a++) crc = comb( crc, job.result[a], ( a == job.num_chunks-1 ) ? last : job.chunk_size );
+
+	free( job.result );
+
+	return crc;
+
+#else
+
+	(void) num_threads;
+	(void) comb;
+
+	return calc( input_str, num_bytes );
+
+#endif
+
+}  /* par_calc */
+
+#if defined(LIBCRC_THREADS)
+
+/*
+ * static void grow_pool( int num_threads );
+ *
+ * The function grow_pool() starts new worker threads until the pool contains
+ * at least num_threads threads. If a thread cannot be created the pool is
+ * left at its current size. The calculation is still correct in that case,
+ * because the calling thread processes all chunks which are not picked up by
+ * the pool. The function must be called with the pool lock held.
+ */
+
+static void grow_pool( int num_threads ) {
+
+	pthread_t thread;
+
+	while ( pool_size < num_threads ) {
+
+		if ( pthread_create( & thread, NULL, pool_worker, NULL ) != 0 ) return;
+
+		pthread_detach( thread );
+		pool_size++;
+	}
+
+}  /* grow_pool */
+
+/*
+ * static void *pool_worker( void *arg );
+ *
+ * The function pool_worker() is the main loop of the threads in the pool. A
+ * thread sleeps until a job with chunks is pending, and calculates the chunks
+ * of pending jobs until none are left.
+ */
+
+static void *pool_worker( void *arg ) {
+
+	(void) arg;
+
+	pthread_mutex_lock( & pool_lock );
+
+	for (;;) {
+
+		if ( pool_jobs == NULL ) pthread_cond_wait( & pool_work, & pool_lock );
+		else                     run_chunk( pool_jobs );
+	}
+
+	return NULL;
+
+}  /* pool_worker */
+
+/*
+ * static void run_chunk( struct par_job *job );
+ *
+ * The function run_chunk() takes the next chunk of a job and calculates its
+ * CRC value. The job is removed from the list of pending jobs when its last
+ * chunk is handed out. The function must be called with the pool lock held.
+ * The lock is released during the calculation.
+ */
+
+static void run_chunk( struct par_job *job ) {
+
+	size_t chunk;
+	size_t len;
+	struct par_job **ptr;
+
+	chunk = job->next_chunk++;
+
+	if ( job->next_chunk == job->num_chunks ) {
+
+		for (ptr=&pool_jobs; *ptr!=NULL; ptr=&(*ptr)->next) {
+
+			if ( *ptr == job ) {
+
+				*ptr = job->next;
+				break;
+			}
+		}
+	}
+
+	len = job->chunk_size;
+	if ( chunk == job->num_chunks-1 ) len = job->num_bytes - chunk * job->chunk_size;
+
+	pthread_mutex_unlock( & pool_lock );
+
+	job->result[chunk] = job->calc( job->input_str + chunk * job->chunk_size, len );
+
+	pthread_mutex_lock( & pool_lock );
+
+	job->done_chunks++;
+	if ( job->done_chunks == job->num_chunks ) pthread_cond_signal( & job->done );
+
+}  /* run_chunk */
+
+#endif
@@ -0,0 +1,283 @@
+/*
+ * Library: libcrc
+ * File:    src/crcpatch.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcpatch.c contains routines which update the CRC of a
+ * buffer after some bytes in it have been changed, without processing the
+ * rest of the buffer. Because the CRC is linear over GF(2), the CRC changes
+ * with the CRC of the difference between the old and new data, calculated
+ * without start value and final XOR and shifted over the bytes after the
+ * change. The time needed is proportional to the number of changed bytes plus
+ * the logarithm of the length of the buffer.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+
+/*
+ * #define PATCH_BLOCK_SIZE
+ *
+ * The difference between the old and new bytes is calculated in blocks of
+ * PATCH_BLOCK_SIZE bytes on the stack.
+ */
+
+#define PATCH_BLOCK_SIZE	256
+
+static uint64_t		patch_delta( int type, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+
+/*
+ * uint8_t crc_8_patch( uint8_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_8_patch() returns the CRC-8 of a buffer of total_len bytes
+ * after num_bytes bytes at offset have been changed from old_bytes to
+ * new_bytes, from the CRC-8 of the buffer before the change.
+ */
+
+uint8_t crc_8_patch( uint8_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint8_t) patch_delta( CRC_TYPE_8, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_8_patch */
+
+/*
+ * uint16_t crc_16_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_16_patch() returns the CRC-16 of a buffer after num_bytes
+ * bytes at offset have been changed, from the CRC-16 of the buffer before the
+ * change.
+ */
+
+uint16_t crc_16_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint16_t) patch_delta( CRC_TYPE_16, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_16_patch */
+
+/*
+ * uint16_t crc_modbus_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_modbus_patch() returns the Modbus CRC of a buffer after
+ * num_bytes bytes at offset have been changed, from the Modbus CRC of the
+ * buffer before the change.
+ */
+
+uint16_t crc_modbus_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint16_t) patch_delta( CRC_TYPE_MODBUS, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_modbus_patch */
+
+/*
+ * uint16_t crc_xmodem_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_xmodem_patch() returns the XModem CRC of a buffer after
+ * num_bytes bytes at offset have been changed, from the XModem CRC of the
+ * buffer before the change.
+ */
+
+uint16_t crc_xmodem_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint16_t) patch_delta( CRC_TYPE_XMODEM, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_xmodem_patch */
+
+/*
+ * uint16_t crc_ccitt_1d0f_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_ccitt_1d0f_patch() returns the CCITT CRC with start value
+ * 0x1D0F of a buffer after num_bytes bytes at offset have been changed, from
+ * the CCITT CRC with start value 0x1D0F of the buffer before the change.
+ */
+
+uint16_t crc_ccitt_1d0f_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint16_t) patch_delta( CRC_TYPE_CCITT_1D0F, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_ccitt_1d0f_patch */
+
+/*
+ * uint16_t crc_ccitt_ffff_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_ccitt_ffff_patch() returns the CCITT CRC with start value
+ * 0xFFFF of a buffer after num_bytes bytes at offset have been changed, from
+ * the CCITT CRC with start value 0xFFFF of the buffer before the change.
+ */
+
+uint16_t crc_ccitt_ffff_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint16_t) patch_delta( CRC_TYPE_CCITT_FFFF, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_ccitt_ffff_patch */
+
+/*
+ * uint16_t crc_kermit_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_kermit_patch() returns the Kermit CRC of a buffer after
+ * num_bytes bytes at offset have been changed, from the Kermit CRC of the
+ * buffer before the change. The byte swap of the CRC value is handled in the
+ * same way as by crc_ctx_final().
+ */
+
+uint16_t crc_kermit_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint16_t) patch_delta( CRC_TYPE_KERMIT, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_kermit_patch */
+
+/*
+ * uint16_t crc_dnp_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_dnp_patch() returns the DNP CRC of a buffer after num_bytes
+ * bytes at offset have been changed, from the DNP CRC of the buffer before the
+ * change. The byte swap of the CRC value is handled in the same way as by
+ * crc_ctx_final().
+ */
+
+uint16_t crc_dnp_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint16_t) patch_delta( CRC_TYPE_DNP, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_dnp_patch */
+
+/*
+ * uint16_t crc_sick_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_sick_patch() returns the SICK CRC of a buffer after
+ * num_bytes bytes at offset have been changed, from the SICK CRC of the buffer
+ * before the change. The SICK algorithm mixes the previous byte into the
+ * calculation of the next byte, which is linear as well, so the byte after the
+ * change is also taken into account.
+ */
+
+uint16_t crc_sick_patch( uint16_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint16_t) patch_delta( CRC_TYPE_SICK, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_sick_patch */
+
+/*
+ * uint32_t crc_32_patch( uint32_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_32_patch() returns the CRC-32 of a buffer after num_bytes
+ * bytes at offset have been changed, from the CRC-32 of the buffer before the
+ * change.
+ */
+
+uint32_t crc_32_patch( uint32_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint32_t) patch_delta( CRC_TYPE_32, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_32_patch */
+
+/*
+ * uint32_t crc_32c_patch( uint32_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_32c_patch() returns the CRC-32C of a buffer after num_bytes
+ * bytes at offset have been changed, from the CRC-32C of the buffer before the
+ * change.
+ */
+
+uint32_t crc_32c_patch( uint32_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ (uint32_t) patch_delta( CRC_TYPE_32C, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_32c_patch */
+
+/*
+ * uint64_t crc_64_ecma_patch( uint64_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_64_ecma_patch() returns the CRC-64/ECMA of a buffer after
+ * num_bytes bytes at offset have been changed, from the CRC-64/ECMA of the
+ * buffer before the change.
+ */
+
+uint64_t crc_64_ecma_patch( uint64_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ patch_delta( CRC_TYPE_64_ECMA, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_64_ecma_patch */
+
+/*
+ * uint64_t crc_64_we_patch( uint64_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function crc_64_we_patch() returns the CRC-64/WE of a buffer after
+ * num_bytes bytes at offset have been changed, from the CRC-64/WE of the
+ * buffer before the change.
+ */
+
+uint64_t crc_64_we_patch( uint64_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	return crc ^ patch_delta( CRC_TYPE_64_WE, total_len, offset, old_bytes, new_bytes, num_bytes );
+
+}  /* crc_64_we_patch */
+
+/*
+ * static uint64_t patch_delta( int type, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+ *
+ * The function patch_delta() calculates the value with which the final CRC of
+ * an algorithm changes when bytes in a buffer are changed. The difference of
+ * the bytes is added to a context with a zero register, which is then shifted
+ * over the bytes after the change. Zero bytes before the change do not alter
+ * a zero register and are skipped. The register is converted to a change of
+ * the final CRC by removing the final XOR value from crc_ctx_final(), which
+ * leaves the byte swap of some 16 bit algorithms. A change which does not fit
+ * in the buffer leaves the CRC unchanged.
+ */
+
+static uint64_t patch_delta( int type, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes ) {
+
+	size_t a;
+	size_t len;
+	size_t pos;
+	uint64_t zero;
+	struct crc_ctx ctx;
+	unsigned char diff[PATCH_BLOCK_SIZE];
+
+	if ( old_bytes == NULL  ||  new_bytes == NULL  ||  num_bytes == 0 ) return 0;
+	if ( offset > total_len  ||  num_bytes > total_len - offset        ) return 0;
+	if ( crc_ctx_init( & ctx, type ) == NULL                           ) return 0;
+
+	ctx.crc = 0;
+	zero    = crc_ctx_final( & ctx );
+
+	for (pos=0; pos<num_bytes; pos+=len) {
+
+		len = ( num_bytes - pos < PATCH_BLOCK_SIZE ) ? num_bytes - pos : PATCH_BLOCK_SIZE;
+
+		for (a=0; a<len; a++) diff[a] = old_bytes[pos+a] ^ new_bytes[pos+a];
+
+		crc_ctx_update( & ctx, diff, len );
+	}
+
+	crc_ctx_zeros( & ctx, total_len - offset - num_bytes );
+
+	return crc_ctx_final( & ctx ) ^ zero;
+
+}  /* patch_delta */
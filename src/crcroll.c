@@ -0,0 +1,357 @@
+/*
+ * Library: libcrc
+ * File:    src/crcroll.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcroll.c contains routines which calculate the CRC of
+ * a window of the last N bytes of a data stream. When a byte is added to the
+ * window the byte which falls out of it is removed in constant time with a
+ * lookup table. This makes it possible to find sync words or content defined
+ * chunk boundaries in one pass over the data.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+#include "crcint.h"
+
+static uint64_t		roll_convert( int type, uint64_t crc );
+static void		roll_history( struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes );
+
+/*
+ * struct crc_roll *crc_roll_init( struct crc_roll *roll, int type, size_t window );
+ *
+ * The function crc_roll_init() prepares a rolling CRC calculation for one of
+ * the CRC_TYPE_xxxx algorithms over a window of 1 to CRC_ROLL_MAX_WINDOW
+ * bytes. The window initially contains zero bytes. Two tables are calculated,
+ * the normal byte wise lookup table and a table with the contribution of a
+ * byte which leaves the window, including the correction for the start value.
+ * The register of algorithms which are calculated with the most significant
+ * bit first is kept in the highest bits of the 64 bit value so that the same
+ * shift works for all widths. The function returns NULL if the type or the
+ * window size is not supported. The SICK algorithm is not linear in the input
+ * bytes and cannot be used.
+ */
+
+struct crc_roll *crc_roll_init( struct crc_roll *roll, int type, size_t window ) {
+
+	int a;
+	int b;
+	int shift;
+	uint64_t start;
+	uint64_t corr;
+	uint64_t basis[8];
+	struct crc_ctx ctx;
+	const struct libcrc_poly *poly;
+
+	if ( roll == NULL  ||  window < 1  ||  window > CRC_ROLL_MAX_WINDOW ) return NULL;
+	if ( crc_ctx_init( & ctx, type ) == NULL ) return NULL;
+
+	switch ( type ) {
+
+		case CRC_TYPE_8           : poly = & libcrc_poly_8;      break;
+		case CRC_TYPE_16          :
+		case CRC_TYPE_MODBUS      : poly = & libcrc_poly_16;     break;
+		case CRC_TYPE_XMODEM      :
+		case CRC_TYPE_CCITT_1D0F  :
+		case CRC_TYPE_CCITT_FFFF  : poly = & libcrc_poly_ccitt;  break;
+		case CRC_TYPE_KERMIT      : poly = & libcrc_poly_kermit; break;
+		case CRC_TYPE_DNP         : poly = & libcrc_poly_dnp;    break;
+		case CRC_TYPE_32          : poly = & libcrc_poly_32;     break;
+		case CRC_TYPE_32C         : poly = & libcrc_poly_32c;    break;
+		case CRC_TYPE_64_ECMA     :
+		case CRC_TYPE_64_WE       : poly = & libcrc_poly_64;     break;
+		default                   : return NULL;
+	}
+
+	shift           = ( poly->reflected ) ? 0 : 64 - poly->bits;
+	roll->type      = type;
+	roll->bits      = poly->bits;
+	roll->reflected = poly->reflected;
+	roll->window    = window;
+	roll->count     = 0;
+
+	for (a=0; a<256; a++) {
+
+		switch ( type ) {
+
+			case CRC_TYPE_8           : roll->tab[a] = crc_tab8[a];              break;
+			case CRC_TYPE_16          :
+			case CRC_TYPE_MODBUS      : roll->tab[a] = crc_tab16[a];             break;
+			case CRC_TYPE_KERMIT      : roll->tab[a] = crc_tabkermit[a];         break;
+			case CRC_TYPE_DNP         : roll->tab[a] = crc_tabdnp[a];            break;
+			case CRC_TYPE_32          : roll->tab[a] = crc_tab32_slice[0][a];    break;
+			case CRC_TYPE_32C         : roll->tab[a] = crc_tab32c_slice[0][a];   break;
+			case CRC_TYPE_64_ECMA     :
+			case CRC_TYPE_64_WE       : roll->tab[a] = crc_tab64_slice[0][a];    break;
+			default                   : roll->tab[a] = crc_tabccitt[a];          break;
+		}
+	}
+
+	/*
+	 * The window starts with zero bytes, so the register is the start
+	 * value shifted over the window. A byte which leaves the window
+	 * contributes its table value shifted over the window. Because the
+	 * start value is also shifted one byte further by every new byte, the
+	 * difference between the start value shifted over window+1 and window
+	 * bytes is added to every entry of the out table.
+	 */
+
+	start = libcrc_shift( poly, ctx.crc, window );
+	corr  = libcrc_shift( poly, start, 1 ) ^ start;
+
+	for (b=0; b<8; b++) basis[b] = libcrc_shift( poly, roll->tab[1 << b], window );
+
+	for (a=0; a<256; a++) {
+
+		roll->out[a] = corr;
+		for (b=0; b<8; b++) if ( a & ( 1 << b ) ) roll->out[a] ^= basis[b];
+
+		roll->out[a] <<= shift;
+		roll->tab[a] <<= shift;
+	}
+
+	roll->crc = start << shift;
+	memset( roll->history, 0, sizeof(roll->history) );
+
+	return roll;
+
+}  /* crc_roll_init */
+
+/*
+ * void crc_roll_update( struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_roll_update() adds bytes to the window of a rolling CRC
+ * calculation. For every byte which is added the oldest byte of the window is
+ * removed. The search of crc_roll_find() is used with a value which can never
+ * match, so that all bytes are added.
+ */
+
+void crc_roll_update( struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes ) {
+
+	if ( roll == NULL  ||  input_str == NULL  ||  num_bytes == 0 ) return;
+
+	crc_roll_find( roll, input_str, num_bytes, 0, 1 );
+
+}  /* crc_roll_update */
+
+/*
+ * size_t crc_roll_find( struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes, uint64_t mask, uint64_t value );
+ *
+ * The function crc_roll_find() adds bytes to the window of a rolling CRC
+ * calculation until the CRC of a completely filled window, masked with mask,
+ * is equal to value. The CRC is compared in the form which crc_roll_final()
+ * returns. The number of bytes added is returned, including the byte which
+ * completed the matching window, or num_bytes if no match was found. The
+ * search continues with the next byte in the following call. Sync words are
+ * found with a mask with all bits set and the CRC of the sync word as value,
+ * content defined chunk boundaries with a mask with the number of bits for
+ * the average chunk size.
+ */
+
+size_t crc_roll_find( struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes, uint64_t mask, uint64_t value ) {
+
+	size_t a;
+	size_t window;
+	size_t skip;
+	size_t head;
+	int shift;
+	bool found;
+	uint64_t crc;
+	uint64_t width;
+	uint64_t zero;
+	uint64_t reg_mask;
+	uint64_t reg_value;
+	const uint64_t *tab;
+	const uint64_t *out;
+
+	if ( roll == NULL  ||  input_str == NULL  ||  num_bytes == 0 ) return 0;
+
+	/*
+	 * The final CRC is the register combined with an XOR value, and for
+	 * some 16 bit algorithms with the two bytes swapped. Without the XOR
+	 * value the conversion is its own inverse. The mask and value are
+	 * therefore converted to the register once, so that the register can
+	 * be compared directly in the loop. A value with bits outside the mask
+	 * or the width of the CRC never matches.
+	 */
+
+	width = ( roll->bits == 64 ) ? 0xFFFFFFFFFFFFFFFFull : ( 1ull << roll->bits ) - 1;
+	shift = ( roll->reflected ) ? 0 : 64 - roll->bits;
+	zero  = roll_convert( roll->type, 0 );
+
+	if ( ( value & ~( mask & width ) ) != 0 ) {
+
+		reg_mask  = 0;
+		reg_value = 1;
+	}
+
+	else {
+
+		reg_mask  = ( roll_convert( roll->type, mask & width              ) ^ zero ) << shift;
+		reg_value = ( roll_convert( roll->type, ( value ^ zero ) & mask ) ^ zero ) << shift;
+	}
+
+	window = roll->window;
+	tab    = roll->tab;
+	out    = roll->out;
+	crc    = roll->crc;
+	skip   = ( roll->count < window ) ? window - roll->count - 1 : 0;
+
+	/*
+	 * The bytes which leave the window are taken from the history until
+	 * the window has moved completely into the new data. The loops are
+	 * written separately for both bit orders and for both sources of old
+	 * bytes to keep the loop bodies free of branches.
+	 */
+
+	head  = ( num_bytes < window ) ? num_bytes : window;
+	a     = 0;
+	found = false;
+
+	if ( roll->reflected ) {
+
+		for (; a<head  &&  ! found; a++) {
+
+			crc   = ( crc >> 8 ) ^ tab[ ( crc ^ input_str[a] ) & 0xFF ] ^ out[ roll->history[a] ];
+			found = ( a >= skip  &&  ( crc & reg_mask ) == reg_value );
+		}
+
+		for (; a<num_bytes  &&  ! found; a++) {
+
+			crc   = ( crc >> 8 ) ^ tab[ ( crc ^ input_str[a] ) & 0xFF ] ^ out[ input_str[a-window] ];
+			found = ( ( crc & reg_mask ) == reg_value );
+		}
+	}
+
+	else {
+
+		for (; a<head  &&  ! found; a++) {
+
+			crc   = ( crc << 8 ) ^ tab[ ( crc >> 56 ) ^ input_str[a] ] ^ out[ roll->history[a] ];
+			found = ( a >= skip  &&  ( crc & reg_mask ) == reg_value );
+		}
+
+		for (; a<num_bytes  &&  ! found; a++) {
+
+			crc   = ( crc << 8 ) ^ tab[ ( crc >> 56 ) ^ input_str[a] ] ^ out[ input_str[a-window] ];
+			found = ( ( crc & reg_mask ) == reg_value );
+		}
+	}
+
+	roll->crc   = crc;
+	roll->count = ( roll->count + a < window ) ? roll->count + a : window;
+	roll_history( roll, input_str, a );
+
+	return a;
+
+}  /* crc_roll_find */
+
+/*
+ * struct crc_ctx *crc_roll_ctx( const struct crc_roll *roll, struct crc_ctx *ctx );
+ *
+ * The function crc_roll_ctx() initializes a streaming CRC context with the
+ * state after the bytes in the window. Further data can be added with
+ * crc_ctx_update() to calculate the CRC of a frame which starts with the
+ * window, for example a frame which starts with a sync word which has been
+ * found with crc_roll_find(). The function returns the context, or NULL if
+ * one of the parameters is NULL.
+ */
+
+struct crc_ctx *crc_roll_ctx( const struct crc_roll *roll, struct crc_ctx *ctx ) {
+
+	if ( roll == NULL  ||  ctx == NULL ) return NULL;
+
+	crc_ctx_init( ctx, roll->type );
+
+	ctx->crc       = ( roll->reflected ) ? roll->crc : roll->crc >> ( 64 - roll->bits );
+	ctx->prev_byte = roll->history[roll->window-1];
+
+	return ctx;
+
+}  /* crc_roll_ctx */
+
+/*
+ * uint64_t crc_roll_final( const struct crc_roll *roll );
+ *
+ * The function crc_roll_final() returns the CRC of the bytes in the window,
+ * with the same value as the one pass function of the algorithm returns for
+ * those bytes. Until the window has been filled completely the value is the
+ * CRC of the bytes preceded by zero bytes up to the window size.
+ */
+
+uint64_t crc_roll_final( const struct crc_roll *roll ) {
+
+	struct crc_ctx ctx;
+
+	if ( roll == NULL ) return 0;
+
+	return crc_ctx_final( crc_roll_ctx( roll, & ctx ) );
+
+}  /* crc_roll_final */
+
+/*
+ * static uint64_t roll_convert( int type, uint64_t crc );
+ *
+ * The function roll_convert() converts a register value of an algorithm to
+ * the final CRC in the same way as crc_ctx_final() does.
+ */
+
+static uint64_t roll_convert( int type, uint64_t crc ) {
+
+	struct crc_ctx ctx;
+
+	crc_ctx_init( & ctx, type );
+	ctx.crc = crc;
+
+	return crc_ctx_final( & ctx );
+
+}  /* roll_convert */
+
+/*
+ * static void roll_history( struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function roll_history() stores the last bytes of the window after
+ * num_bytes bytes have been added. The oldest byte is stored first.
+ */
+
+static void roll_history( struct crc_roll *roll, const unsigned char *input_str, size_t num_bytes ) {
+
+	size_t window;
+
+	window = roll->window;
+
+	if ( num_bytes >= window ) memcpy( roll->history, input_str + num_bytes - window, window );
+	else {
+
+		memmove( roll->history, roll->history + num_bytes, window - num_bytes );
+		memcpy(  roll->history + window - num_bytes, input_str, num_bytes );
+	}
+
+}  /* roll_history */
@@ -34,6 +34,17 @@
 
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
+
+static uint32_t		sick_sum( uint64_t val );
+
+/*
+ * Include the lookup tables for the SICK CRC calculation. The file contains
+ * the table crc_tabsick[] with the values b*x^16 mod P and the derived table
+ * crc_tabsick_slice[1][] with the values b*x^24 mod P.
+ */
+
+#include "../tab/gentabsick.inc"
 
 /*
  * uint16_t crc_sick( const unsigned char *input_str, size_t num_bytes );
@@ -47,27 +58,8 @@ uint16_t crc_sick( const unsigned char *input_str, size_t num_bytes ) {
 	uint16_t crc;
 	uint16_t low_byte;
 	uint16_t high_byte;
-	uint16_t short_c;
-	uint16_t short_p;
-	const unsigned char *ptr;
-	size_t a;
 
-	crc     = CRC_START_SICK;
-	ptr     = input_str;
-	short_p = 0;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		short_c = 0x00FF & (uint16_t) *ptr;
-
-		if ( crc & 0x8000 ) crc = ( crc << 1 ) ^ CRC_POLY_SICK;
-		else                crc =   crc << 1;
-
-		crc    ^= ( short_c | short_p );
-		short_p = short_c << 8;
-
-		ptr++;
-	}
+	crc = update_crc_sick_block( CRC_START_SICK, input_str, num_bytes, 0 );
 
 	low_byte  = (crc & 0xFF00) >> 8;
 	high_byte = (crc & 0x00FF) << 8;
@@ -100,3 +92,86 @@ uint16_t update_crc_sick( uint16_t crc, unsigned char c, unsigned char prev_byte
 	return crc;
 
 }  /* update_crc_sick */
+
+/*
+ * uint16_t update_crc_sick_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes, unsigned char prev_byte );
+ *
+ * The function update_crc_sick_block() calculates a new CRC-SICK value based
+ * on the previous value of the CRC and a block of data to be checked. The
+ * parameter prev_byte is the last byte before the block, or zero at the start
+ * of the data. The bytes of the result are not swapped.
+ *
+ * The SICK algorithm shifts the CRC only one bit per byte and adds the current
+ * and the previous byte as a 16 bit value. Sixteen steps can therefore be
+ * combined in one calculation. The CRC is multiplied with x^16, and each data
+ * byte c[j] contributes c[j] * x^(15-j) * (1 + x^7), except that the last byte
+ * of the block only contributes c[15]. Its x^7 term is added in the next block
+ * as the previous byte. The sum of the data terms is calculated with shifts of
+ * 64 bit words, and the resulting 32 bit value is reduced modulo the
+ * polynomial with two table lookups. Trailing bytes are processed one by one.
+ */
+
+uint16_t update_crc_sick_block( uint16_t crc, const unsigned char *input_str, size_t num_bytes, unsigned char prev_byte ) {
+
+	uint16_t short_c;
+	uint16_t short_p;
+	uint32_t sum;
+	uint32_t val;
+	const unsigned char *ptr;
+
+	ptr = input_str;
+	if ( ptr == NULL ) return crc;
+
+	while ( num_bytes >= 16 ) {
+
+		sum  = ( sick_sum( LOAD_BE64( ptr ) ) << 8 ) ^ sick_sum( LOAD_BE64( ptr + 8 ) );
+
+		val  = (uint32_t) ( crc ^ ( (uint16_t) prev_byte << 7 ) ) << 16;
+		val ^= sum ^ ( sum << 7 ) ^ ( (uint32_t) ptr[15] << 7 );
+
+		crc  = crc_tabsick_slice[1][  val >> 24         ]
+		     ^ crc_tabsick[          (val >> 16) & 0xFF ]
+		     ^ (uint16_t) val;
+
+		prev_byte  = ptr[15];
+		ptr       += 16;
+		num_bytes -= 16;
+	}
+
+	short_p = ( 0x00FF & (uint16_t) prev_byte ) << 8;
+
+	while ( num_bytes-- > 0 ) {
+
+		short_c = 0x00FF & (uint16_t) *ptr;
+
+		if ( crc & 0x8000 ) crc = ( crc << 1 ) ^ CRC_POLY_SICK;
+		else                crc =   crc << 1;
+
+		crc    ^= ( short_c | short_p );
+		short_p = short_c << 8;
+
+		ptr++;
+	}
+
+	return crc;
+
+}  /* update_crc_sick_block */
+
+/*
+ * static uint32_t sick_sum( uint64_t val );
+ *
+ * The function sick_sum() calculates the sum of c[j] * x^(7-j) of the eight
+ * bytes in a big endian 64 bit word, where c[0] is the highest byte. Adjacent
+ * partial sums are combined in parallel in lanes of 16, 32 and 64 bits. The
+ * result has a width of 15 bits.
+ */
+
+static uint32_t sick_sum( uint64_t val ) {
+
+	val = ( (val >>  7) & 0x01FE01FE01FE01FEull ) ^ ( val & 0x00FF00FF00FF00FFull );
+	val = ( (val >> 14) & 0x000007FC000007FCull ) ^ ( val & 0x000001FF000001FFull );
+	val = ( (val >> 28) & 0x0000000000007FF0ull ) ^ ( val & 0x00000000000007FFull );
+
+	return (uint32_t) val;
+
+}  /* sick_sum */
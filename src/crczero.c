@@ -0,0 +1,290 @@
+/*
+ * Library: libcrc
+ * File:    src/crczero.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crczero.c contains routines which advance a CRC value
+ * over a run of zero bytes without processing the bytes themselves. The CRC
+ * register is multiplied with x^(8n) modulo the CRC polynomial, which takes
+ * time proportional to the logarithm of the number of zero bytes. This makes
+ * the CRC calculation of sparse files and preallocated storage cheap.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+/*
+ * #define ZERO_BLOCK_SIZE
+ * #define ZERO_DIRECT_MAX
+ *
+ * Shifting the register costs one polynomial multiplication for every bit in
+ * the number of zero bytes, which is slower than processing a short run with
+ * the normal table or folding routines. Runs of up to ZERO_DIRECT_MAX bytes
+ * are therefore added to a context as data, ZERO_BLOCK_SIZE bytes at a time.
+ */
+
+#define ZERO_BLOCK_SIZE		1024
+#define ZERO_DIRECT_MAX		4096
+
+static const unsigned char	zero_block[ZERO_BLOCK_SIZE];
+
+/*
+ * uint8_t crc_8_zeros( uint8_t crc, uint64_t num_bytes );
+ *
+ * The function crc_8_zeros() returns the CRC-8 of data with num_bytes zero
+ * bytes appended, from the CRC-8 of the data itself.
+ */
+
+uint8_t crc_8_zeros( uint8_t crc, uint64_t num_bytes ) {
+
+	return (uint8_t) libcrc_shift( &libcrc_poly_8, crc, num_bytes );
+
+}  /* crc_8_zeros */
+
+/*
+ * uint16_t crc_16_zeros( uint16_t crc, uint64_t num_bytes );
+ *
+ * The function crc_16_zeros() returns the CRC-16 of data with num_bytes zero
+ * bytes appended, from the CRC-16 of the data itself.
+ */
+
+uint16_t crc_16_zeros( uint16_t crc, uint64_t num_bytes ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_16, crc, num_bytes );
+
+}  /* crc_16_zeros */
+
+/*
+ * uint16_t crc_modbus_zeros( uint16_t crc, uint64_t num_bytes );
+ *
+ * The function crc_modbus_zeros() returns the Modbus CRC of data with
+ * num_bytes zero bytes appended. The Modbus CRC is not inverted at the end,
+ * so the CRC value is the register itself.
+ */
+
+uint16_t crc_modbus_zeros( uint16_t crc, uint64_t num_bytes ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_16, crc, num_bytes );
+
+}  /* crc_modbus_zeros */
+
+/*
+ * uint16_t crc_xmodem_zeros( uint16_t crc, uint64_t num_bytes );
+ *
+ * The function crc_xmodem_zeros() returns the XModem CRC of data with
+ * num_bytes zero bytes appended.
+ */
+
+uint16_t crc_xmodem_zeros( uint16_t crc, uint64_t num_bytes ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_ccitt, crc, num_bytes );
+
+}  /* crc_xmodem_zeros */
+
+/*
+ * uint16_t crc_ccitt_1d0f_zeros( uint16_t crc, uint64_t num_bytes );
+ *
+ * The function crc_ccitt_1d0f_zeros() returns the CCITT CRC with start value
+ * 0x1D0F of data with num_bytes zero bytes appended.
+ */
+
+uint16_t crc_ccitt_1d0f_zeros( uint16_t crc, uint64_t num_bytes ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_ccitt, crc, num_bytes );
+
+}  /* crc_ccitt_1d0f_zeros */
+
+/*
+ * uint16_t crc_ccitt_ffff_zeros( uint16_t crc, uint64_t num_bytes );
+ *
+ * The function crc_ccitt_ffff_zeros() returns the CCITT CRC with start value
+ * 0xFFFF of data with num_bytes zero bytes appended.
+ */
+
+uint16_t crc_ccitt_ffff_zeros( uint16_t crc, uint64_t num_bytes ) {
+
+	return (uint16_t) libcrc_shift( &libcrc_poly_ccitt, crc, num_bytes );
+
+}  /* crc_ccitt_ffff_zeros */
+
+/*
+ * uint16_t crc_kermit_zeros( uint16_t crc, uint64_t num_bytes );
+ *
+ * The function crc_kermit_zeros() returns the Kermit CRC of data with
+ * num_bytes zero bytes appended. The Kermit CRC is returned with the bytes
+ * swapped, so the swap is undone before the calculation and redone after it.
+ */
+
+uint16_t crc_kermit_zeros( uint16_t crc, uint64_t num_bytes ) {
+
+	return SWAP16( libcrc_shift( &libcrc_poly_kermit, SWAP16( crc ), num_bytes ) );
+
+}  /* crc_kermit_zeros */
+
+/*
+ * uint16_t crc_dnp_zeros( uint16_t crc, uint64_t num_bytes );
+ *
+ * The function crc_dnp_zeros() returns the DNP CRC of data with num_bytes
+ * zero bytes appended. The DNP CRC is inverted and byte swapped after the
+ * calculation, which is undone before the register is shifted.
+ */
+
+uint16_t crc_dnp_zeros( uint16_t crc, uint64_t num_bytes ) {
+
+	return SWAP16( ~libcrc_shift( &libcrc_poly_dnp, SWAP16( crc ) ^ 0xFFFF, num_bytes ) );
+
+}  /* crc_dnp_zeros */
+
+/*
+ * uint16_t crc_sick_zeros( uint16_t crc, uint64_t num_bytes, unsigned char last_byte );
+ *
+ * The function crc_sick_zeros() returns the SICK CRC of data with num_bytes
+ * zero bytes appended. The SICK algorithm mixes the previous byte into the CRC
+ * when the next byte is processed, so the last byte of the data must be passed
+ * as a parameter, or 0 if the data is empty.
+ */
+
+uint16_t crc_sick_zeros( uint16_t crc, uint64_t num_bytes, unsigned char last_byte ) {
+
+	uint64_t reg;
+
+	if ( num_bytes == 0 ) return crc;
+
+	reg  = libcrc_shift( &libcrc_poly_sick, SWAP16( crc ),                num_bytes     );
+	reg ^= libcrc_shift( &libcrc_poly_sick, ((uint16_t) last_byte) << 8, num_bytes - 1 );
+
+	return SWAP16( reg );
+
+}  /* crc_sick_zeros */
+
+/*
+ * uint32_t crc_32_zeros( uint32_t crc, uint64_t num_bytes );
+ *
+ * The function crc_32_zeros() returns the CRC-32 of data with num_bytes zero
+ * bytes appended. The final inversion of the CRC-32 is removed before the
+ * register is shifted and applied again afterwards.
+ */
+
+uint32_t crc_32_zeros( uint32_t crc, uint64_t num_bytes ) {
+
+	return (uint32_t) libcrc_shift( &libcrc_poly_32, crc ^ 0xFFFFFFFFul, num_bytes ) ^ 0xFFFFFFFFul;
+
+}  /* crc_32_zeros */
+
+/*
+ * uint32_t crc_32c_zeros( uint32_t crc, uint64_t num_bytes );
+ *
+ * The function crc_32c_zeros() returns the CRC-32C of data with num_bytes
+ * zero bytes appended.
+ */
+
+uint32_t crc_32c_zeros( uint32_t crc, uint64_t num_bytes ) {
+
+	return (uint32_t) libcrc_shift( &libcrc_poly_32c, crc ^ 0xFFFFFFFFul, num_bytes ) ^ 0xFFFFFFFFul;
+
+}  /* crc_32c_zeros */
+
+/*
+ * uint64_t crc_64_ecma_zeros( uint64_t crc, uint64_t num_bytes );
+ *
+ * The function crc_64_ecma_zeros() returns the CRC-64/ECMA of data with
+ * num_bytes zero bytes appended.
+ */
+
+uint64_t crc_64_ecma_zeros( uint64_t crc, uint64_t num_bytes ) {
+
+	return libcrc_shift( &libcrc_poly_64, crc, num_bytes );
+
+}  /* crc_64_ecma_zeros */
+
+/*
+ * uint64_t crc_64_we_zeros( uint64_t crc, uint64_t num_bytes );
+ *
+ * The function crc_64_we_zeros() returns the CRC-64/WE of data with num_bytes
+ * zero bytes appended. The final inversion is removed before the register is
+ * shifted and applied again afterwards.
+ */
+
+uint64_t crc_64_we_zeros( uint64_t crc, uint64_t num_bytes ) {
+
+	return libcrc_shift( &libcrc_poly_64, crc ^ 0xFFFFFFFFFFFFFFFFull, num_bytes ) ^ 0xFFFFFFFFFFFFFFFFull;
+
+}  /* crc_64_we_zeros */
+
+/*
+ * void crc_ctx_zeros( struct crc_ctx *ctx, uint64_t num_bytes );
+ *
+ * The function crc_ctx_zeros() adds num_bytes zero bytes to a streaming CRC
+ * context, with the same result as crc_ctx_update() with a buffer filled with
+ * zeros. The context holds the CRC register, so it can be shifted directly.
+ * Short runs are processed as data, which is faster.
+ */
+
+void crc_ctx_zeros( struct crc_ctx *ctx, uint64_t num_bytes ) {
+
+	size_t len;
+
+	if ( ctx == NULL  ||  num_bytes == 0 ) return;
+
+	if ( num_bytes <= ZERO_DIRECT_MAX ) {
+
+		while ( num_bytes > 0 ) {
+
+			len        = ( num_bytes < ZERO_BLOCK_SIZE ) ? (size_t) num_bytes : ZERO_BLOCK_SIZE;
+			num_bytes -= len;
+
+			crc_ctx_update( ctx, zero_block, len );
+		}
+
+		return;
+	}
+
+	switch ( ctx->type ) {
+
+		case CRC_TYPE_8           : ctx->crc = libcrc_shift( &libcrc_poly_8,      ctx->crc, num_bytes ); break;
+		case CRC_TYPE_16          :
+		case CRC_TYPE_MODBUS      : ctx->crc = libcrc_shift( &libcrc_poly_16,     ctx->crc, num_bytes ); break;
+		case CRC_TYPE_XMODEM      :
+		case CRC_TYPE_CCITT_1D0F  :
+		case CRC_TYPE_CCITT_FFFF  : ctx->crc = libcrc_shift( &libcrc_poly_ccitt,  ctx->crc, num_bytes ); break;
+		case CRC_TYPE_KERMIT      : ctx->crc = libcrc_shift( &libcrc_poly_kermit, ctx->crc, num_bytes ); break;
+		case CRC_TYPE_DNP         : ctx->crc = libcrc_shift( &libcrc_poly_dnp,    ctx->crc, num_bytes ); break;
+		case CRC_TYPE_32          : ctx->crc = libcrc_shift( &libcrc_poly_32,     ctx->crc, num_bytes ); break;
+		case CRC_TYPE_32C         : ctx->crc = libcrc_shift( &libcrc_poly_32c,    ctx->crc, num_bytes ); break;
+		case CRC_TYPE_64_ECMA     :
+		case CRC_TYPE_64_WE       : ctx->crc = libcrc_shift( &libcrc_poly_64,     ctx->crc, num_bytes ); break;
+
+		case CRC_TYPE_SICK        : ctx->crc       = libcrc_shift( &libcrc_poly_sick, ctx->crc,                          num_bytes     )
+							 ^ libcrc_shift( &libcrc_poly_sick, ((uint16_t) ctx->prev_byte) << 8, num_bytes - 1 );
+					    ctx->prev_byte = 0;
+					    break;
+	}
+
+}  /* crc_ctx_zeros */
@@ -31,7 +31,6 @@
  * in NMEA messages.
  */
 
-#include <stdio.h>
 #include <stdlib.h>
 #include "checksum.h"
 
@@ -51,13 +50,15 @@
  *
  * The result buffer must be at least three characters long. Two for the
  * checksum value and the third to store the EOS. The result buffer is not
- * filled when an error occurs.
+ * filled when an error occurs. The hexadecimal digits are looked up in a
+ * table instead of formatted with snprintf().
  */
 
 unsigned char * checksum_NMEA( const unsigned char *input_str, unsigned char *result ) {
 
 	const unsigned char *ptr;
 	unsigned char checksum;
+	static const char hex[] = "0123456789ABCDEF";
 
 	if ( input_str == NULL ) return NULL;
 	if ( result    == NULL ) return NULL;
@@ -69,7 +70,9 @@ unsigned char * checksum_NMEA( const unsigned char *input_str, unsigned char *re
 
 	while ( *ptr  &&  *ptr != '\r'  &&  *ptr != '\n'  &&  *ptr != '*' ) checksum ^= *ptr++;
 
-	snprintf( (char *) result, 3, "%02X", checksum );
+	result[0] = (unsigned char) hex[checksum >> 4];
+	result[1] = (unsigned char) hex[checksum & 0x0F];
+	result[2] = '\0';
 
 	return result; 
 
@@ -0,0 +1,278 @@
+/*
+ * Library: libcrc
+ * File:    src/nmea-scan.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/nmea-scan.c contains routines which find the NMEA and
+ * AIS sentences in a buffer with many sentences and validate their checksums
+ * in one pass. On x86-64 platforms the delimiters are searched and the
+ * checksums calculated sixteen bytes at a time with SSE2 instructions. The
+ * search routines are shared with the stream parser in src/nmea-stream.c.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+#define NMEA_DELIMITER(c)	( (c) == '*'  ||  (c) == '\r'  ||  (c) == '\n'  ||  (c) == '$'  ||  (c) == '!' )
+
+#if defined(LIBCRC_X86_SIMD)
+
+/*
+ * static const unsigned char nmea_mask[32];
+ *
+ * The table nmea_mask[] is used to load a mask with the first N bytes set.
+ * The mask for N bytes starts at offset 16 - N.
+ */
+
+static const unsigned char nmea_mask[32] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+#endif
+
+/*
+ * size_t checksum_NMEA_scan( const unsigned char *input_str, size_t num_bytes, struct nmea_sentence *sentence, size_t max_sentences, size_t *num_used );
+ *
+ * The function checksum_NMEA_scan() searches a buffer for NMEA sentences which
+ * start with '$' and AIS sentences which start with '!'. For every sentence
+ * the offset, the length without the line terminator, the calculated checksum
+ * and the result of the validation are stored in the sentence array. Bytes
+ * outside sentences are skipped. A sentence which is not terminated before
+ * the end of the buffer is not reported. The number of bytes which have been
+ * processed is stored in num_used if that pointer is not NULL. The caller can
+ * keep the remaining bytes and pass them again with the data which follows.
+ * The function returns the number of sentences found, at most max_sentences.
+ */
+
+size_t checksum_NMEA_scan( const unsigned char *input_str, size_t num_bytes, struct nmea_sentence *sentence, size_t max_sentences, size_t *num_used ) {
+
+	size_t pos;
+	size_t start;
+	size_t end;
+	size_t star;
+	size_t found;
+	int status;
+	int high;
+	int low;
+	unsigned char checksum;
+	unsigned char dummy;
+
+	found = 0;
+	pos   = 0;
+
+	if ( input_str == NULL  ||  sentence == NULL ) num_bytes = 0;
+
+	while ( found < max_sentences ) {
+
+		start = pos + libcrc_nmea_start( input_str + pos, num_bytes - pos );
+		if ( start >= num_bytes ) { pos = num_bytes; break; }
+
+		checksum = 0;
+		end      = start + 1 + libcrc_nmea_payload( input_str + start + 1, num_bytes - start - 1, & checksum );
+		if ( end >= num_bytes ) { pos = start; break; }
+
+		switch ( input_str[end] ) {
+
+			case '\r' :
+			case '\n' : status = NMEA_STATUS_NO_CHECKSUM;
+				    break;
+
+			case '*'  : star = end;
+				    end  = star + 1;
+
+				    for (;;) {
+
+					end += libcrc_nmea_payload( input_str + end, num_bytes - end, & dummy );
+					if ( end >= num_bytes  ||  input_str[end] != '*' ) break;
+					end++;
+				    }
+
+				    if ( end >= num_bytes ) {
+
+					status = NMEA_STATUS_MALFORMED;
+					break;
+				    }
+
+				    high = -1;
+				    low  = -1;
+
+				    if ( end == star + 3 ) {
+
+					high = libcrc_nmea_hex( input_str[star+1] );
+					low  = libcrc_nmea_hex( input_str[star+2] );
+				    }
+
+				    if      ( high < 0  ||  low < 0 )                           status = NMEA_STATUS_MALFORMED;
+				    else if ( checksum == (unsigned char) ( high * 16 + low ) ) status = NMEA_STATUS_VALID;
+				    else                                                     status = NMEA_STATUS_BAD_CHECKSUM;
+				    break;
+
+			default   : status = NMEA_STATUS_MALFORMED;
+				    break;
+		}
+
+		if ( end >= num_bytes ) { pos = start; break; }
+
+		sentence[found].offset   = start;
+		sentence[found].length   = end - start;
+		sentence[found].checksum = checksum;
+		sentence[found].status   = status;
+
+		found++;
+		pos = end;
+	}
+
+	if ( num_used != NULL ) *num_used = pos;
+
+	return found;
+
+}  /* checksum_NMEA_scan */
+
+/*
+ * size_t libcrc_nmea_start( const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function libcrc_nmea_start() returns the offset of the first '$' or '!'
+ * character in a buffer, or num_bytes if the buffer does not contain the
+ * start of a sentence.
+ */
+
+size_t libcrc_nmea_start( const unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+#if defined(LIBCRC_X86_SIMD)
+	__m128i x;
+	unsigned int mask;
+#endif
+
+	a = 0;
+
+#if defined(LIBCRC_X86_SIMD)
+	while ( a + 16 <= num_bytes ) {
+
+		x    = _mm_loadu_si128( (const __m128i *) (ptr + a) );
+		mask = (unsigned int) _mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( x, _mm_set1_epi8( '$' ) ), _mm_cmpeq_epi8( x, _mm_set1_epi8( '!' ) ) ) );
+
+		if ( mask != 0 ) return a + (size_t) __builtin_ctz( mask );
+
+		a += 16;
+	}
+#endif
+
+	while ( a < num_bytes  &&  ptr[a] != '$'  &&  ptr[a] != '!' ) a++;
+
+	return a;
+
+}  /* libcrc_nmea_start */
+
+/*
+ * size_t libcrc_nmea_payload( const unsigned char *ptr, size_t num_bytes, unsigned char *checksum );
+ *
+ * The function libcrc_nmea_payload() calculates the exclusive or of all bytes
+ * up to the first '*', CR, LF, '$' or '!' character and combines it with the
+ * checksum. The offset of that delimiter is returned, or num_bytes if the
+ * buffer does not contain a delimiter. The SIMD version combines sixteen
+ * bytes per step in a vector register which is reduced to one byte at the
+ * end. The bytes after the delimiter are masked out of the last vector.
+ */
+
+size_t libcrc_nmea_payload( const unsigned char *ptr, size_t num_bytes, unsigned char *checksum ) {
+
+	size_t a;
+	unsigned char value;
+#if defined(LIBCRC_X86_SIMD)
+	__m128i x;
+	__m128i delim;
+	__m128i acc;
+	unsigned int mask;
+#endif
+
+	a     = 0;
+	value = *checksum;
+
+#if defined(LIBCRC_X86_SIMD)
+	acc = _mm_setzero_si128();
+
+	while ( a + 16 <= num_bytes ) {
+
+		x     = _mm_loadu_si128( (const __m128i *) (ptr + a) );
+		delim = _mm_or_si128(              _mm_cmpeq_epi8( x, _mm_set1_epi8( '*'  ) ),
+			_mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( x, _mm_set1_epi8( '\r' ) ), _mm_cmpeq_epi8( x, _mm_set1_epi8( '\n' ) ) ),
+				      _mm_or_si128( _mm_cmpeq_epi8( x, _mm_set1_epi8( '$'  ) ), _mm_cmpeq_epi8( x, _mm_set1_epi8( '!'  ) ) ) ) );
+		mask  = (unsigned int) _mm_movemask_epi8( delim );
+
+		if ( mask != 0 ) {
+
+			mask = (unsigned int) __builtin_ctz( mask );
+			acc  = _mm_xor_si128( acc, _mm_and_si128( x, _mm_loadu_si128( (const __m128i *) (nmea_mask + 16 - mask) ) ) );
+			a   += mask;
+			break;
+		}
+
+		acc = _mm_xor_si128( acc, x );
+		a  += 16;
+	}
+
+	acc    = _mm_xor_si128( acc, _mm_srli_si128( acc, 8 ) );
+	acc    = _mm_xor_si128( acc, _mm_srli_si128( acc, 4 ) );
+	acc    = _mm_xor_si128( acc, _mm_srli_si128( acc, 2 ) );
+	acc    = _mm_xor_si128( acc, _mm_srli_si128( acc, 1 ) );
+	value ^= (unsigned char) _mm_cvtsi128_si32( acc );
+
+#endif
+
+	while ( a < num_bytes  &&  ! NMEA_DELIMITER( ptr[a] ) ) value ^= ptr[a++];
+
+	*checksum = value;
+
+	return a;
+
+}  /* libcrc_nmea_payload */
+
+/*
+ * int libcrc_nmea_hex( unsigned char c );
+ *
+ * The function libcrc_nmea_hex() returns the value of a hexadecimal digit in
+ * upper or lower case, or -1 if the character is not a hexadecimal digit.
+ */
+
+int libcrc_nmea_hex( unsigned char c ) {
+
+	if ( c >= '0'  &&  c <= '9' ) return c - '0';
+	if ( c >= 'A'  &&  c <= 'F' ) return c - 'A' + 10;
+	if ( c >= 'a'  &&  c <= 'f' ) return c - 'a' + 10;
+
+	return -1;
+
+}  /* libcrc_nmea_hex */
@@ -0,0 +1,234 @@
+/*
+ * Library: libcrc
+ * File:    src/nmea-stream.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/nmea-stream.c contains an incremental parser for NMEA
+ * and AIS sentences which arrive in arbitrary chunks, for example from the
+ * read() calls on a serial port. The checksum is carried over from one chunk
+ * to the next, so that every byte is processed only once.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#define NMEA_STATE_IDLE		0
+#define NMEA_STATE_PAYLOAD	1
+#define NMEA_STATE_FIELD	2
+
+static void		stream_save( struct nmea_stream *stream, const unsigned char *ptr, size_t num_bytes );
+
+/*
+ * struct nmea_stream *checksum_NMEA_stream_init( struct nmea_stream *stream );
+ *
+ * The function checksum_NMEA_stream_init() prepares a stream state for a new
+ * stream. Data before the first '$' or '!' is ignored. The function returns a
+ * pointer to the state, or NULL if a NULL pointer was passed.
+ */
+
+struct nmea_stream *checksum_NMEA_stream_init( struct nmea_stream *stream ) {
+
+	if ( stream == NULL ) return NULL;
+
+	stream->state     = NMEA_STATE_IDLE;
+	stream->checksum  = 0;
+	stream->field[0]  = 0;
+	stream->field[1]  = 0;
+	stream->field_len = 0;
+	stream->length    = 0;
+	stream->overflow  = false;
+	stream->active    = 0;
+
+	return stream;
+
+}  /* checksum_NMEA_stream_init */
+
+/*
+ * size_t checksum_NMEA_stream( struct nmea_stream *stream, const unsigned char *input_str, size_t num_bytes, struct nmea_view *view, size_t max_views, size_t *num_used );
+ *
+ * The function checksum_NMEA_stream() processes the next chunk of a stream
+ * and stores a view of every sentence which is completed in the chunk. A
+ * sentence which lies completely in the chunk is not copied and its view
+ * points in the input buffer. The beginning of a sentence which is not
+ * completed at the end of the chunk is saved in the stream state, and its view
+ * points in the state when it is completed by a later chunk. Views are valid
+ * until the next call with the same stream. If the view array is full the
+ * number of bytes which have been processed is less than num_bytes and the
+ * remainder must be passed again. That number is stored in num_used if the
+ * pointer is not NULL. The function returns the number of views.
+ */
+
+size_t checksum_NMEA_stream( struct nmea_stream *stream, const unsigned char *input_str, size_t num_bytes, struct nmea_view *view, size_t max_views, size_t *num_used ) {
+
+	size_t pos;
+	size_t start;
+	size_t found;
+	int status;
+	int high;
+	int low;
+	unsigned char c;
+
+	found = 0;
+	pos   = 0;
+
+	if ( stream == NULL  ||  input_str == NULL  ||  view == NULL ) num_bytes = 0;
+
+	start = 0;
+
+	while ( pos < num_bytes  &&  found < max_views ) {
+
+		/*
+		 * Search the start of the next sentence. A sentence which was
+		 * continued from an earlier chunk starts at offset 0.
+		 */
+
+		if ( stream->state == NMEA_STATE_IDLE ) {
+
+			start = pos + libcrc_nmea_start( input_str + pos, num_bytes - pos );
+			if ( start >= num_bytes ) { pos = num_bytes; break; }
+
+			stream->state     = NMEA_STATE_PAYLOAD;
+			stream->checksum  = 0;
+			stream->field_len = 0;
+			stream->length    = 0;
+			stream->overflow  = false;
+			pos               = start + 1;
+		}
+
+		if ( stream->state == NMEA_STATE_PAYLOAD ) {
+
+			pos += libcrc_nmea_payload( input_str + pos, num_bytes - pos, & stream->checksum );
+			if ( pos >= num_bytes ) break;
+
+			if ( input_str[pos] == '*' ) {
+
+				stream->state = NMEA_STATE_FIELD;
+				pos++;
+			}
+		}
+
+		if ( stream->state == NMEA_STATE_FIELD ) {
+
+			while ( pos < num_bytes ) {
+
+				c = input_str[pos];
+				if ( c == '\r'  ||  c == '\n'  ||  c == '$'  ||  c == '!' ) break;
+
+				if ( stream->field_len < 2 ) stream->field[stream->field_len] = c;
+				stream->field_len++;
+				pos++;
+			}
+
+			if ( pos >= num_bytes ) break;
+		}
+
+		/*
+		 * The sentence is terminated at position pos. A new start
+		 * character is not consumed because it begins the next sentence.
+		 */
+
+		if ( stream->state == NMEA_STATE_PAYLOAD ) {
+
+			if ( input_str[pos] == '$'  ||  input_str[pos] == '!' ) status = NMEA_STATUS_MALFORMED;
+			else                                                   status = NMEA_STATUS_NO_CHECKSUM;
+		}
+
+		else {
+
+			high = libcrc_nmea_hex( stream->field[0] );
+			low  = libcrc_nmea_hex( stream->field[1] );
+
+			if      ( stream->field_len != 2  ||  high < 0  ||  low < 0 )      status = NMEA_STATUS_MALFORMED;
+			else if ( stream->checksum == (unsigned char) ( high * 16 + low ) ) status = NMEA_STATUS_VALID;
+			else                                                                status = NMEA_STATUS_BAD_CHECKSUM;
+		}
+
+		if ( stream->length == 0 ) {
+
+			view[found].ptr    = input_str + start;
+			view[found].length = pos - start;
+		}
+
+		else {
+
+			stream_save( stream, input_str, pos );
+
+			view[found].ptr    = stream->buffer[stream->active];
+			view[found].length = stream->length;
+			stream->active     = 1 - stream->active;
+
+			if ( stream->overflow ) status = NMEA_STATUS_MALFORMED;
+		}
+
+		view[found].checksum = stream->checksum;
+		view[found].status   = status;
+
+		found++;
+		stream->state  = NMEA_STATE_IDLE;
+		stream->length = 0;
+	}
+
+	/*
+	 * Save the beginning of a sentence which continues in the next chunk.
+	 */
+
+	if ( num_bytes > 0  &&  pos >= num_bytes  &&  stream->state != NMEA_STATE_IDLE ) {
+
+		if ( stream->length == 0 ) stream_save( stream, input_str + start, num_bytes - start );
+		else                       stream_save( stream, input_str, num_bytes );
+	}
+
+	if ( num_used != NULL ) *num_used = pos;
+
+	return found;
+
+}  /* checksum_NMEA_stream */
+
+/*
+ * static void stream_save( struct nmea_stream *stream, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function stream_save() appends bytes to the sentence in the active
+ * buffer of the stream. When the buffer is full the remaining bytes are
+ * discarded and the sentence is marked as too long.
+ */
+
+static void stream_save( struct nmea_stream *stream, const unsigned char *ptr, size_t num_bytes ) {
+
+	if ( num_bytes > NMEA_STREAM_SIZE - stream->length ) {
+
+		num_bytes        = NMEA_STREAM_SIZE - stream->length;
+		stream->overflow = true;
+	}
+
+	memcpy( stream->buffer[stream->active] + stream->length, ptr, num_bytes );
+	stream->length += num_bytes;
+
+}  /* stream_save */
@@ -52,7 +52,23 @@ int main( void ) {
 
 	problems  = 0;
 	problems += test_crc( true );
+	problems += test_crc_32_fix( true );
+	problems += test_crc_block( true );
+	problems += test_crc_combine( true );
+	problems += test_crc_copy( true );
+	problems += test_crc_ctx( true );
+	problems += test_crc_detect( true );
+	problems += test_crc_iov( true );
+	problems += test_crc_model( true );
+	problems += test_crc_multi( true );
+	problems += test_crc_parallel( true );
+	problems += test_crc_patch( true );
+	problems += test_crc_poly8( true );
+	problems += test_crc_roll( true );
+	problems += test_crc_zeros( true );
 	problems += test_checksum_NMEA( true );
+	problems += test_checksum_NMEA_scan( true );
+	problems += test_checksum_NMEA_stream( true );
 
 	printf( "\n" );
 
@@ -33,7 +33,47 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * struct test_alg_tp
+ *
+ * The structure test_alg_tp describes one CRC algorithm in the table test_alg[]
+ * which is shared by the test routines. The table contains all algorithms in
+ * the order of their CRC_TYPE_xxxx constants and ends with a NULL name.
+ */
+
+						/************************************************/
+struct test_alg_tp {				/*						*/
+	const char *	name;			/* The name of the CRC algorithm		*/
+	int		type;			/* The CRC_TYPE_xxxx constant			*/
+	size_t		width;			/* The width of the CRC in bytes		*/
+	uint64_t	(*crc)( const unsigned char *ptr, size_t len );	/* One pass CRC	*/
+};						/*						*/
+						/************************************************/
+
+extern const struct test_alg_tp		test_alg[];
 
 int		main( void );
 int		test_checksum_NMEA( bool verbose );
+int		test_checksum_NMEA_scan( bool verbose );
+int		test_checksum_NMEA_stream( bool verbose );
 int		test_crc( bool verbose );
+int		test_crc_32_fix( bool verbose );
+int		test_crc_block( bool verbose );
+int		test_crc_combine( bool verbose );
+int		test_crc_copy( bool verbose );
+int		test_crc_ctx( bool verbose );
+int		test_crc_detect( bool verbose );
+int		test_crc_iov( bool verbose );
+int		test_crc_model( bool verbose );
+int		test_crc_multi( bool verbose );
+int		test_crc_parallel( bool verbose );
+int		test_crc_patch( bool verbose );
+int		test_crc_roll( bool verbose );
+int		test_crc_zeros( bool verbose );
+int		test_crc_poly8( bool verbose );
+void		test_fill( unsigned char *buf, size_t len, uint32_t *seed );
+const struct test_alg_tp *	test_find_alg( const char *name );
+uint32_t	test_random( uint32_t *seed );
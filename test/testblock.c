@@ -0,0 +1,255 @@
+/*
+ * Library: libcrc
+ * File:    test/testblock.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testblock.c contains routines which test if the
+ * optimized block routines of the libcrc library return the same results as
+ * the straightforward byte by byte calculation. Different lengths and start
+ * alignments are tested to exercise the head and tail handling of the
+ * routines.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		65536
+#define TEST_MAX_OFFSET		16
+
+static unsigned char		test_buf[TEST_BUF_SIZE + TEST_MAX_OFFSET];
+
+						/************************************************/
+struct block16_tp {				/*						*/
+	const char *	name;			/* The name of the CRC algorithm		*/
+	uint16_t	start;			/* The start value of the CRC			*/
+	uint16_t	(*update)( uint16_t crc, unsigned char c );				/* Byte update	*/
+	uint16_t	(*block)( uint16_t crc, const unsigned char *ptr, size_t len );	/* Block update	*/
+};						/*						*/
+						/************************************************/
+
+static struct block16_tp block16[] = {
+	{ "CRC 16",     CRC_START_16,         update_crc_16,     update_crc_16_block     },
+	{ "CRC CCITT",  CRC_START_CCITT_FFFF, update_crc_ccitt,  update_crc_ccitt_block  },
+	{ "CRC DNP",    CRC_START_DNP,        update_crc_dnp,    update_crc_dnp_block    },
+	{ "CRC Kermit", CRC_START_KERMIT,     update_crc_kermit, update_crc_kermit_block },
+	{ NULL,         0,                    NULL,              NULL                    }
+};
+
+static void			fill_test_buf( void );
+static size_t			next_length( size_t len );
+
+/*
+ * int test_crc_block( bool verbose );
+ *
+ * The function test_crc_block() tests the block oriented CRC routines against
+ * a reference calculation which uses the byte oriented update functions.
+ */
+
+int test_crc_block( bool verbose ) {
+
+	int errors;
+	size_t a;
+	size_t len;
+	size_t offset;
+	const unsigned char *ptr;
+	uint32_t crc32;
+	uint32_t ref32;
+	uint32_t crc32c;
+	uint32_t ref32c;
+	uint64_t crc64;
+	uint64_t ref64;
+	uint16_t crc16;
+	uint16_t ref16;
+	unsigned char prev;
+	int b;
+
+	errors = 0;
+
+	printf( "Testing CRC block routines: " );
+
+	fill_test_buf();
+
+	for (offset=0; offset<TEST_MAX_OFFSET; offset++) {
+
+		for (len=0; len<=TEST_BUF_SIZE; len=next_length( len )) {
+
+			ptr   = test_buf + offset;
+
+			ref32 = CRC_START_32;
+			for (a=0; a<len; a++) ref32 = update_crc_32( ref32, ptr[a] );
+			ref32 ^= 0xFFFFFFFFul;
+
+			crc32 = crc_32( ptr, len );
+
+			if ( crc32 != ref32 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC32 offset %u length %u returns 0x%08" PRIX32 ", not 0x%08" PRIX32
+								, (unsigned) offset, (unsigned) len, crc32, ref32 );
+				errors++;
+			}
+
+			ref32c = CRC_START_32C;
+			for (a=0; a<len; a++) ref32c = update_crc_32c( ref32c, ptr[a] );
+			ref32c ^= 0xFFFFFFFFul;
+
+			crc32c = crc_32c( ptr, len );
+
+			if ( crc32c != ref32c ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC32C offset %u length %u returns 0x%08" PRIX32 ", not 0x%08" PRIX32
+								, (unsigned) offset, (unsigned) len, crc32c, ref32c );
+				errors++;
+			}
+
+			crc32c = update_crc_32c_block( CRC_START_32C, ptr,         len / 3       );
+			crc32c = update_crc_32c_block( crc32c,        ptr + len/3, len - len / 3 ) ^ 0xFFFFFFFFul;
+
+			if ( crc32c != ref32c ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC32C block offset %u length %u returns 0x%08" PRIX32 ", not 0x%08" PRIX32
+								, (unsigned) offset, (unsigned) len, crc32c, ref32c );
+				errors++;
+			}
+
+			ref64 = CRC_START_64_WE;
+			for (a=0; a<len; a++) ref64 = update_crc_64( ref64, ptr[a] );
+
+			crc64 = crc_64_we( ptr, len );
+
+			if ( crc64 != ( ref64 ^ 0xFFFFFFFFFFFFFFFFull ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC64 WE offset %u length %u returns 0x%016" PRIX64 ", not 0x%016" PRIX64
+								, (unsigned) offset, (unsigned) len, crc64, (uint64_t) ( ref64 ^ 0xFFFFFFFFFFFFFFFFull ) );
+				errors++;
+			}
+
+			crc64 = update_crc_64_block( CRC_START_64_WE, ptr,         len / 3       );
+			crc64 = update_crc_64_block( crc64,           ptr + len/3, len - len / 3 );
+
+			if ( crc64 != ref64 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC64 block offset %u length %u returns 0x%016" PRIX64 ", not 0x%016" PRIX64
+								, (unsigned) offset, (unsigned) len, crc64, ref64 );
+				errors++;
+			}
+
+			for (b=0; block16[b].name != NULL; b++) {
+
+				ref16 = block16[b].start;
+				for (a=0; a<len; a++) ref16 = block16[b].update( ref16, ptr[a] );
+
+				crc16 = block16[b].block( block16[b].start, ptr, len );
+
+				if ( crc16 != ref16 ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s block offset %u length %u returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+									, block16[b].name, (unsigned) offset, (unsigned) len, crc16, ref16 );
+					errors++;
+				}
+			}
+
+			ref16 = CRC_START_SICK;
+			prev  = 0;
+			for (a=0; a<len; a++) { ref16 = update_crc_sick( ref16, ptr[a], prev ); prev = ptr[a]; }
+
+			prev  = ( len/3 > 0 ) ? ptr[len/3 - 1] : 0;
+			crc16 = update_crc_sick_block( CRC_START_SICK, ptr,         len / 3,       0    );
+			crc16 = update_crc_sick_block( crc16,          ptr + len/3, len - len / 3, prev );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC SICK block offset %u length %u returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, (unsigned) offset, (unsigned) len, crc16, ref16 );
+				errors++;
+			}
+
+			ref16 = (uint16_t) ( ( ref16 >> 8 ) | ( ref16 << 8 ) );
+			crc16 = crc_sick( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC SICK offset %u length %u returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, (unsigned) offset, (unsigned) len, crc16, ref16 );
+				errors++;
+			}
+		}
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_block */
+
+/*
+ * static void fill_test_buf( void );
+ *
+ * The function fill_test_buf() fills the test buffer with a reproducible
+ * pseudo random byte pattern.
+ */
+
+static void fill_test_buf( void ) {
+
+	size_t a;
+	uint32_t seed;
+
+	seed = 0x12345678ul;
+
+	for (a=0; a<sizeof(test_buf); a++) {
+
+		seed        = seed * 1103515245ul + 12345ul;
+		test_buf[a] = (unsigned char) ( seed >> 16 );
+	}
+
+}  /* fill_test_buf */
+
+/*
+ * static size_t next_length( size_t len );
+ *
+ * The function next_length() returns the next buffer length to test. All
+ * short lengths are tested. Longer lengths are tested with increasing steps
+ * to keep the runtime of the test low.
+ */
+
+static size_t next_length( size_t len ) {
+
+	if ( len < 300 ) return len + 1;
+
+	return len + 1 + len / 7;
+
+}  /* next_length */
@@ -0,0 +1,155 @@
+/*
+ * Library: libcrc
+ * File:    test/testcomb.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testcomb.c contains routines which test the functions
+ * in the libcrc library which combine the CRC values of two adjacent blocks
+ * of data.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		1500
+
+typedef uint64_t (*comb_fn)( uint64_t crc1, uint64_t crc2, size_t len2 );
+
+						/************************************************/
+struct comb_tp {				/*						*/
+	const char *	name;			/* The name of the algorithm in test_alg[]	*/
+	comb_fn		combine;		/* Function to combine two CRC values		*/
+};						/*						*/
+						/************************************************/
+
+static uint64_t	test_comb_8( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_8_combine(          (uint8_t)  crc1, (uint8_t)  crc2, len2 ); }
+static uint64_t	test_comb_16( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_16_combine(         (uint16_t) crc1, (uint16_t) crc2, len2 ); }
+static uint64_t	test_comb_modbus( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_modbus_combine(     (uint16_t) crc1, (uint16_t) crc2, len2 ); }
+static uint64_t	test_comb_xmodem( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_xmodem_combine(     (uint16_t) crc1, (uint16_t) crc2, len2 ); }
+static uint64_t	test_comb_ccitt_1d0f( uint64_t crc1, uint64_t crc2, size_t len2 )	{ return crc_ccitt_1d0f_combine( (uint16_t) crc1, (uint16_t) crc2, len2 ); }
+static uint64_t	test_comb_ccitt_ffff( uint64_t crc1, uint64_t crc2, size_t len2 )	{ return crc_ccitt_ffff_combine( (uint16_t) crc1, (uint16_t) crc2, len2 ); }
+static uint64_t	test_comb_kermit( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_kermit_combine(     (uint16_t) crc1, (uint16_t) crc2, len2 ); }
+static uint64_t	test_comb_dnp( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_dnp_combine(        (uint16_t) crc1, (uint16_t) crc2, len2 ); }
+static uint64_t	test_comb_32( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_32_combine(         (uint32_t) crc1, (uint32_t) crc2, len2 ); }
+static uint64_t	test_comb_32c( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_32c_combine(        (uint32_t) crc1, (uint32_t) crc2, len2 ); }
+static uint64_t	test_comb_64_ecma( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_64_ecma_combine(               crc1,            crc2, len2 ); }
+static uint64_t	test_comb_64_we( uint64_t crc1, uint64_t crc2, size_t len2 )		{ return crc_64_we_combine(                 crc1,            crc2, len2 ); }
+
+static struct comb_tp checks[] = {
+	{ "CRC 8",          test_comb_8          },
+	{ "CRC 16",         test_comb_16         },
+	{ "CRC Modbus",     test_comb_modbus     },
+	{ "CRC XModem",     test_comb_xmodem     },
+	{ "CRC CCITT 1D0F", test_comb_ccitt_1d0f },
+	{ "CRC CCITT FFFF", test_comb_ccitt_ffff },
+	{ "CRC Kermit",     test_comb_kermit     },
+	{ "CRC DNP",        test_comb_dnp        },
+	{ "CRC 32",         test_comb_32         },
+	{ "CRC 32C",        test_comb_32c        },
+	{ "CRC 64 ECMA",    test_comb_64_ecma    },
+	{ "CRC 64 WE",      test_comb_64_we      },
+	{ NULL,             NULL                 }
+};
+
+/*
+ * int test_crc_combine( bool verbose );
+ *
+ * The function test_crc_combine() splits a buffer at several positions and
+ * checks that combining the CRC values of the two parts gives the CRC value
+ * of the whole buffer.
+ */
+
+int test_crc_combine( bool verbose ) {
+
+	int a;
+	int errors;
+	size_t len;
+	size_t split;
+	uint64_t crc;
+	uint64_t ref;
+	uint16_t sick;
+	uint16_t sick_ref;
+	uint32_t seed;
+	const struct test_alg_tp *alg;
+	unsigned char buf[TEST_BUF_SIZE];
+
+	errors = 0;
+
+	printf( "Testing CRC combine routines: " );
+
+	seed = 0x2545F491ul;
+	test_fill( buf, TEST_BUF_SIZE, &seed );
+
+	for (len=0; len<=TEST_BUF_SIZE; len+=len/2+1) {
+
+		for (split=0; split<=len; split+=split/3+1) {
+
+			a = 0;
+			while ( checks[a].name != NULL ) {
+
+				alg = test_find_alg( checks[a].name );
+				ref = alg->crc( buf, len );
+				crc = checks[a].combine( alg->crc( buf, split ), alg->crc( buf+split, len-split ), len-split );
+
+				if ( crc != ref ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s length %u split %u returns 0x%" PRIX64 ", not 0x%" PRIX64
+									, alg->name, (unsigned) len, (unsigned) split, crc, ref );
+					errors++;
+				}
+
+				a++;
+			}
+
+			sick_ref = crc_sick( buf, len );
+			sick     = crc_sick_combine( crc_sick( buf, split ), crc_sick( buf+split, len-split ), len-split, ( split > 0 ) ? buf[split-1] : 0 );
+
+			if ( sick != sick_ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC Sick length %u split %u returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, (unsigned) len, (unsigned) split, sick, sick_ref );
+				errors++;
+			}
+		}
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_combine */
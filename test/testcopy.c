@@ -0,0 +1,160 @@
+/*
+ * Library: libcrc
+ * File:    test/testcopy.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testcopy.c contains routines which test the functions
+ * of the libcrc library which copy a buffer and calculate its CRC in one
+ * pass. Both the CRC value and the copied data are checked, for lengths below
+ * and above the size where non-temporal stores are used and for destinations
+ * with different alignments.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		(300*1024)
+
+						/************************************************/
+struct copy_tp {				/*						*/
+	const char *	name;			/* The name of the algorithm in test_alg[]	*/
+	uint64_t	(*copy)( unsigned char *dst, const unsigned char *src, size_t len );	/* Copy and CRC	*/
+};						/*						*/
+						/************************************************/
+
+static uint64_t	test_copy_8( unsigned char *dst, const unsigned char *src, size_t len )		{ return crc_8_copy( dst, src, len ); }
+static uint64_t	test_copy_16( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_16_copy( dst, src, len ); }
+static uint64_t	test_copy_modbus( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_modbus_copy( dst, src, len ); }
+static uint64_t	test_copy_xmodem( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_xmodem_copy( dst, src, len ); }
+static uint64_t	test_copy_ccitt_1d0f( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_ccitt_1d0f_copy( dst, src, len ); }
+static uint64_t	test_copy_ccitt_ffff( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_ccitt_ffff_copy( dst, src, len ); }
+static uint64_t	test_copy_kermit( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_kermit_copy( dst, src, len ); }
+static uint64_t	test_copy_sick( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_sick_copy( dst, src, len ); }
+static uint64_t	test_copy_dnp( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_dnp_copy( dst, src, len ); }
+static uint64_t	test_copy_32( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_32_copy( dst, src, len ); }
+static uint64_t	test_copy_32c( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_32c_copy( dst, src, len ); }
+static uint64_t	test_copy_64_ecma( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_64_ecma_copy( dst, src, len ); }
+static uint64_t	test_copy_64_we( unsigned char *dst, const unsigned char *src, size_t len )	{ return crc_64_we_copy( dst, src, len ); }
+
+static struct copy_tp checks[] = {
+	{ "CRC 8",          test_copy_8          },
+	{ "CRC 16",         test_copy_16         },
+	{ "CRC Modbus",     test_copy_modbus     },
+	{ "CRC XModem",     test_copy_xmodem     },
+	{ "CRC CCITT 1D0F", test_copy_ccitt_1d0f },
+	{ "CRC CCITT FFFF", test_copy_ccitt_ffff },
+	{ "CRC Kermit",     test_copy_kermit     },
+	{ "CRC SICK",       test_copy_sick       },
+	{ "CRC DNP",        test_copy_dnp        },
+	{ "CRC 32",         test_copy_32         },
+	{ "CRC 32C",        test_copy_32c        },
+	{ "CRC 64 ECMA",    test_copy_64_ecma    },
+	{ "CRC 64 WE",      test_copy_64_we      },
+	{ NULL,             NULL                 }
+};
+
+static unsigned char		test_src[TEST_BUF_SIZE];
+static unsigned char		test_dst[TEST_BUF_SIZE+16];
+
+/*
+ * int test_crc_copy( bool verbose );
+ *
+ * The function test_crc_copy() copies parts of a test buffer of different
+ * lengths to destinations with different alignments. The returned CRC is
+ * compared with the one pass CRC function and the copy with the source. The
+ * bytes directly after the copy must not have been changed.
+ */
+
+int test_crc_copy( bool verbose ) {
+
+	int errors;
+	int a;
+	size_t len;
+	size_t offset;
+	uint32_t seed;
+	uint64_t crc;
+	uint64_t ref;
+	const struct test_alg_tp *alg;
+
+	errors = 0;
+
+	printf( "Testing CRC copy routines: " );
+
+	seed = 0x2545F491ul;
+	test_fill( test_src, TEST_BUF_SIZE, &seed );
+
+	for (a=0; checks[a].name != NULL; a++) {
+
+		alg = test_find_alg( checks[a].name );
+
+		for (len=0; len<=TEST_BUF_SIZE; len=( len < 100 ) ? len+7 : len*2+13) {
+
+			offset = ( len + (size_t) a ) % 16;
+
+			memset( test_dst, 0xA5, sizeof(test_dst) );
+
+			ref = alg->crc( test_src, len );
+			crc = checks[a].copy( test_dst + offset, test_src, len );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s length %u returns 0x%" PRIX64 ", not 0x%" PRIX64, alg->name, (unsigned) len, crc, ref );
+				errors++;
+			}
+
+			if ( memcmp( test_dst + offset, test_src, len ) != 0  ||  test_dst[offset+len] != 0xA5 ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s length %u offset %u copy differs", alg->name, (unsigned) len, (unsigned) offset );
+				errors++;
+			}
+		}
+
+		len = TEST_BUF_SIZE - 5;
+		ref = alg->crc( test_src + 5, len );
+		crc = checks[a].copy( test_dst + 9, test_src + 5, len );
+
+		if ( crc != ref  ||  memcmp( test_dst + 9, test_src + 5, len ) != 0 ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s unaligned copy of %u bytes", alg->name, (unsigned) len );
+			errors++;
+		}
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_copy */
@@ -0,0 +1,194 @@
+/*
+ * Library: libcrc
+ * File:    test/testcpp.cpp
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testcpp.cpp contains a test program for the header
+ * only C++ templates in include/checksum.hpp. The check values are verified
+ * at compile time, and the results of the templates are compared with the
+ * functions of the C library at runtime.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "../include/checksum.h"
+#include "../include/checksum.hpp"
+
+#define TEST_BUF_SIZE		2000
+
+static_assert( libcrc::crc_8::calc(          "123456789" ) == 0xA2u,                  "crc_8"          );
+static_assert( libcrc::crc_16::calc(         "123456789" ) == 0xBB3Du,                "crc_16"         );
+static_assert( libcrc::crc_modbus::calc(     "123456789" ) == 0x4B37u,                "crc_modbus"     );
+static_assert( libcrc::crc_xmodem::calc(     "123456789" ) == 0x31C3u,                "crc_xmodem"     );
+static_assert( libcrc::crc_ccitt_1d0f::calc( "123456789" ) == 0xE5CCu,                "crc_ccitt_1d0f" );
+static_assert( libcrc::crc_ccitt_ffff::calc( "123456789" ) == 0x29B1u,                "crc_ccitt_ffff" );
+static_assert( libcrc::crc_kermit::calc(     "123456789" ) == 0x8921u,                "crc_kermit"     );
+static_assert( libcrc::crc_dnp::calc(        "123456789" ) == 0x82EAu,                "crc_dnp"        );
+static_assert( libcrc::crc_sick::calc(       "123456789" ) == 0x56A6u,                "crc_sick"       );
+static_assert( libcrc::crc_32::calc(         "123456789" ) == 0xCBF43926u,            "crc_32"         );
+static_assert( libcrc::crc_32c::calc(        "123456789" ) == 0xE3069283u,            "crc_32c"        );
+static_assert( libcrc::crc_64_ecma::calc(    "123456789" ) == 0x6C40DF5F0B497347ull,  "crc_64_ecma"    );
+static_assert( libcrc::crc_64_we::calc(      "123456789" ) == 0x62EC59E3F1A4F00Aull,  "crc_64_we"      );
+
+static_assert( libcrc::crc<  3, 0x3u,      0x0u,      false, false, 0x7u      >::calc( "123456789" ) == 0x4u,      "CRC-3/GSM"      );
+static_assert( libcrc::crc<  5, 0x05u,     0x1Fu,     true,  true,  0x1Fu     >::calc( "123456789" ) == 0x19u,     "CRC-5/USB"      );
+static_assert( libcrc::crc< 12, 0x80Fu,    0x000u,    false, true,  0x000u    >::calc( "123456789" ) == 0xDAFu,    "CRC-12/UMTS"    );
+static_assert( libcrc::crc< 15, 0x4599u,   0x0000u,   false, false, 0x0000u   >::calc( "123456789" ) == 0x059Eu,   "CRC-15/CAN"     );
+static_assert( libcrc::crc< 24, 0x864CFBu, 0xB704CEu, false, false, 0x000000u >::calc( "123456789" ) == 0x21CF02u, "CRC-24/OPENPGP" );
+static_assert( libcrc::crc< 32, 0x04C11DB7u, 0xFFFFFFFFu, false, false, 0xFFFFFFFFu >::calc( "123456789" ) == 0xFC891918u, "CRC-32/BZIP2" );
+static_assert( libcrc::checksum_nmea( "$GPGLL,5300.97914,N,00259.98174,E,125926,A*28" ) == 0x28u, "checksum_nmea" );
+
+/*
+ * template <class Crc, typename Ret> static int compare( const char *name, Ret (*func)( const unsigned char *, size_t ), const unsigned char *buf );
+ *
+ * The function compare() calculates the CRC of parts of a buffer with a C++
+ * template class and with the corresponding function of the C library, in
+ * one pass and in a streaming calculation. The number of differences is
+ * returned.
+ */
+
+template <class Crc, typename Ret>
+static int compare( const char *name, Ret (*func)( const unsigned char *, size_t ), const unsigned char *buf ) {
+
+	int errors = 0;
+
+	for (size_t offset=0; offset<8; offset++) {
+
+		for (size_t len=0; len+offset<=TEST_BUF_SIZE; len+=len/4+1) {
+
+			const unsigned char *ptr = buf + offset;
+			uint64_t ref = func( ptr, len );
+			uint64_t crc = Crc::calc( ptr, len );
+
+			Crc stream;
+			stream.add( ptr, len / 3 ).add( ptr + len / 3, len - len / 3 );
+
+			if ( crc != ref  ||  stream.value() != ref ) {
+
+				printf( "\n    FAIL: %s offset %u length %u returns 0x%" PRIX64 ", not 0x%" PRIX64, name, (unsigned) offset, (unsigned) len, crc, ref );
+				errors++;
+			}
+		}
+	}
+
+	return errors;
+
+}  /* compare */
+
+/*
+ * template <class Crc, typename Val> static int compare_update( const char *name, Val (*func)( Val, unsigned char ), const unsigned char *buf );
+ *
+ * The function compare_update() checks that the start value and the byte
+ * wise update function of a C++ template class give the same register values
+ * as the update_crc_xxx() function of the C library.
+ */
+
+template <class Crc, typename Val>
+static int compare_update( const char *name, Val (*func)( Val, unsigned char ), const unsigned char *buf ) {
+
+	int errors = 0;
+	Val ref = static_cast<Val>( Crc::init() );
+	typename Crc::value_type crc = Crc::init();
+
+	for (size_t a=0; a<TEST_BUF_SIZE; a++) {
+
+		ref = func( ref, buf[a] );
+		crc = Crc::update( crc, buf[a] );
+
+		if ( crc != ref ) {
+
+			printf( "\n    FAIL: %s update at byte %u", name, (unsigned) a );
+			errors++;
+			break;
+		}
+	}
+
+	return errors;
+
+}  /* compare_update */
+
+/*
+ * int main( void );
+ *
+ * Testcpp is a commandline utility that tests the C++ templates of the libcrc
+ * library. The program returns the number of errors encountered.
+ */
+
+int main( void ) {
+
+	int errors = 0;
+	unsigned char buf[TEST_BUF_SIZE];
+	unsigned char nmea[3];
+	char hex[3];
+	const char *sentence = "$GPRMC,125926,A,5300.97914,N,00259.98174,E,0.0,0.0,010203,0.0,W*77\r\n";
+
+	printf( "\nTesting C++ templates: " );
+
+	for (size_t b=0; b<TEST_BUF_SIZE; b++) buf[b] = static_cast<unsigned char>( ( b * 151 + 17 ) ^ ( b >> 3 ) );
+
+	errors += compare<libcrc::crc_8>(          "crc_8",          crc_8,          buf );
+	errors += compare<libcrc::crc_16>(         "crc_16",         crc_16,         buf );
+	errors += compare<libcrc::crc_modbus>(     "crc_modbus",     crc_modbus,     buf );
+	errors += compare<libcrc::crc_xmodem>(     "crc_xmodem",     crc_xmodem,     buf );
+	errors += compare<libcrc::crc_ccitt_1d0f>( "crc_ccitt_1d0f", crc_ccitt_1d0f, buf );
+	errors += compare<libcrc::crc_ccitt_ffff>( "crc_ccitt_ffff", crc_ccitt_ffff, buf );
+	errors += compare<libcrc::crc_kermit>(     "crc_kermit",     crc_kermit,     buf );
+	errors += compare<libcrc::crc_dnp>(        "crc_dnp",        crc_dnp,        buf );
+	errors += compare<libcrc::crc_sick>(       "crc_sick",       crc_sick,       buf );
+	errors += compare<libcrc::crc_32>(         "crc_32",         crc_32,         buf );
+	errors += compare<libcrc::crc_32c>(        "crc_32c",        crc_32c,        buf );
+	errors += compare<libcrc::crc_64_ecma>(    "crc_64_ecma",    crc_64_ecma,    buf );
+	errors += compare<libcrc::crc_64_we>(      "crc_64_we",      crc_64_we,      buf );
+
+	errors += compare_update<libcrc::crc_8>(      "crc_8",      update_crc_8,      buf );
+	errors += compare_update<libcrc::crc_16>(     "crc_16",     update_crc_16,     buf );
+	errors += compare_update<libcrc::crc_xmodem>( "crc_xmodem", update_crc_ccitt,  buf );
+	errors += compare_update<libcrc::crc_kermit>( "crc_kermit", update_crc_kermit, buf );
+	errors += compare_update<libcrc::crc_dnp>(    "crc_dnp",    update_crc_dnp,    buf );
+	errors += compare_update<libcrc::crc_32>(     "crc_32",     update_crc_32,     buf );
+	errors += compare_update<libcrc::crc_32c>(    "crc_32c",    update_crc_32c,    buf );
+	errors += compare_update<libcrc::crc_64_we>(  "crc_64_we",  update_crc_64,     buf );
+
+	checksum_NMEA( reinterpret_cast<const unsigned char *>( sentence ), nmea );
+	snprintf( hex, sizeof(hex), "%02X", libcrc::checksum_nmea( sentence ) );
+
+	if ( strcmp( hex, reinterpret_cast<const char *>( nmea ) ) != 0 ) {
+
+		printf( "\n    FAIL: checksum_nmea returns %s, not %s", hex, reinterpret_cast<const char *>( nmea ) );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n\n**** All tests succeeded\n\n" );
+	else               printf( "\n    FAILED %d checks\n\n", errors );
+
+	return errors;
+
+}  /* main (libcrc C++ test) */
@@ -47,6 +47,7 @@ struct chk_tp {					/*						*/
 	uint8_t		crc8;			/* The  8 bit wide CRC8 of the input string	*/
 	uint16_t	crc16;			/* The 16 bit wide CRC16 of the input string	*/
 	uint32_t	crc32;			/* The 32 bit wide CRC32 of the input string	*/
+	uint32_t	crc32c;			/* The 32 bit wide CRC32C of the input string	*/
 	uint64_t	crc64_ecma;		/* The 64 bit wide CRC64-ECMA of the input	*/
 	uint64_t	crc64_we;		/* The 64 bit wide CRC64-WE of the input string	*/
 	uint16_t	crcdnp;			/* The 16 bit wide DNP CRC of the string	*/
@@ -60,11 +61,11 @@ struct chk_tp {					/*						*/
 						/************************************************/
 
 static struct chk_tp checks[] = {
-	{ "123456789",    0xA2, 0xBB3D, 0xCBF43926ul, 0x6C40DF5F0B497347ull, 0x62EC59E3F1A4F00Aull, 0x82EA, 0x4B37, 0x56A6, 0x31C3, 0xE5CC, 0x29B1, 0x8921 },
-	{ "Lammert Bies", 0xA5, 0xB638, 0x43C04CA6ul, 0xF806F4F5C0F3257Cull, 0xFE25A9F50630F789ull, 0x4583, 0xB45C, 0x1108, 0xCEC8, 0x67A2, 0x4A31, 0xF80D },
-	{ "",             0x00, 0x0000, 0x00000000ul, 0x0000000000000000ull, 0x0000000000000000ull, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x1D0F, 0xFFFF, 0x0000 },
-	{ " ",            0x86, 0xD801, 0xE96CCF45ul, 0xCC7AF1FF21C30BDEull, 0x568617D9EF46BE26ull, 0x50D6, 0x98BE, 0x2000, 0x2462, 0xE8FE, 0xC592, 0x0221 },
-	{ NULL,           0,    0,      0,            0,                     0,                     0,      0,      0,      0,      0,      0,      0      }
+	{ "123456789",    0xA2, 0xBB3D, 0xCBF43926ul, 0xE3069283ul, 0x6C40DF5F0B497347ull, 0x62EC59E3F1A4F00Aull, 0x82EA, 0x4B37, 0x56A6, 0x31C3, 0xE5CC, 0x29B1, 0x8921 },
+	{ "Lammert Bies", 0xA5, 0xB638, 0x43C04CA6ul, 0xF91F7762ul, 0xF806F4F5C0F3257Cull, 0xFE25A9F50630F789ull, 0x4583, 0xB45C, 0x1108, 0xCEC8, 0x67A2, 0x4A31, 0xF80D },
+	{ "",             0x00, 0x0000, 0x00000000ul, 0x00000000ul, 0x0000000000000000ull, 0x0000000000000000ull, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x1D0F, 0xFFFF, 0x0000 },
+	{ " ",            0x86, 0xD801, 0xE96CCF45ul, 0x72C0DD8Ful, 0xCC7AF1FF21C30BDEull, 0x568617D9EF46BE26ull, 0x50D6, 0x98BE, 0x2000, 0x2462, 0xE8FE, 0xC592, 0x0221 },
+	{ NULL,           0,    0,      0,            0,            0,                     0,                     0,      0,      0,      0,      0,      0,      0      }
 };
 
 /*
@@ -90,6 +91,7 @@ int test_crc( bool verbose ) {
 	uint16_t crcffff;
 	uint16_t crckermit;
 	uint32_t crc32;
+	uint32_t crc32c;
 	uint64_t crc64_ecma;
 	uint64_t crc64_we;
 
@@ -106,6 +108,7 @@ int test_crc( bool verbose ) {
 		crc8       = crc_8(          ptr, len );
 		crc16      = crc_16(         ptr, len );
 		crc32      = crc_32(         ptr, len );
+		crc32c     = crc_32c(        ptr, len );
 		crc64_ecma = crc_64_ecma(    ptr, len );
 		crc64_we   = crc_64_we(      ptr, len );
 		crcdnp     = crc_dnp(        ptr, len );
@@ -137,6 +140,13 @@ int test_crc( bool verbose ) {
 			errors++;
 		}
 
+		if ( crc32c != checks[a].crc32c ) {
+
+			if ( verbose ) printf( "\n    FAIL: CRC32C \"%s\" returns 0x%08" PRIX32 ", not 0x%08" PRIX32
+							, checks[a].input, crc32c, checks[a].crc32c );
+			errors++;
+		}
+
 		if ( crc64_ecma != checks[a].crc64_ecma ) {
 
 			if ( verbose ) printf( "\n    FAIL: CRC64 ECMA \"%s\" returns 0x%016" PRIX64 ", not 0x%016" PRIX64
@@ -0,0 +1,117 @@
+/*
+ * Library: libcrc
+ * File:    test/testctx.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testctx.c contains routines which test the streaming
+ * CRC functions of the libcrc library. The data is fed to the streaming
+ * functions in blocks of varying sizes and the result is compared with the
+ * one pass CRC functions.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		3000
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+/*
+ * int test_crc_ctx( bool verbose );
+ *
+ * The function test_crc_ctx() feeds a test buffer in blocks of different
+ * sizes to the streaming CRC functions and compares the result with the one
+ * pass CRC functions.
+ */
+
+int test_crc_ctx( bool verbose ) {
+
+	int errors;
+	int a;
+	size_t pos;
+	size_t len;
+	size_t step;
+	uint32_t seed;
+	uint64_t crc;
+	uint64_t ref;
+	struct crc_ctx ctx;
+
+	errors = 0;
+
+	printf( "Testing CRC streaming routines: " );
+
+	seed = 0x2545F491ul;
+	test_fill( test_buf, TEST_BUF_SIZE, &seed );
+
+	for (a=0; test_alg[a].name != NULL; a++) {
+
+		for (len=0; len<=TEST_BUF_SIZE; len+=1+len/3) {
+
+			ref = test_alg[a].crc( test_buf, len );
+
+			for (step=1; step<=len+1; step=step*3+1) {
+
+				if ( crc_ctx_init( & ctx, test_alg[a].type ) == NULL ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s init failed", test_alg[a].name );
+					errors++;
+					break;
+				}
+
+				for (pos=0; pos<len; pos+=step) crc_ctx_update( & ctx, test_buf + pos, ( len-pos < step ) ? len-pos : step );
+
+				crc = crc_ctx_final( & ctx );
+
+				if ( crc != ref ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s length %u step %u returns 0x%" PRIX64 ", not 0x%" PRIX64
+								, test_alg[a].name, (unsigned) len, (unsigned) step, crc, ref );
+					errors++;
+				}
+			}
+		}
+	}
+
+	if ( crc_ctx_init( & ctx, 0 ) != NULL ) {
+
+		if ( verbose ) printf( "\n    FAIL: init with unknown type succeeded" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_ctx */
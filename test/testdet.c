@@ -0,0 +1,139 @@
+/*
+ * Library: libcrc
+ * File:    test/testdet.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testdet.c contains routines which test the single pass
+ * calculation of several CRC algorithms and the detection of the algorithm
+ * of a CRC at the end of a message. The results are compared with the one
+ * pass CRC functions.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		10000
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+/*
+ * int test_crc_detect( bool verbose );
+ *
+ * The function test_crc_detect() compares the results of crc_all() for
+ * different lengths and sets of algorithms with the one pass CRC functions.
+ * It then stores the CRC of each algorithm at the end of a message, in both
+ * byte orders, and checks that crc_detect() finds the algorithm and no longer
+ * finds it after one byte of the message has been changed.
+ */
+
+int test_crc_detect( bool verbose ) {
+
+	int errors;
+	int a;
+	size_t b;
+	size_t len;
+	uint32_t seed;
+	uint64_t ref;
+	uint64_t value;
+	unsigned int mask;
+	unsigned int found;
+	uint64_t crc[CRC_NUM_TYPES];
+
+	errors = 0;
+
+	printf( "Testing CRC detection routines: " );
+
+	seed = 0x2545F491ul;
+	test_fill( test_buf, TEST_BUF_SIZE, &seed );
+
+	for (len=0; len<=TEST_BUF_SIZE-8; len+=1+len/2) {
+
+		for (mask=0; mask<=CRC_MASK_ALL; mask+=0x0123) {
+
+			crc_all( test_buf, len, mask | CRC_MASK(len % CRC_NUM_TYPES), crc );
+
+			for (a=0; test_alg[a].name != NULL; a++) {
+
+				ref = ( ( mask | CRC_MASK(len % CRC_NUM_TYPES) ) & CRC_MASK(test_alg[a].type) ) ? test_alg[a].crc( test_buf, len ) : 0;
+
+				if ( crc[test_alg[a].type] != ref ) {
+
+					if ( verbose ) printf( "\n    FAIL: crc_all() %s length %u mask 0x%04X returns 0x%" PRIX64 ", not 0x%" PRIX64
+								, test_alg[a].name, (unsigned) len, mask, crc[test_alg[a].type], ref );
+					errors++;
+				}
+			}
+		}
+	}
+
+	for (a=0; test_alg[a].name != NULL; a++) {
+
+		for (len=1; len<=TEST_BUF_SIZE-8; len=len*3+1) {
+
+			value = test_alg[a].crc( test_buf, len );
+
+			for (b=0; b<test_alg[a].width; b++) test_buf[len+b] = (unsigned char) ( value >> ( 8 * ( ( len & 1 ) ? b : test_alg[a].width-1-b ) ) );
+
+			found = crc_detect( test_buf, len + test_alg[a].width, CRC_MASK_ALL );
+
+			if ( ! ( found & CRC_MASK(test_alg[a].type) ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: crc_detect() %s length %u not found", test_alg[a].name, (unsigned) len );
+				errors++;
+			}
+
+			test_buf[len/2] ^= 0x01;
+			found = crc_detect( test_buf, len + test_alg[a].width, CRC_MASK_ALL );
+			test_buf[len/2] ^= 0x01;
+
+			if ( found & CRC_MASK(test_alg[a].type) ) {
+
+				if ( verbose ) printf( "\n    FAIL: crc_detect() %s length %u found in changed message", test_alg[a].name, (unsigned) len );
+				errors++;
+			}
+		}
+	}
+
+	if ( crc_detect( test_buf, 2, CRC_MASK(CRC_TYPE_32) ) != 0 ) {
+
+		if ( verbose ) printf( "\n    FAIL: crc_detect() matches a buffer shorter than the CRC" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_detect */
@@ -0,0 +1,193 @@
+/*
+ * Library: libcrc
+ * File:    test/testfix.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testfix.c contains routines which test the correction
+ * of single bit errors and error bursts in CRC-32 protected frames.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_FRAME_SIZE		1068
+#define TEST_MAX_BURST		8
+
+static unsigned char		test_frame[TEST_FRAME_SIZE];
+static unsigned char		test_copy[TEST_FRAME_SIZE];
+
+static int			test_burst( const struct crc_fix *fix, size_t num_bytes, uint32_t crc, size_t pos, int len, uint32_t pattern, bool verbose );
+
+/*
+ * int test_crc_32_fix( bool verbose );
+ *
+ * The function test_crc_32_fix() flips single bits and bursts of bits at many
+ * positions of a frame and checks that crc_32_fix() restores the original
+ * frame. Errors in the received CRC, frames shorter than the maximum, bursts
+ * longer than the maximum and invalid parameters are also tested.
+ */
+
+int test_crc_32_fix( bool verbose ) {
+
+	int errors;
+	int len;
+	size_t pos;
+	size_t num_bytes;
+	uint32_t seed;
+	uint32_t crc;
+	uint32_t pattern;
+	struct crc_fix *fix;
+
+	errors = 0;
+
+	printf( "Testing CRC-32 error correction: " );
+
+	fix = crc_32_fix_create( TEST_FRAME_SIZE, TEST_MAX_BURST );
+
+	if ( fix == NULL ) {
+
+		if ( verbose ) printf( "\n    FAIL: correction tables cannot be created\n    " );
+		printf( "FAILED\n" );
+		return 1;
+	}
+
+	seed = 0x5DEECE66ul;
+	test_fill( test_frame, TEST_FRAME_SIZE, &seed );
+
+	for (num_bytes=TEST_FRAME_SIZE; num_bytes>=1; num_bytes/=9) {
+
+		crc = crc_32( test_frame, num_bytes );
+
+		memcpy( test_copy, test_frame, num_bytes );
+
+		if ( crc_32_fix( fix, test_copy, num_bytes, crc ) != CRC_FIX_NONE  ||  memcmp( test_copy, test_frame, num_bytes ) != 0 ) {
+
+			if ( verbose ) printf( "\n    FAIL: correct frame of %u bytes not accepted", (unsigned) num_bytes );
+			errors++;
+		}
+
+		/*
+		 * Bursts of all lengths up to the maximum are placed at bit
+		 * positions spread over the frame, including the first and
+		 * the last bit and positions which cross a byte boundary.
+		 */
+
+		for (len=1; len<=TEST_MAX_BURST; len++) {
+
+			pattern = 1ul | ( 1ul << ( len - 1 ) );
+
+			for (pos=0; pos + (size_t) len <= num_bytes * 8; pos+=211) {
+
+				test_random( &seed );
+				pattern = 1ul | ( 1ul << ( len - 1 ) ) | ( ( seed >> 8 ) & ( ( 1ul << ( len - 1 ) ) - 1 ) );
+				errors += test_burst( fix, num_bytes, crc, pos, len, pattern, verbose );
+			}
+
+			errors += test_burst( fix, num_bytes, crc, num_bytes * 8 - (size_t) len, len, pattern, verbose );
+		}
+	}
+
+	crc = crc_32( test_frame, TEST_FRAME_SIZE );
+
+	memcpy( test_copy, test_frame, TEST_FRAME_SIZE );
+
+	if ( crc_32_fix( fix, test_copy, TEST_FRAME_SIZE, crc ^ 0x00F00000ul ) != CRC_FIX_CRC  ||  memcmp( test_copy, test_frame, TEST_FRAME_SIZE ) != 0 ) {
+
+		if ( verbose ) printf( "\n    FAIL: error in the received CRC not detected" );
+		errors++;
+	}
+
+	test_copy[100] ^= 0xFF;
+	test_copy[300] ^= 0x01;
+
+	if ( crc_32_fix( fix, test_copy, TEST_FRAME_SIZE, crc ) != CRC_FIX_FAILED ) {
+
+		if ( verbose ) printf( "\n    FAIL: two separate errors corrected" );
+		errors++;
+	}
+
+	if ( crc_32_fix( fix, test_copy, TEST_FRAME_SIZE + 1, crc ) != CRC_FIX_FAILED ) {
+
+		if ( verbose ) printf( "\n    FAIL: frame longer than the tables accepted" );
+		errors++;
+	}
+
+	crc_32_fix_free( fix );
+
+	if ( crc_32_fix_create( 0, 4 ) != NULL  ||  crc_32_fix_create( 100, 0 ) != NULL  ||  crc_32_fix_create( 100, CRC_32_FIX_MAX_BURST + 1 ) != NULL ) {
+
+		if ( verbose ) printf( "\n    FAIL: invalid parameters accepted" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_32_fix */
+
+/*
+ * static int test_burst( const struct crc_fix *fix, size_t num_bytes, uint32_t crc, size_t pos, int len, uint32_t pattern, bool verbose );
+ *
+ * The function test_burst() flips the bits of a burst pattern of len bits,
+ * starting at bit pos of a copy of the test frame, and checks that the frame
+ * is corrected. The bits of a byte are counted from the least significant
+ * bit, in the order in which the CRC-32 processes them. The function returns
+ * the number of failed checks.
+ */
+
+static int test_burst( const struct crc_fix *fix, size_t num_bytes, uint32_t crc, size_t pos, int len, uint32_t pattern, bool verbose ) {
+
+	int a;
+	int result;
+	size_t bit;
+
+	memcpy( test_copy, test_frame, num_bytes );
+
+	for (a=0; a<len; a++) {
+
+		bit = pos + (size_t) a;
+		if ( pattern & ( 1ul << a ) ) test_copy[bit>>3] ^= (unsigned char) ( 1u << ( bit & 7 ) );
+	}
+
+	result = crc_32_fix( fix, test_copy, num_bytes, crc );
+
+	if ( result == CRC_FIX_DATA  &&  memcmp( test_copy, test_frame, num_bytes ) == 0 ) return 0;
+
+	if ( verbose ) printf( "\n    FAIL: burst of %d bits at bit %u of %u bytes returns %d", len, (unsigned) pos, (unsigned) num_bytes, result );
+
+	return 1;
+
+}  /* test_burst */
@@ -0,0 +1,164 @@
+/*
+ * Library: libcrc
+ * File:    test/testiov.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testiov.c contains routines which test the scatter
+ * gather CRC functions of the libcrc library. A test buffer is split in a
+ * varying number of parts of random length and the result is compared with
+ * the one pass CRC functions.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		3000
+#define TEST_NUM_PARTS		12
+
+						/************************************************/
+struct iov_tp {					/*						*/
+	const char *	name;			/* The name of the algorithm in test_alg[]	*/
+	uint64_t	(*iov)( const struct iovec *iov, int iovcnt );	/* Scatter gather CRC	*/
+};						/*						*/
+						/************************************************/
+
+static uint64_t	test_iov_8( const struct iovec *iov, int iovcnt )		{ return crc_8_iov( iov, iovcnt ); }
+static uint64_t	test_iov_16( const struct iovec *iov, int iovcnt )		{ return crc_16_iov( iov, iovcnt ); }
+static uint64_t	test_iov_modbus( const struct iovec *iov, int iovcnt )		{ return crc_modbus_iov( iov, iovcnt ); }
+static uint64_t	test_iov_xmodem( const struct iovec *iov, int iovcnt )		{ return crc_xmodem_iov( iov, iovcnt ); }
+static uint64_t	test_iov_ccitt_1d0f( const struct iovec *iov, int iovcnt )	{ return crc_ccitt_1d0f_iov( iov, iovcnt ); }
+static uint64_t	test_iov_ccitt_ffff( const struct iovec *iov, int iovcnt )	{ return crc_ccitt_ffff_iov( iov, iovcnt ); }
+static uint64_t	test_iov_kermit( const struct iovec *iov, int iovcnt )		{ return crc_kermit_iov( iov, iovcnt ); }
+static uint64_t	test_iov_sick( const struct iovec *iov, int iovcnt )		{ return crc_sick_iov( iov, iovcnt ); }
+static uint64_t	test_iov_dnp( const struct iovec *iov, int iovcnt )		{ return crc_dnp_iov( iov, iovcnt ); }
+static uint64_t	test_iov_32( const struct iovec *iov, int iovcnt )		{ return crc_32_iov( iov, iovcnt ); }
+static uint64_t	test_iov_32c( const struct iovec *iov, int iovcnt )		{ return crc_32c_iov( iov, iovcnt ); }
+static uint64_t	test_iov_64_ecma( const struct iovec *iov, int iovcnt )		{ return crc_64_ecma_iov( iov, iovcnt ); }
+static uint64_t	test_iov_64_we( const struct iovec *iov, int iovcnt )		{ return crc_64_we_iov( iov, iovcnt ); }
+
+static struct iov_tp checks[] = {
+	{ "CRC 8",          test_iov_8          },
+	{ "CRC 16",         test_iov_16         },
+	{ "CRC Modbus",     test_iov_modbus     },
+	{ "CRC XModem",     test_iov_xmodem     },
+	{ "CRC CCITT 1D0F", test_iov_ccitt_1d0f },
+	{ "CRC CCITT FFFF", test_iov_ccitt_ffff },
+	{ "CRC Kermit",     test_iov_kermit     },
+	{ "CRC SICK",       test_iov_sick       },
+	{ "CRC DNP",        test_iov_dnp        },
+	{ "CRC 32",         test_iov_32         },
+	{ "CRC 32C",        test_iov_32c        },
+	{ "CRC 64 ECMA",    test_iov_64_ecma    },
+	{ "CRC 64 WE",      test_iov_64_we      },
+	{ NULL,             NULL                }
+};
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+/*
+ * int test_crc_iov( bool verbose );
+ *
+ * The function test_crc_iov() splits a test buffer in parts of random length,
+ * including empty parts, and compares the CRC of the parts calculated with
+ * the scatter gather functions with the one pass CRC functions.
+ */
+
+int test_crc_iov( bool verbose ) {
+
+	int errors;
+	int a;
+	int num;
+	int round;
+	size_t b;
+	size_t len;
+	size_t pos;
+	uint32_t seed;
+	uint64_t crc;
+	uint64_t ref;
+	struct iovec iov[TEST_NUM_PARTS];
+	const struct test_alg_tp *alg;
+
+	errors = 0;
+
+	printf( "Testing CRC scatter gather routines: " );
+
+	seed = 0x2545F491ul;
+	test_fill( test_buf, TEST_BUF_SIZE, &seed );
+
+	for (a=0; checks[a].name != NULL; a++) {
+
+		alg = test_find_alg( checks[a].name );
+
+		for (round=0; round<200; round++) {
+
+			test_random( &seed );
+			len  = ( round < 100 ) ? ( seed >> 16 ) % 200 : ( seed >> 16 ) % TEST_BUF_SIZE;
+			num  = 1 + round % TEST_NUM_PARTS;
+			pos  = 0;
+
+			for (b=0; b<(size_t)num; b++) {
+
+				test_random( &seed );
+				iov[b].iov_base     = test_buf + pos;
+				iov[b].iov_len      = ( b == (size_t)num-1 ) ? len - pos : ( seed >> 16 ) % ( len - pos + 1 );
+				pos                += iov[b].iov_len;
+			}
+
+			ref = alg->crc( test_buf, len );
+			crc = checks[a].iov( iov, num );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s length %u in %d parts returns 0x%" PRIX64 ", not 0x%" PRIX64
+							, alg->name, (unsigned) len, num, crc, ref );
+				errors++;
+			}
+		}
+
+		ref = alg->crc( test_buf, 0 );
+		crc = checks[a].iov( NULL, 0 );
+
+		if ( crc != ref ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s without buffers returns 0x%" PRIX64 ", not 0x%" PRIX64, alg->name, crc, ref );
+			errors++;
+		}
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_iov */
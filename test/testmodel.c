@@ -0,0 +1,247 @@
+/*
+ * Library: libcrc
+ * File:    test/testmodel.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testmodel.c contains routines which test the generic
+ * CRC engine for algorithms described with the parameters of the Rocksoft
+ * model.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		1500
+
+						/************************************************/
+struct model_tp {				/*						*/
+	const char *	name;			/* The name of the model in the catalogue	*/
+	const char *	alg;			/* The name of the routine in test_alg[]	*/
+};						/*						*/
+						/************************************************/
+
+static struct model_tp checks[] = {
+	{ "CRC-16/ARC",         "CRC 16"         },
+	{ "CRC-16/MODBUS",      "CRC Modbus"     },
+	{ "CRC-16/XMODEM",      "CRC XModem"     },
+	{ "CRC-16/SPI-FUJITSU", "CRC CCITT 1D0F" },
+	{ "CRC-16/IBM-3740",    "CRC CCITT FFFF" },
+	{ "CRC-32",             "CRC 32"         },
+	{ "CRC-32C",            "CRC 32C"        },
+	{ "CRC-64/ECMA-182",    "CRC 64 ECMA"    },
+	{ "CRC-64/WE",          "CRC 64 WE"      },
+	{ NULL,                 NULL             }
+};
+
+						/************************************************/
+static struct crc_model custom[] = {		/* Parameter sets not in the catalogue		*/
+	{ "Custom 1",   1, 0x1ull,                0x1ull,                false, false, 0x0ull,                0 },
+	{ "Custom 7",   7, 0x45ull,               0x12ull,               true,  false, 0x7Full,               0 },
+	{ "Custom 8",   8, 0x31ull,               0xFFull,               true,  true,  0x00ull,               0 },
+	{ "Custom 19", 19, 0x5A3C1ull,            0x2468Aull,            false, true,  0x13579ull,            0 },
+	{ "Custom 33", 33, 0x1A5A5A5A5ull,        0x0F0F0F0F0ull,        true,  true,  0x1FFFFFFFFull,        0 },
+	{ "Custom 57", 57, 0x123456789ABCDEFull,  0x0ull,                false, false, 0x0ull,                0 },
+	{ "Custom 64", 64, 0x9A6C9329AC4BC9B5ull, 0xFFFFFFFFFFFFFFFFull, true,  true,  0xFFFFFFFFFFFFFFFFull, 0 },
+	{ NULL,         0, 0x0ull,                0x0ull,                false, false, 0x0ull,                0 }
+};						/*						*/
+						/************************************************/
+
+static uint64_t	bitwise_model( const struct crc_model *model, const unsigned char *ptr, size_t len );
+
+/*
+ * int test_crc_model( bool verbose );
+ *
+ * The function test_crc_model() verifies the check values of all models in
+ * the catalogue, compares the generic engine with the dedicated routines of
+ * the library and with a bit by bit reference implementation, and checks that
+ * calculation in several blocks gives the same result as in one pass.
+ */
+
+int test_crc_model( bool verbose ) {
+
+	int a;
+	int errors;
+	size_t b;
+	size_t len;
+	size_t num_models;
+	uint32_t seed;
+	uint64_t crc;
+	uint64_t ref;
+	const struct crc_model *model;
+	const struct crc_model *catalogue;
+	unsigned char buf[TEST_BUF_SIZE];
+
+	errors = 0;
+
+	printf( "Testing CRC model routines: " );
+
+	seed = 0x2545F491ul;
+	test_fill( buf, TEST_BUF_SIZE, &seed );
+
+	catalogue = crc_model_catalogue( & num_models );
+
+	for (b=0; b<num_models; b++) {
+
+		model = & catalogue[b];
+
+		crc = crc_model_calc( model, (const unsigned char *) "123456789", 9 );
+
+		if ( crc != model->check ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s check returns 0x%" PRIX64 ", not 0x%" PRIX64, model->name, crc, model->check );
+			errors++;
+		}
+
+		if ( crc_model_find( model->name ) != model ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s not found in catalogue", model->name );
+			errors++;
+		}
+
+		for (len=0; len<=TEST_BUF_SIZE; len+=len/2+1) {
+
+			ref = bitwise_model( model, buf, len );
+			crc = crc_model_init( model );
+			crc = crc_model_update( model, crc, buf,         len / 3       );
+			crc = crc_model_update( model, crc, buf + len/3, len - len / 3 );
+			crc = crc_model_final( model, crc );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s length %u returns 0x%" PRIX64 ", not 0x%" PRIX64, model->name, (unsigned) len, crc, ref );
+				errors++;
+			}
+		}
+	}
+
+	for (a=0; custom[a].name != NULL; a++) {
+
+		for (len=0; len<=TEST_BUF_SIZE; len+=len/2+1) {
+
+			ref = bitwise_model(  & custom[a], buf, len );
+			crc = crc_model_calc( & custom[a], buf, len );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s length %u returns 0x%" PRIX64 ", not 0x%" PRIX64, custom[a].name, (unsigned) len, crc, ref );
+				errors++;
+			}
+		}
+	}
+
+	for (a=0; checks[a].name != NULL; a++) {
+
+		model = crc_model_find( checks[a].name );
+
+		if ( model == NULL ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s not found in catalogue", checks[a].name );
+			errors++;
+			continue;
+		}
+
+		for (len=0; len<=TEST_BUF_SIZE; len+=len/2+1) {
+
+			ref = test_find_alg( checks[a].alg )->crc( buf, len );
+			crc = crc_model_calc( model, buf, len );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s length %u returns 0x%" PRIX64 ", not 0x%" PRIX64, checks[a].name, (unsigned) len, crc, ref );
+				errors++;
+			}
+		}
+	}
+
+	if ( crc_model_find( "crc-16/ccitt-false" ) != crc_model_find( "CRC-16/IBM-3740" )  ||  crc_model_find( "CRC-99/UNKNOWN" ) != NULL ) {
+
+		if ( verbose ) printf( "\n    FAIL: crc_model_find() returns wrong model" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_model */
+
+/*
+ * static uint64_t bitwise_model( const struct crc_model *model, const unsigned char *ptr, size_t len );
+ *
+ * The function bitwise_model() is a straightforward bit by bit implementation
+ * of the Rocksoft model which is used as reference for the generic engine.
+ */
+
+static uint64_t bitwise_model( const struct crc_model *model, const unsigned char *ptr, size_t len ) {
+
+	int a;
+	int bit;
+	uint64_t top;
+	uint64_t mask;
+	uint64_t crc;
+	uint64_t result;
+	unsigned char c;
+
+	top  = 1ull << ( model->width - 1 );
+	mask = ( top << 1 ) - 1;
+	crc  = model->init & mask;
+
+	while ( len-- > 0 ) {
+
+		c = *ptr++;
+
+		for (a=0; a<8; a++) {
+
+			if ( model->refin ) bit = ( c >> a       ) & 1;
+			else                bit = ( c >> (7 - a) ) & 1;
+
+			if ( ( ( crc & top ) != 0 ) != ( bit != 0 ) ) crc = ( ( crc << 1 ) ^ model->poly ) & mask;
+			else                                          crc = ( ( crc << 1 )               ) & mask;
+		}
+	}
+
+	if ( model->refout ) {
+
+		result = 0;
+		for (a=0; a<model->width; a++) result |= ( ( crc >> a ) & 1 ) << ( model->width - 1 - a );
+		crc = result;
+	}
+
+	return ( crc ^ model->xorout ) & mask;
+
+}  /* bitwise_model */
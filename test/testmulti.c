@@ -0,0 +1,137 @@
+/*
+ * Library: libcrc
+ * File:    test/testmulti.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testmulti.c contains routines which test the multi
+ * buffer CRC function of the libcrc library. Sets of buffers with varying
+ * lengths are passed to crc_multi() and each result is compared with the one
+ * pass CRC function of the algorithm.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		3000
+#define TEST_NUM_BUFFERS	23
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+/*
+ * int test_crc_multi( bool verbose );
+ *
+ * The function test_crc_multi() calculates the CRC values of sets of buffers
+ * with different lengths and positions in one call to crc_multi() and
+ * compares each value with the one pass CRC function. The sets contain empty
+ * and NULL buffers, buffers around the lengths where the SIMD routines take
+ * over, and a number of buffers which is not a multiple of the number of
+ * interleaved registers.
+ */
+
+int test_crc_multi( bool verbose ) {
+
+	int errors;
+	int a;
+	size_t b;
+	size_t num;
+	size_t round;
+	uint32_t seed;
+	uint64_t ref;
+	uint64_t crc[TEST_NUM_BUFFERS];
+	size_t len[TEST_NUM_BUFFERS];
+	const unsigned char *ptr[TEST_NUM_BUFFERS];
+
+	errors = 0;
+
+	printf( "Testing CRC multi buffer routine: " );
+
+	seed = 0x2545F491ul;
+	test_fill( test_buf, TEST_BUF_SIZE, &seed );
+
+	for (a=0; test_alg[a].name != NULL; a++) {
+
+		for (round=0; round<40; round++) {
+
+			num = ( round % TEST_NUM_BUFFERS ) + 1;
+
+			for (b=0; b<num; b++) {
+
+				test_random( &seed );
+
+				switch ( round % 4 ) {
+
+					case 0  : len[b] = ( seed >> 16 ) % 24;                  break;
+					case 1  : len[b] = ( seed >> 16 ) % 100;                 break;
+					case 2  : len[b] = 56 + ( seed >> 16 ) % 16;             break;
+					default : len[b] = ( seed >> 16 ) % ( TEST_BUF_SIZE/2 ); break;
+				}
+
+				ptr[b] = test_buf + ( seed >> 8 ) % ( TEST_BUF_SIZE - len[b] );
+				if ( len[b] == 0  &&  ( seed & 0x100 ) ) ptr[b] = NULL;
+			}
+
+			crc_multi( test_alg[a].type, ptr, len, crc, num );
+
+			for (b=0; b<num; b++) {
+
+				ref = test_alg[a].crc( ptr[b], len[b] );
+
+				if ( crc[b] != ref ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s buffer %u of %u length %u returns 0x%" PRIX64 ", not 0x%" PRIX64
+								, test_alg[a].name, (unsigned) b, (unsigned) num, (unsigned) len[b], crc[b], ref );
+					errors++;
+				}
+			}
+		}
+	}
+
+	ptr[0] = test_buf;
+	len[0] = 10;
+	crc[0] = 1;
+
+	crc_multi( 0, ptr, len, crc, 1 );
+
+	if ( crc[0] != 0 ) {
+
+		if ( verbose ) printf( "\n    FAIL: unknown type returns 0x%" PRIX64 ", not 0", crc[0] );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_multi */
@@ -32,7 +32,9 @@
  * platform.
  */
 
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "testall.h"
 
@@ -234,3 +236,383 @@ int test_checksum_NMEA( bool verbose ) {
 	return errors;
 
 }  /* test_checksum_NMEA */
+
+#define SCAN_BUF_SIZE		32768
+#define SCAN_MAX_SENTENCES	512
+
+static unsigned char		scan_buf[SCAN_BUF_SIZE];
+static struct nmea_sentence	scan_expect[SCAN_MAX_SENTENCES];
+static struct nmea_sentence	scan_found[SCAN_MAX_SENTENCES];
+static struct nmea_view		scan_view[SCAN_MAX_SENTENCES];
+static struct nmea_stream	scan_stream;
+
+static const char *		scan_ais[] = {
+	"!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*",
+	"!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*",
+	"!AIVDO,1,1,,,B39i>1000nTu;gQAlBj:wwS5kP06,0*",
+	NULL
+};
+
+static size_t			scan_add( size_t pos, const char *payload, size_t len, int type, int *status );
+static size_t			scan_build( size_t *total );
+
+/*
+ * int test_checksum_NMEA_scan( bool verbose );
+ *
+ * The function test_checksum_NMEA_scan() scans a buffer with the sentences
+ * of the NMEA checksum test, some AIS sentences, sentences with wrong, lower
+ * case or missing checksums, truncated sentences and garbage between the
+ * sentences. The buffer is scanned in one call and in calls which return a
+ * few sentences at a time. Every sentence must be found with the expected
+ * offset, length and status. A sentence without line terminator at the end
+ * of the buffer must not be reported.
+ */
+
+int test_checksum_NMEA_scan( bool verbose ) {
+
+	int errors;
+	size_t b;
+	size_t len;
+	size_t pos;
+	size_t used;
+	size_t total;
+	size_t found;
+	size_t num_expect;
+	unsigned char *short_buf;
+
+	errors = 0;
+
+	printf( "Testing NMEA sentence scan: " );
+
+	num_expect = scan_build( &total );
+
+	found = checksum_NMEA_scan( scan_buf, total, scan_found, SCAN_MAX_SENTENCES, &used );
+
+	if ( found != num_expect  ||  used != total ) {
+
+		if ( verbose ) printf( "\n    FAIL: %u sentences and %u bytes used, not %u and %u", (unsigned) found, (unsigned) used, (unsigned) num_expect, (unsigned) total );
+		errors++;
+	}
+
+	for (b=0; b<found  &&  b<num_expect; b++) {
+
+		if ( scan_found[b].offset   != scan_expect[b].offset
+		  || scan_found[b].length   != scan_expect[b].length
+		  || scan_found[b].checksum != scan_expect[b].checksum
+		  || scan_found[b].status   != scan_expect[b].status ) {
+
+			if ( verbose ) printf( "\n    FAIL: sentence %u at %u length %u status %d differs from %u length %u status %d",
+						(unsigned) b, (unsigned) scan_found[b].offset, (unsigned) scan_found[b].length, scan_found[b].status,
+						(unsigned) scan_expect[b].offset, (unsigned) scan_expect[b].length, scan_expect[b].status );
+			errors++;
+		}
+	}
+
+	/*
+	 * Scan the same buffer with at most three sentences per call, and with
+	 * the last line terminator missing.
+	 */
+
+	pos   = 0;
+	found = 0;
+
+	while ( pos < total  &&  found < num_expect ) {
+
+		len = checksum_NMEA_scan( scan_buf + pos, total - pos, scan_found, 3, &used );
+		if ( len == 0 ) break;
+
+		for (b=0; b<len; b++) {
+
+			if ( scan_found[b].offset + pos != scan_expect[found+b].offset  ||  scan_found[b].status != scan_expect[found+b].status ) {
+
+				if ( verbose ) printf( "\n    FAIL: partial scan sentence %u differs", (unsigned) (found+b) );
+				errors++;
+			}
+		}
+
+		found += len;
+		pos   += used;
+	}
+
+	if ( found != num_expect ) {
+
+		if ( verbose ) printf( "\n    FAIL: partial scan found %u sentences, not %u", (unsigned) found, (unsigned) num_expect );
+		errors++;
+	}
+
+	found = checksum_NMEA_scan( scan_buf, scan_expect[num_expect-1].offset + scan_expect[num_expect-1].length, scan_found, SCAN_MAX_SENTENCES, &used );
+
+	if ( found != num_expect-1  ||  used != scan_expect[num_expect-1].offset ) {
+
+		if ( verbose ) printf( "\n    FAIL: unterminated last sentence is reported" );
+		errors++;
+	}
+
+	if ( checksum_NMEA_scan( NULL, 10, scan_found, 1, &used ) != 0  ||  used != 0 ) {
+
+		if ( verbose ) printf( "\n    FAIL: NULL buffer is accepted" );
+		errors++;
+	}
+
+	/*
+	 * A sentence with an empty checksum field which ends exactly at the
+	 * end of an allocated buffer. The checksum digits must not be read
+	 * beyond the terminator.
+	 */
+
+	short_buf = malloc( 4 );
+
+	if ( short_buf != NULL ) {
+
+		memcpy( short_buf, "$A*\r", 4 );
+
+		found = checksum_NMEA_scan( short_buf, 4, scan_found, 1, &used );
+
+		if ( found != 1  ||  used != 3  ||  scan_found[0].length != 3  ||  scan_found[0].status != NMEA_STATUS_MALFORMED ) {
+
+			if ( verbose ) printf( "\n    FAIL: truncated checksum field not reported as malformed" );
+			errors++;
+		}
+
+		free( short_buf );
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_checksum_NMEA_scan */
+
+/*
+ * int test_checksum_NMEA_stream( bool verbose );
+ *
+ * The function test_checksum_NMEA_stream() feeds the buffer of the scan test
+ * in chunks of pseudo random sizes between 1 and 100 bytes to the stream
+ * parser, with room for a few views per call. Every view must contain the
+ * same bytes, checksum and status as expected for the sentence. A sentence
+ * which is longer than the buffer of the stream must be reported as
+ * malformed.
+ */
+
+int test_checksum_NMEA_stream( bool verbose ) {
+
+	int errors;
+	size_t b;
+	size_t pos;
+	size_t len;
+	size_t chunk;
+	size_t used;
+	size_t total;
+	size_t found;
+	size_t num_views;
+	size_t num_expect;
+	uint32_t seed;
+
+	errors = 0;
+
+	printf( "Testing NMEA stream parser: " );
+
+	num_expect = scan_build( &total );
+	seed       = 0x1234567ul;
+	found      = 0;
+	pos        = 0;
+
+	checksum_NMEA_stream_init( &scan_stream );
+
+	while ( pos < total ) {
+
+		test_random( &seed );
+		chunk = 1 + ( seed >> 16 ) % 100;
+		if ( chunk > total - pos ) chunk = total - pos;
+
+		len = 0;
+
+		while ( len < chunk ) {
+
+			num_views = checksum_NMEA_stream( &scan_stream, scan_buf + pos + len, chunk - len, scan_view, 1 + found % 3, &used );
+
+			for (b=0; b<num_views; b++, found++) {
+
+				if ( found >= num_expect
+				  || scan_view[b].length   != scan_expect[found].length
+				  || scan_view[b].checksum != scan_expect[found].checksum
+				  || scan_view[b].status   != scan_expect[found].status
+				  || memcmp( scan_view[b].ptr, scan_buf + scan_expect[found].offset, scan_view[b].length ) != 0 ) {
+
+					if ( verbose ) printf( "\n    FAIL: sentence %u in chunk at %u differs", (unsigned) found, (unsigned) pos );
+					errors++;
+				}
+			}
+
+			len += used;
+		}
+
+		pos += chunk;
+	}
+
+	if ( found != num_expect ) {
+
+		if ( verbose ) printf( "\n    FAIL: %u sentences found, not %u", (unsigned) found, (unsigned) num_expect );
+		errors++;
+	}
+
+	/*
+	 * A sentence which does not fit in the stream buffer
+	 */
+
+	memset( scan_buf, 'A', 2*NMEA_STREAM_SIZE );
+	scan_buf[0]                    = '$';
+	scan_buf[2*NMEA_STREAM_SIZE]   = '\r';
+	scan_buf[2*NMEA_STREAM_SIZE+1] = '\n';
+
+	checksum_NMEA_stream_init( &scan_stream );
+	num_views  = checksum_NMEA_stream( &scan_stream, scan_buf,      10,                       scan_view, 1, &used );
+	num_views += checksum_NMEA_stream( &scan_stream, scan_buf + 10, 2*NMEA_STREAM_SIZE - 8,   scan_view, 1, &used );
+
+	if ( num_views != 1  ||  scan_view[0].status != NMEA_STATUS_MALFORMED  ||  scan_view[0].length != NMEA_STREAM_SIZE ) {
+
+		if ( verbose ) printf( "\n    FAIL: sentence longer than the stream buffer is accepted" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_checksum_NMEA_stream */
+
+/*
+ * static size_t scan_add( size_t pos, const char *payload, size_t len, int type, int *status );
+ *
+ * The function scan_add() appends a sentence to the scan buffer at a position
+ * and returns the position after the sentence. The type selects a correct
+ * checksum in upper or lower case, a wrong checksum or no checksum at all, and
+ * the line terminator. The expected status is returned in status.
+ */
+
+static size_t scan_add( size_t pos, const char *payload, size_t len, int type, int *status ) {
+
+	size_t a;
+	unsigned char checksum;
+	static const char upper[] = "0123456789ABCDEF";
+	static const char lower[] = "0123456789abcdef";
+
+	checksum = 0;
+	for (a=1; a<len; a++) checksum ^= (unsigned char) payload[a];
+
+	memcpy( scan_buf + pos, payload, len );
+	pos += len;
+
+	if ( type % 11 == 7 ) *status = NMEA_STATUS_NO_CHECKSUM;
+
+	else {
+
+		if ( type % 7 == 2 ) {
+
+			checksum ^= 0x21;
+			*status   = NMEA_STATUS_BAD_CHECKSUM;
+		}
+
+		else *status = NMEA_STATUS_VALID;
+
+		scan_buf[pos++] = '*';
+		scan_buf[pos++] = (unsigned char) ( ( type % 5 == 1 ) ? lower[checksum >> 4] : upper[checksum >> 4] );
+		scan_buf[pos++] = (unsigned char) ( ( type % 5 == 1 ) ? lower[checksum & 15] : upper[checksum & 15] );
+	}
+
+	if ( type % 3 == 1 ) scan_buf[pos++] = '\n';
+	else {
+
+		scan_buf[pos++] = '\r';
+		scan_buf[pos++] = '\n';
+	}
+
+	return pos;
+
+}  /* scan_add */
+
+/*
+ * static size_t scan_build( size_t *total );
+ *
+ * The function scan_build() fills the scan buffer with the test sentences and
+ * the table with the expected results. The number of bytes in the buffer is
+ * stored in total and the number of sentences is returned.
+ */
+
+static size_t scan_build( size_t *total ) {
+
+	int a;
+	int status;
+	size_t b;
+	size_t len;
+	size_t pos;
+	size_t num_expect;
+	const char *star;
+
+	pos        = 0;
+	num_expect = 0;
+
+	for (a=0; checks[a].input != NULL; a++) {
+
+		if ( checks[a].input[0] != '$' ) continue;
+
+		star = strchr( checks[a].input, '*' );
+		len  = ( star == NULL ) ? strlen( checks[a].input ) : (size_t) ( star - checks[a].input );
+
+		if ( a % 13 == 3 ) {
+
+			memcpy( scan_buf + pos, "garbage*12\r\n", 12 );
+			pos += 12;
+		}
+
+		if ( a % 17 == 5 ) {
+
+			scan_expect[num_expect].offset = pos;
+			scan_expect[num_expect].length = 10;
+			scan_expect[num_expect].status = NMEA_STATUS_MALFORMED;
+			memcpy( scan_buf + pos, "$GPXTE,A,A", 10 );
+			pos += 10;
+			num_expect++;
+		}
+
+		scan_expect[num_expect].offset = pos;
+		pos = scan_add( pos, checks[a].input, len, a, &status );
+		scan_expect[num_expect].length = pos - scan_expect[num_expect].offset;
+		scan_expect[num_expect].status = status;
+
+		while ( scan_buf[scan_expect[num_expect].offset+scan_expect[num_expect].length-1] == '\r'
+		     || scan_buf[scan_expect[num_expect].offset+scan_expect[num_expect].length-1] == '\n' ) scan_expect[num_expect].length--;
+
+		num_expect++;
+
+		if ( a % 9 == 0  &&  scan_ais[(a/9)%3] != NULL ) {
+
+			scan_expect[num_expect].offset = pos;
+			pos = scan_add( pos, scan_ais[(a/9)%3], strlen( scan_ais[(a/9)%3] ) - 1, 0, &status );
+			scan_expect[num_expect].length = pos - scan_expect[num_expect].offset - 2;
+			scan_expect[num_expect].status = status;
+			num_expect++;
+		}
+	}
+
+	*total = pos;
+
+	for (b=0; b<num_expect; b++) {
+
+		scan_expect[b].checksum = 0;
+		for (len=1; len<scan_expect[b].length  &&  scan_buf[scan_expect[b].offset+len] != '*'; len++) scan_expect[b].checksum ^= scan_buf[scan_expect[b].offset+len];
+	}
+
+	return num_expect;
+
+}  /* scan_build */
@@ -0,0 +1,132 @@
+/*
+ * Library: libcrc
+ * File:    test/testpar.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testpar.c contains routines which test if the multi
+ * threaded CRC routines of the libcrc library return the same results as the
+ * single threaded routines. Lengths around the threshold where the routines
+ * switch to the parallel calculation are tested with several thread counts.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		(3*1024*1024+17)
+#define TEST_BUF_OFFSET		3
+
+static const size_t		test_length[] = { 0, 1, 4095, 524287, 524288, 524289, 1048576 + 12345, TEST_BUF_SIZE - 1 };
+static const int		test_threads[] = { 0, 1, 2, 3, 7, 100 };
+
+/*
+ * int test_crc_parallel( bool verbose );
+ *
+ * The function test_crc_parallel() tests the multi threaded CRC routines
+ * against the single threaded routines.
+ */
+
+int test_crc_parallel( bool verbose ) {
+
+	int errors;
+	size_t l;
+	size_t t;
+	size_t len;
+	int threads;
+	uint32_t seed;
+	unsigned char *buf;
+
+	errors = 0;
+
+	printf( "Testing CRC parallel routines: " );
+
+	buf = malloc( TEST_BUF_SIZE + TEST_BUF_OFFSET );
+
+	if ( buf == NULL ) {
+
+		printf( "FAILED to allocate test buffer\n" );
+		return 1;
+	}
+
+	seed = 0x9E3779B9ul;
+	test_fill( buf, TEST_BUF_SIZE+TEST_BUF_OFFSET, &seed );
+
+	for (l=0; l<sizeof(test_length)/sizeof(test_length[0]); l++) {
+
+		len = test_length[l];
+
+		for (t=0; t<sizeof(test_threads)/sizeof(test_threads[0]); t++) {
+
+			threads = test_threads[t];
+
+			if ( crc_32_parallel( buf+1, len, threads ) != crc_32( buf+1, len ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: crc_32_parallel length %u threads %d", (unsigned) len, threads );
+				errors++;
+			}
+
+			if ( crc_32c_parallel( buf, len, threads ) != crc_32c( buf, len ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: crc_32c_parallel length %u threads %d", (unsigned) len, threads );
+				errors++;
+			}
+
+			if ( crc_64_ecma_parallel( buf, len, threads ) != crc_64_ecma( buf, len ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: crc_64_ecma_parallel length %u threads %d", (unsigned) len, threads );
+				errors++;
+			}
+
+			if ( crc_64_we_parallel( buf+TEST_BUF_OFFSET, len, threads ) != crc_64_we( buf+TEST_BUF_OFFSET, len ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: crc_64_we_parallel length %u threads %d", (unsigned) len, threads );
+				errors++;
+			}
+		}
+	}
+
+	if ( crc_32_parallel( NULL, 1048576, 4 ) != crc_32( NULL, 1048576 ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: crc_32_parallel with NULL pointer" );
+		errors++;
+	}
+
+	free( buf );
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_parallel */
@@ -0,0 +1,179 @@
+/*
+ * Library: libcrc
+ * File:    test/testpatch.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testpatch.c contains routines which test the functions
+ * of the libcrc library which update the CRC of a buffer after some of its
+ * bytes have been changed.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		(70*1024)
+
+typedef uint64_t (*patch_fn)( uint64_t crc, size_t total_len, size_t offset, const unsigned char *old_bytes, const unsigned char *new_bytes, size_t num_bytes );
+
+						/************************************************/
+struct patch_tp {				/*						*/
+	const char *	name;			/* The name of the algorithm in test_alg[]	*/
+	patch_fn	patch;			/* Function to patch the CRC			*/
+};						/*						*/
+						/************************************************/
+
+static uint64_t	test_patch_8( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )		{ return crc_8_patch(          (uint8_t)  c, t, o, p, q, n ); }
+static uint64_t	test_patch_16( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )		{ return crc_16_patch(         (uint16_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_modbus( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_modbus_patch(     (uint16_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_xmodem( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_xmodem_patch(     (uint16_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_ccitt_1d0f( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_ccitt_1d0f_patch( (uint16_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_ccitt_ffff( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_ccitt_ffff_patch( (uint16_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_kermit( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_kermit_patch(     (uint16_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_sick( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_sick_patch(       (uint16_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_dnp( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_dnp_patch(        (uint16_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_32( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )		{ return crc_32_patch(         (uint32_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_32c( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )		{ return crc_32c_patch(        (uint32_t) c, t, o, p, q, n ); }
+static uint64_t	test_patch_64_ecma( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_64_ecma_patch(               c, t, o, p, q, n ); }
+static uint64_t	test_patch_64_we( uint64_t c, size_t t, size_t o, const unsigned char *p, const unsigned char *q, size_t n )	{ return crc_64_we_patch(                 c, t, o, p, q, n ); }
+
+static struct patch_tp checks[] = {
+	{ "CRC 8",          test_patch_8          },
+	{ "CRC 16",         test_patch_16         },
+	{ "CRC Modbus",     test_patch_modbus     },
+	{ "CRC XModem",     test_patch_xmodem     },
+	{ "CRC CCITT 1D0F", test_patch_ccitt_1d0f },
+	{ "CRC CCITT FFFF", test_patch_ccitt_ffff },
+	{ "CRC Kermit",     test_patch_kermit     },
+	{ "CRC SICK",       test_patch_sick       },
+	{ "CRC DNP",        test_patch_dnp        },
+	{ "CRC 32",         test_patch_32         },
+	{ "CRC 32C",        test_patch_32c        },
+	{ "CRC 64 ECMA",    test_patch_64_ecma    },
+	{ "CRC 64 WE",      test_patch_64_we      },
+	{ NULL,             NULL                  }
+};
+
+						/************************************************/
+struct edit_tp {				/*						*/
+	size_t		total_len;		/* The length of the buffer			*/
+	size_t		offset;			/* The offset of the changed bytes		*/
+	size_t		num_bytes;		/* The number of changed bytes			*/
+};						/*						*/
+						/************************************************/
+
+static struct edit_tp edits[] = {
+	{ 1,             0,                 1    },
+	{ 16,            0,                 4    },
+	{ 16,            12,                4    },
+	{ 1068,          11,                4    },
+	{ 1068,          1067,              1    },
+	{ 5000,          2500,              300  },
+	{ 5000,          0,                 5000 },
+	{ TEST_BUF_SIZE, 7,                 2    },
+	{ TEST_BUF_SIZE, TEST_BUF_SIZE/2,   1000 },
+	{ TEST_BUF_SIZE, TEST_BUF_SIZE-3,   3    },
+	{ 0,             0,                 0    }
+};
+
+static unsigned char		test_old[TEST_BUF_SIZE];
+static unsigned char		test_new[TEST_BUF_SIZE];
+
+/*
+ * int test_crc_patch( bool verbose );
+ *
+ * The function test_crc_patch() changes bytes at different places in buffers
+ * of different lengths. The CRC returned by the crc_xxx_patch() functions is
+ * compared with the one pass CRC of the changed buffer. A change which does
+ * not fit in the buffer must leave the CRC unchanged.
+ */
+
+int test_crc_patch( bool verbose ) {
+
+	int errors;
+	int a;
+	int b;
+	size_t len;
+	size_t offset;
+	uint32_t seed;
+	uint64_t crc;
+	uint64_t ref;
+	const struct test_alg_tp *alg;
+
+	errors = 0;
+
+	printf( "Testing CRC patch routines: " );
+
+	seed = 0x41C64E6Dul;
+	test_fill( test_old, TEST_BUF_SIZE, &seed );
+
+	for (a=0; checks[a].name != NULL; a++) {
+
+		alg = test_find_alg( checks[a].name );
+
+		for (b=0; edits[b].total_len != 0; b++) {
+
+			len    = edits[b].total_len;
+			offset = edits[b].offset;
+
+			memcpy( test_new, test_old, TEST_BUF_SIZE );
+
+			test_fill( test_new + offset, edits[b].num_bytes, &seed );
+
+			ref = alg->crc( test_new, len );
+			crc = checks[a].patch( alg->crc( test_old, len ), len, offset, test_old + offset, test_new + offset, edits[b].num_bytes );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s length %u offset %u change %u returns 0x%" PRIX64 ", not 0x%" PRIX64, alg->name, (unsigned) len, (unsigned) offset, (unsigned) edits[b].num_bytes, crc, ref );
+				errors++;
+			}
+		}
+
+		ref = alg->crc( test_old, 100 );
+		crc = checks[a].patch( ref, 100, 98, test_old, test_new, 3 );
+
+		if ( crc != ref ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s change beyond the end of the buffer accepted", alg->name );
+			errors++;
+		}
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_patch */
@@ -0,0 +1,207 @@
+/*
+ * Library: libcrc
+ * File:    test/testpoly8.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testpoly8.c contains routines which test the CRC-8
+ * family of the libcrc library. The named functions are checked with the
+ * check values of their algorithms and update_crc_8_poly_block() is compared
+ * with a bit by bit calculation for all polynomials of the family and some
+ * polynomials which are calculated by the generic model engine.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		1100
+
+						/************************************************/
+struct named8_tp {				/*						*/
+	const char *	name;			/* The name of the CRC algorithm		*/
+	uint8_t		(*crc)( const unsigned char *ptr, size_t len );	/* One pass CRC	*/
+	uint8_t		check;			/* The CRC of the string "123456789"		*/
+};						/*						*/
+						/************************************************/
+
+						/************************************************/
+struct poly8_tp {				/*						*/
+	uint8_t		poly;			/* The polynomial in normal notation		*/
+	bool		reflected;		/* The CRC is calculated with reflected bits	*/
+};						/*						*/
+						/************************************************/
+
+static struct named8_tp named[] = {
+	{ "CRC-8/AUTOSAR",   crc_8_autosar,   0xDF },
+	{ "CRC-8/BLUETOOTH", crc_8_bluetooth, 0x26 },
+	{ "CRC-8/CDMA2000",  crc_8_cdma2000,  0xDA },
+	{ "CRC-8/MAXIM-DOW", crc_8_maxim,     0xA1 },
+	{ "CRC-8/ROHC",      crc_8_rohc,      0xD0 },
+	{ "CRC-8/SAE-J1850", crc_8_sae_j1850, 0x4B },
+	{ "CRC-8/SMBUS",     crc_8_smbus,     0xF4 },
+	{ NULL,              NULL,            0x00 }
+};
+
+static struct poly8_tp polys[] = {
+	{ 0x31, false },
+	{ 0x07, false },
+	{ 0x07, true  },
+	{ 0x1D, false },
+	{ 0x2F, false },
+	{ 0x31, true  },
+	{ 0x9B, false },
+	{ 0x9B, true  },
+	{ 0xA7, true  },
+	{ 0xD5, false },
+	{ 0x4D, false },
+	{ 0x4D, true  },
+	{ 0x00, false }
+};
+
+static uint8_t			bitwise8( uint8_t poly, bool reflected, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+/*
+ * int test_crc_poly8( bool verbose );
+ *
+ * The function test_crc_poly8() checks the named CRC-8 functions with the
+ * string "123456789" and calculates the CRC of parts of a pseudo random
+ * buffer with different lengths, offsets and start values for every
+ * polynomial in the test list. A calculation in two parts must return the
+ * same value as a calculation in one pass.
+ */
+
+int test_crc_poly8( bool verbose ) {
+
+	int errors;
+	int a;
+	size_t len;
+	size_t offset;
+	size_t split;
+	uint32_t seed;
+	uint8_t start;
+	uint8_t crc;
+	uint8_t ref;
+
+	errors = 0;
+
+	printf( "Testing CRC-8 polynomial family: " );
+
+	for (a=0; named[a].name != NULL; a++) {
+
+		crc = named[a].crc( (const unsigned char *) "123456789", 9 );
+
+		if ( crc != named[a].check ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s returns 0x%02" PRIX8 ", not 0x%02" PRIX8, named[a].name, crc, named[a].check );
+			errors++;
+		}
+	}
+
+	seed = 0x6C078965ul;
+	test_fill( test_buf, TEST_BUF_SIZE, &seed );
+
+	for (a=0; polys[a].poly != 0x00; a++) {
+
+		for (len=0; len+16<=TEST_BUF_SIZE; len=( len < 150 ) ? len+1 : len+97) {
+
+			offset = len % 13;
+			start  = (uint8_t) ( len * 29 + (size_t) a );
+			split  = len / 3;
+
+			ref = bitwise8( polys[a].poly, polys[a].reflected, start, test_buf + offset, len );
+			crc = update_crc_8_poly_block( polys[a].poly, polys[a].reflected, start, test_buf + offset, len );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: poly 0x%02" PRIX8 "%s length %u returns 0x%02" PRIX8 ", not 0x%02" PRIX8, polys[a].poly, ( polys[a].reflected ) ? " reflected" : "", (unsigned) len, crc, ref );
+				errors++;
+			}
+
+			crc = update_crc_8_poly_block( polys[a].poly, polys[a].reflected, start, test_buf + offset, split );
+			crc = update_crc_8_poly_block( polys[a].poly, polys[a].reflected, crc,   test_buf + offset + split, len - split );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: poly 0x%02" PRIX8 "%s length %u split at %u returns 0x%02" PRIX8 ", not 0x%02" PRIX8, polys[a].poly, ( polys[a].reflected ) ? " reflected" : "", (unsigned) len, (unsigned) split, crc, ref );
+				errors++;
+			}
+		}
+	}
+
+	if ( update_crc_8_block( 0x5A, test_buf, TEST_BUF_SIZE ) != bitwise8( 0x31, false, 0x5A, test_buf, TEST_BUF_SIZE ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: update_crc_8_block() differs from the bitwise calculation" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_poly8 */
+
+/*
+ * static uint8_t bitwise8( uint8_t poly, bool reflected, uint8_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function bitwise8() is the reference implementation of an 8 bit CRC
+ * which processes the input one bit at a time.
+ */
+
+static uint8_t bitwise8( uint8_t poly, bool reflected, uint8_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	int a;
+	uint8_t rpoly;
+
+	rpoly = 0;
+	for (a=0; a<8; a++) if ( poly & ( 1u << a ) ) rpoly |= (uint8_t) ( 0x80u >> a );
+
+	while ( num_bytes > 0 ) {
+
+		crc ^= *ptr++;
+
+		for (a=0; a<8; a++) {
+
+			if ( reflected ) crc = ( crc & 0x01 ) ? (uint8_t) ( ( crc >> 1 ) ^ rpoly ) : (uint8_t) ( crc >> 1 );
+			else             crc = ( crc & 0x80 ) ? (uint8_t) ( ( crc << 1 ) ^ poly  ) : (uint8_t) ( crc << 1 );
+		}
+
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* bitwise8 */
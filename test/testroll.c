@@ -0,0 +1,215 @@
+/*
+ * Library: libcrc
+ * File:    test/testroll.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testroll.c contains routines which test the rolling
+ * CRC functions of the libcrc library. The CRC of the window is compared with
+ * the one pass CRC of the same bytes after every chunk of data, and a sync
+ * word is searched for in data which is offered in chunks of different sizes.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		4096
+
+static size_t windows[] = { 1, 2, 5, 11, 16, 48, 255, CRC_ROLL_MAX_WINDOW, 0 };
+
+static const unsigned char	sync_word[] = "UklGRn7IJA1";
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+static unsigned char		test_pad[TEST_BUF_SIZE+CRC_ROLL_MAX_WINDOW];
+
+/*
+ * int test_crc_roll( bool verbose );
+ *
+ * The function test_crc_roll() tests the rolling CRC functions. Data is added
+ * in chunks of increasing size and the CRC of the window is compared with the
+ * one pass CRC of the last bytes, which are preceded by zero bytes while the
+ * window is not yet filled. A sync word is then searched for with a mask with
+ * all bits set and with a partial mask. Every reported match must have the
+ * requested CRC and the sync word itself must be found. The CRC of the frame
+ * which starts with the sync word is continued with the context functions.
+ */
+
+int test_crc_roll( bool verbose ) {
+
+	int errors;
+	int a;
+	int b;
+	bool found;
+	size_t pos;
+	size_t len;
+	size_t num;
+	size_t window;
+	size_t sync_pos;
+	size_t sync_len;
+	uint32_t seed;
+	uint64_t crc;
+	uint64_t ref;
+	uint64_t mask;
+	uint64_t value;
+	struct crc_ctx ctx;
+	struct crc_roll roll;
+
+	errors = 0;
+
+	printf( "Testing CRC rolling window routines: " );
+
+	seed = 0x7F4A7C15ul;
+	test_fill( test_buf, TEST_BUF_SIZE, &seed );
+
+	memset( test_pad, 0, CRC_ROLL_MAX_WINDOW );
+	memcpy( test_pad + CRC_ROLL_MAX_WINDOW, test_buf, TEST_BUF_SIZE );
+
+	sync_len = sizeof(sync_word) - 1;
+	sync_pos = 3001;
+
+	for (a=0; test_alg[a].name != NULL; a++) {
+
+		if ( test_alg[a].type == CRC_TYPE_SICK ) continue;
+
+		for (b=0; windows[b] != 0; b++) {
+
+			window = windows[b];
+
+			if ( crc_roll_init( & roll, test_alg[a].type, window ) == NULL ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s window %u cannot be initialized", test_alg[a].name, (unsigned) window );
+				errors++;
+				continue;
+			}
+
+			pos = 0;
+			len = 1;
+
+			while ( pos < TEST_BUF_SIZE ) {
+
+				if ( len > TEST_BUF_SIZE - pos ) len = TEST_BUF_SIZE - pos;
+
+				crc_roll_update( & roll, test_buf + pos, len );
+
+				pos += len;
+				len  = len * 3 / 2 + 1;
+				crc  = crc_roll_final( & roll );
+				ref  = test_alg[a].crc( test_pad + CRC_ROLL_MAX_WINDOW + pos - window, window );
+
+				if ( crc != ref ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s window %u at %u returns 0x%" PRIX64 ", not 0x%" PRIX64, test_alg[a].name, (unsigned) window, (unsigned) pos, crc, ref );
+					errors++;
+					break;
+				}
+			}
+
+			if ( window != sync_len ) continue;
+
+			/*
+			 * The sync word is copied into the buffer and searched
+			 * for with all bits of the CRC, and with only the lowest
+			 * bits as used for content defined chunking. A match of
+			 * the CRC which is not the sync word is possible for the
+			 * narrow CRCs and is skipped after checking its value.
+			 */
+
+			memcpy( test_buf + sync_pos, sync_word, sync_len );
+
+			for (mask=0xFFFFFFFFFFFFFFFFull; mask!=0; mask=( mask == 0x3FF ) ? 0 : 0x3FF) {
+
+				value = test_alg[a].crc( sync_word, sync_len ) & mask;
+				found = false;
+
+				crc_roll_init( & roll, test_alg[a].type, window );
+
+				for (pos=0; pos<TEST_BUF_SIZE; pos+=num) {
+
+					len = ( TEST_BUF_SIZE - pos < 97 ) ? TEST_BUF_SIZE - pos : 97;
+					num = crc_roll_find( & roll, test_buf + pos, len, mask, value );
+
+					if ( num == len  &&  ( crc_roll_final( & roll ) & mask ) != value ) continue;
+
+					if ( ( crc_roll_final( & roll ) & mask ) != value  ||  pos + num < window ) {
+
+						if ( verbose ) printf( "\n    FAIL: %s mask 0x%" PRIX64 " false match at %u", test_alg[a].name, mask, (unsigned) ( pos + num ) );
+						errors++;
+						break;
+					}
+
+					if ( memcmp( test_buf + pos + num - window, sync_word, sync_len ) == 0 ) {
+
+						if ( pos + num != sync_pos + sync_len ) {
+
+							if ( verbose ) printf( "\n    FAIL: %s mask 0x%" PRIX64 " sync word at %u", test_alg[a].name, mask, (unsigned) ( pos + num ) );
+							errors++;
+						}
+
+						crc_roll_ctx( & roll, & ctx );
+						crc_ctx_update( & ctx, test_buf + pos + num, 100 );
+
+						if ( crc_ctx_final( & ctx ) != test_alg[a].crc( test_buf + pos + num - window, window + 100 ) ) {
+
+							if ( verbose ) printf( "\n    FAIL: %s frame CRC after the sync word differs", test_alg[a].name );
+							errors++;
+						}
+
+						found = true;
+						break;
+					}
+				}
+
+				if ( ! found ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s mask 0x%" PRIX64 " sync word not found", test_alg[a].name, mask );
+					errors++;
+				}
+			}
+
+			memcpy( test_buf + sync_pos, test_pad + CRC_ROLL_MAX_WINDOW + sync_pos, sync_len );
+		}
+	}
+
+	if ( crc_roll_init( & roll, CRC_TYPE_SICK, 16 ) != NULL  ||  crc_roll_init( & roll, CRC_TYPE_32, 0 ) != NULL  ||  crc_roll_init( & roll, CRC_TYPE_32, CRC_ROLL_MAX_WINDOW+1 ) != NULL ) {
+
+		if ( verbose ) printf( "\n    FAIL: unsupported type or window size accepted" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_roll */
@@ -0,0 +1,122 @@
+/*
+ * Library: libcrc
+ * File:    test/testutil.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testutil.c contains the table of CRC algorithms and
+ * the helper routines which are shared by the test routines of the testall
+ * program.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+static uint64_t	test_crc_8( const unsigned char *ptr, size_t len )		{ return crc_8( ptr, len ); }
+static uint64_t	test_crc_16( const unsigned char *ptr, size_t len )		{ return crc_16( ptr, len ); }
+static uint64_t	test_crc_modbus( const unsigned char *ptr, size_t len )		{ return crc_modbus( ptr, len ); }
+static uint64_t	test_crc_xmodem( const unsigned char *ptr, size_t len )		{ return crc_xmodem( ptr, len ); }
+static uint64_t	test_crc_ccitt_1d0f( const unsigned char *ptr, size_t len )	{ return crc_ccitt_1d0f( ptr, len ); }
+static uint64_t	test_crc_ccitt_ffff( const unsigned char *ptr, size_t len )	{ return crc_ccitt_ffff( ptr, len ); }
+static uint64_t	test_crc_kermit( const unsigned char *ptr, size_t len )		{ return crc_kermit( ptr, len ); }
+static uint64_t	test_crc_sick( const unsigned char *ptr, size_t len )		{ return crc_sick( ptr, len ); }
+static uint64_t	test_crc_dnp( const unsigned char *ptr, size_t len )		{ return crc_dnp( ptr, len ); }
+static uint64_t	test_crc_32( const unsigned char *ptr, size_t len )		{ return crc_32( ptr, len ); }
+static uint64_t	test_crc_32c( const unsigned char *ptr, size_t len )		{ return crc_32c( ptr, len ); }
+static uint64_t	test_crc_64_ecma( const unsigned char *ptr, size_t len )	{ return crc_64_ecma( ptr, len ); }
+static uint64_t	test_crc_64_we( const unsigned char *ptr, size_t len )		{ return crc_64_we( ptr, len ); }
+
+const struct test_alg_tp test_alg[] = {
+	{ "CRC 8",          CRC_TYPE_8,          1, test_crc_8          },
+	{ "CRC 16",         CRC_TYPE_16,         2, test_crc_16         },
+	{ "CRC Modbus",     CRC_TYPE_MODBUS,     2, test_crc_modbus     },
+	{ "CRC XModem",     CRC_TYPE_XMODEM,     2, test_crc_xmodem     },
+	{ "CRC CCITT 1D0F", CRC_TYPE_CCITT_1D0F, 2, test_crc_ccitt_1d0f },
+	{ "CRC CCITT FFFF", CRC_TYPE_CCITT_FFFF, 2, test_crc_ccitt_ffff },
+	{ "CRC Kermit",     CRC_TYPE_KERMIT,     2, test_crc_kermit     },
+	{ "CRC SICK",       CRC_TYPE_SICK,       2, test_crc_sick       },
+	{ "CRC DNP",        CRC_TYPE_DNP,        2, test_crc_dnp        },
+	{ "CRC 32",         CRC_TYPE_32,         4, test_crc_32         },
+	{ "CRC 32C",        CRC_TYPE_32C,        4, test_crc_32c        },
+	{ "CRC 64 ECMA",    CRC_TYPE_64_ECMA,    8, test_crc_64_ecma    },
+	{ "CRC 64 WE",      CRC_TYPE_64_WE,      8, test_crc_64_we      },
+	{ NULL,             0,                   0, NULL                }
+};
+
+/*
+ * const struct test_alg_tp *test_find_alg( const char *name );
+ *
+ * The function test_find_alg() returns the entry in the table test_alg[] of
+ * the CRC algorithm with the given name, or NULL if the name is unknown.
+ */
+
+const struct test_alg_tp *test_find_alg( const char *name ) {
+
+	const struct test_alg_tp *alg;
+
+	for (alg=test_alg; alg->name != NULL; alg++) if ( strcmp( alg->name, name ) == 0 ) return alg;
+
+	return NULL;
+
+}  /* test_find_alg */
+
+/*
+ * uint32_t test_random( uint32_t *seed );
+ *
+ * The function test_random() advances the linear congruential generator with
+ * the state seed and returns the new state. The higher bits of the state are
+ * the most random, so callers use seed >> 16 for small values.
+ */
+
+uint32_t test_random( uint32_t *seed ) {
+
+	*seed = *seed * 1103515245ul + 12345ul;
+
+	return *seed;
+
+}  /* test_random */
+
+/*
+ * void test_fill( unsigned char *buf, size_t len, uint32_t *seed );
+ *
+ * The function test_fill() fills a buffer with len pseudo random bytes from
+ * the generator with the state seed. The same seed gives the same contents on
+ * every platform.
+ */
+
+void test_fill( unsigned char *buf, size_t len, uint32_t *seed ) {
+
+	size_t a;
+
+	for (a=0; a<len; a++) buf[a] = (unsigned char) ( test_random( seed ) >> 16 );
+
+}  /* test_fill */
@@ -0,0 +1,224 @@
+/*
+ * Library: libcrc
+ * File:    test/testzero.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * License
+ * -------
+ * Copyright (c) 2008-2016 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * Description
+ * -----------
+ * The source file test/testzero.c contains routines which test the functions
+ * of the libcrc library which advance a CRC over a run of zero bytes, and the
+ * calculation of the CRC of a file with holes.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		(600*1024)
+#define TEST_FILE_NAME		"testzero.tmp"
+
+						/************************************************/
+struct zero_tp {				/*						*/
+	const char *	name;			/* The name of the algorithm in test_alg[]	*/
+	uint64_t	(*zeros)( uint64_t crc, uint64_t len, unsigned char last );	/* Zero run	*/
+};						/*						*/
+						/************************************************/
+
+static uint64_t	test_zeros_8( uint64_t crc, uint64_t len, unsigned char last )		{ (void) last; return crc_8_zeros(          (uint8_t)  crc, len ); }
+static uint64_t	test_zeros_16( uint64_t crc, uint64_t len, unsigned char last )		{ (void) last; return crc_16_zeros(         (uint16_t) crc, len ); }
+static uint64_t	test_zeros_modbus( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_modbus_zeros(     (uint16_t) crc, len ); }
+static uint64_t	test_zeros_xmodem( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_xmodem_zeros(     (uint16_t) crc, len ); }
+static uint64_t	test_zeros_ccitt_1d0f( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_ccitt_1d0f_zeros( (uint16_t) crc, len ); }
+static uint64_t	test_zeros_ccitt_ffff( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_ccitt_ffff_zeros( (uint16_t) crc, len ); }
+static uint64_t	test_zeros_kermit( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_kermit_zeros(     (uint16_t) crc, len ); }
+static uint64_t	test_zeros_sick( uint64_t crc, uint64_t len, unsigned char last )	{              return crc_sick_zeros(       (uint16_t) crc, len, last ); }
+static uint64_t	test_zeros_dnp( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_dnp_zeros(        (uint16_t) crc, len ); }
+static uint64_t	test_zeros_32( uint64_t crc, uint64_t len, unsigned char last )		{ (void) last; return crc_32_zeros(         (uint32_t) crc, len ); }
+static uint64_t	test_zeros_32c( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_32c_zeros(        (uint32_t) crc, len ); }
+static uint64_t	test_zeros_64_ecma( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_64_ecma_zeros(               crc, len ); }
+static uint64_t	test_zeros_64_we( uint64_t crc, uint64_t len, unsigned char last )	{ (void) last; return crc_64_we_zeros(                 crc, len ); }
+
+static struct zero_tp checks[] = {
+	{ "CRC 8",          test_zeros_8          },
+	{ "CRC 16",         test_zeros_16         },
+	{ "CRC Modbus",     test_zeros_modbus     },
+	{ "CRC XModem",     test_zeros_xmodem     },
+	{ "CRC CCITT 1D0F", test_zeros_ccitt_1d0f },
+	{ "CRC CCITT FFFF", test_zeros_ccitt_ffff },
+	{ "CRC Kermit",     test_zeros_kermit     },
+	{ "CRC SICK",       test_zeros_sick       },
+	{ "CRC DNP",        test_zeros_dnp        },
+	{ "CRC 32",         test_zeros_32         },
+	{ "CRC 32C",        test_zeros_32c        },
+	{ "CRC 64 ECMA",    test_zeros_64_ecma    },
+	{ "CRC 64 WE",      test_zeros_64_we      },
+	{ NULL,             NULL                  }
+};
+
+static size_t data_len[] = { 0, 1, 13, 100, 4096, 0 };
+static size_t zero_len[] = { 0, 1, 2, 15, 64, 1000, 70000, 0 };
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+/*
+ * int test_crc_zeros( bool verbose );
+ *
+ * The function test_crc_zeros() appends runs of zero bytes of different
+ * lengths to blocks of random data. The CRC returned by the crc_xxx_zeros()
+ * functions and by the context after crc_ctx_zeros() is compared with the one
+ * pass CRC of the data with the zeros. Very long runs are checked by splitting
+ * them in two parts. A file with holes is written and its CRC is calculated
+ * with crc_ctx_file().
+ */
+
+int test_crc_zeros( bool verbose ) {
+
+	int errors;
+	int a;
+	int b;
+	int c;
+	size_t len;
+	uint32_t seed;
+	uint64_t crc;
+	uint64_t ref;
+	unsigned char last;
+	struct crc_ctx ctx;
+	const struct test_alg_tp *alg;
+	FILE *fp;
+
+	errors = 0;
+
+	printf( "Testing CRC zero run routines: " );
+
+	seed = 0x6C078965ul;
+
+	for (a=0; checks[a].name != NULL; a++) {
+
+		alg = test_find_alg( checks[a].name );
+
+		for (b=0; b==0 || data_len[b] != 0; b++) {
+
+			test_fill( test_buf, data_len[b], &seed );
+
+			last = ( data_len[b] > 0 ) ? test_buf[data_len[b]-1] : 0;
+
+			for (c=0; c==0 || zero_len[c] != 0; c++) {
+
+				len = data_len[b] + zero_len[c];
+				memset( test_buf + data_len[b], 0, zero_len[c] );
+
+				ref = alg->crc( test_buf, len );
+				crc = checks[a].zeros( alg->crc( test_buf, data_len[b] ), zero_len[c], last );
+
+				crc_ctx_init(   & ctx, alg->type );
+				crc_ctx_update( & ctx, test_buf, data_len[b] );
+				crc_ctx_zeros(  & ctx, zero_len[c] );
+
+				if ( crc != ref  ||  crc_ctx_final( & ctx ) != ref ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s %u data and %u zero bytes returns 0x%" PRIX64 ", not 0x%" PRIX64, alg->name, (unsigned) data_len[b], (unsigned) zero_len[c], crc, ref );
+					errors++;
+				}
+			}
+		}
+
+		ref = checks[a].zeros( checks[a].zeros( alg->crc( test_buf, 3 ), 0x123456789ull, test_buf[2] ), 0xFEDCBA987ull, 0 );
+		crc = checks[a].zeros( alg->crc( test_buf, 3 ), 0x123456789ull + 0xFEDCBA987ull, test_buf[2] );
+
+		if ( crc != ref ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s long zero run returns 0x%" PRIX64 ", not 0x%" PRIX64, alg->name, crc, ref );
+			errors++;
+		}
+	}
+
+	/*
+	 * The test file is written with gaps which become holes on file
+	 * systems which support sparse files. The gaps read as zeros.
+	 */
+
+	test_fill( test_buf, TEST_BUF_SIZE, &seed );
+	memset( test_buf + 5000,   0, 300000 - 5000 );
+	memset( test_buf + 310000, 0, TEST_BUF_SIZE - 100 - 310000 );
+
+#if defined(_WIN32)
+	fopen_s( & fp, TEST_FILE_NAME, "wb" );
+#else
+	fp = fopen( TEST_FILE_NAME, "wb" );
+#endif
+
+	if ( fp == NULL ) {
+
+		if ( verbose ) printf( "\n    FAIL: cannot create test file %s", TEST_FILE_NAME );
+		errors++;
+	}
+
+	else {
+
+		fwrite( test_buf,                      1, 5000,  fp );
+		fseek(  fp, 300000, SEEK_SET );
+		fwrite( test_buf + 300000,             1, 10000, fp );
+		fseek(  fp, TEST_BUF_SIZE - 100, SEEK_SET );
+		fwrite( test_buf + TEST_BUF_SIZE - 100, 1, 100,   fp );
+		fclose( fp );
+
+		for (a=0; test_alg[a].name != NULL; a++) {
+
+			crc_ctx_init( & ctx, test_alg[a].type );
+
+			ref = test_alg[a].crc( test_buf, TEST_BUF_SIZE );
+			crc = ( crc_ctx_file( & ctx, TEST_FILE_NAME ) == 0 ) ? crc_ctx_final( & ctx ) : ~ref;
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s file with holes returns 0x%" PRIX64 ", not 0x%" PRIX64, test_alg[a].name, crc, ref );
+				errors++;
+			}
+		}
+
+		remove( TEST_FILE_NAME );
+	}
+
+	crc_ctx_init( & ctx, CRC_TYPE_32 );
+
+	if ( crc_ctx_file( & ctx, TEST_FILE_NAME ) == 0 ) {
+
+		if ( verbose ) printf( "\n    FAIL: missing file accepted" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_zeros */